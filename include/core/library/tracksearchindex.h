@@ -0,0 +1,70 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "fycore_export.h"
+
+#include <core/track.h>
+
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace Fooyin {
+/*!
+ * Holds the case-folded, diacritic-stripped search text of each track in the library.
+ * Used to answer simple searches without re-joining and folding metadata for every track.
+ * Can be read from multiple threads while being updated.
+ */
+class FYCORE_EXPORT TrackSearchIndex
+{
+public:
+    /** Returns @p text case-folded and with diacritics removed. */
+    [[nodiscard]] static QString foldText(const QString& text);
+    /** Returns the folded search text of @p track, made up of its main metadata fields and filepath. */
+    [[nodiscard]] static QString searchText(const Track& track);
+    /*!
+     * Splits @p search into folded terms.
+     * If @p singleTerm is @c true, the whole search is returned as a single term.
+     */
+    [[nodiscard]] static QStringList searchTerms(const QString& search, bool singleTerm = false);
+    /** Returns @c true if every term in @p terms is found in @p text. */
+    [[nodiscard]] static bool textHasMatch(const QString& text, const QStringList& terms);
+
+    /** Replaces the contents of the index with @p tracks. */
+    void reset(const TrackList& tracks);
+    /** Adds @p tracks to the index, replacing any existing entries. */
+    void insertTracks(const TrackList& tracks);
+    void removeTracks(const TrackList& tracks);
+    void clear();
+
+    [[nodiscard]] size_t size() const;
+
+    /*!
+     * Returns @c true if every term in @p terms is found in the search text of @p track.
+     * Tracks which aren't in the index are folded on demand.
+     * @note @p terms should be obtained using searchTerms.
+     */
+    [[nodiscard]] bool hasMatch(const Track& track, const QStringList& terms) const;
+
+private:
+    mutable std::shared_mutex m_mutex;
+    std::unordered_map<int, QString> m_searchText;
+};
+} // namespace Fooyin
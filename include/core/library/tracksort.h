@@ -52,6 +52,7 @@ public:
 
     /*!
      * Calculates the sort fields of @p tracks using the parsed @p sort script
+     * @note large lists are split into chunks which are evaluated in parallel.
      * @param sortScript the parsed sort script
      * @param tracks the tracks to calculate
      * @returns a new TrackList with the calculated sortFields
@@ -60,12 +61,27 @@ public:
 
     /*!
      * Sorts @p tracks using their current sort fields
+     * @note large lists are sorted in parallel chunks which are then merged.
      * @param tracks the tracks to sort
      * @param order the order in which to sort the tracks
      * @returns a new sorted TrackList
      */
     static TrackList sortTracks(const TrackList& tracks, Qt::SortOrder order = Qt::AscendingOrder);
 
+    /*!
+     * Merges two lists which are already sorted using their current sort fields
+     * @note on equal sort fields, tracks from @p first are placed before those from @p second.
+     * @param first the first sorted list
+     * @param second the second sorted list
+     * @param order the order in which both lists are sorted
+     * @returns a new sorted TrackList containing the tracks of both lists
+     */
+    static TrackList mergeTracks(const TrackList& first, const TrackList& second,
+                                 Qt::SortOrder order = Qt::AscendingOrder);
+
+    /** Returns true if @p lhs sorts before @p rhs by their current sort fields in the given @p order. */
+    static bool lessThan(const StringCollator& collator, const Track& lhs, const Track& rhs, Qt::SortOrder order);
+
     /*!
      * Calculates the sort fields and then sorts @p tracks
      * @param sort the sort script as a string
@@ -169,22 +185,11 @@ private:
         StringCollator collator;
 
         std::ranges::stable_sort(tracks, [order, &collator, extractor](const auto& lhs, const auto& rhs) {
-            const Track& leftTrack  = extractor(lhs);
-            const Track& rightTrack = extractor(rhs);
-
-            const auto cmp = collator.compare(leftTrack.sort(), rightTrack.sort());
-
-            if(cmp == 0) {
-                return false;
-            }
-
-            if(order == Qt::AscendingOrder) {
-                return cmp < 0;
-            }
-            return cmp > 0;
+            return lessThan(collator, extractor(lhs), extractor(rhs), order);
         });
     }
 
+    LibraryManager* m_libraryManager;
     ScriptParser m_parser;
     std::mutex m_parserGuard;
 };
@@ -69,6 +69,31 @@ struct FYCORE_EXPORT PlaylistTrack
     };
 };
 
+/*!
+ * A change made to the tracks of a playlist since it was last saved.
+ * Allows only the changed part of a playlist to be persisted.
+ */
+struct PlaylistTrackEdit
+{
+    enum class Type : uint8_t
+    {
+        // @c tracks were inserted at @c index
+        Insert,
+        // @c count tracks were removed from @c index
+        Remove,
+        // @c count tracks at @c index were moved to start at @c destination
+        Move,
+        // All tracks need to be saved
+        Reset,
+    };
+
+    Type type{Type::Reset};
+    int index{0};
+    int count{0};
+    int destination{0};
+    TrackList tracks;
+};
+
 /*!
  * Represents a list of tracks for playback.
  * Playlists are saved to the database and restored
@@ -125,6 +150,18 @@ public:
 
     /** Regenerates this autoplaylist using the tracks @p tracks. */
     bool regenerateTracks(const TrackList& tracks);
+    /** Returns @c true if this autoplaylist's query allows it to be updated using patchTracks. */
+    [[nodiscard]] bool canPatchTracks() const;
+    /*!
+     * Updates this autoplaylist in place, testing only @p changedTracks against the query.
+     * @param changedTracks tracks which have been added or updated
+     * @param removedTracks tracks which have been removed
+     * @returns @c true if the tracks of this playlist changed.
+     * @note should only be used if canPatchTracks returns @c true, else use regenerateTracks.
+     * Tracks are expected to share the sort fields of the library, so this playlist must be
+     * regenerated if the library is resorted.
+     */
+    bool patchTracks(const TrackList& changedTracks, const TrackList& removedTracks);
 
     int nextIndex(int delta, PlayModes mode);
     /*!
@@ -154,6 +191,7 @@ public:
 private:
     friend class PlaylistHandler;
     friend class PlaylistHandlerPrivate;
+    friend class PlaylistDatabase;
 
     static std::unique_ptr<Playlist> create(const QString& name, SettingsManager* settings);
     static std::unique_ptr<Playlist> create(int dbId, const QString& name, int index, SettingsManager* settings);
@@ -167,6 +205,9 @@ private:
     void setModified(bool modified);
     void setTracksModified(bool modified);
 
+    /** Returns the changes made to the tracks of this playlist since the flags were last reset. */
+    [[nodiscard]] const std::vector<PlaylistTrackEdit>& trackEdits() const;
+
     void replaceTracks(const TrackList& tracks);
     void appendTracks(const TrackList& tracks);
     void updateTrackAtIndex(int index, const Track& track);
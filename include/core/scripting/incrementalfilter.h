@@ -0,0 +1,164 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <core/library/tracksearchindex.h>
+#include <core/scripting/scriptparser.h>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+namespace Fooyin {
+/*!
+ * Filters tracks for type-ahead searches, reusing the results of previous searches where possible.
+ *
+ * If a simple (non-query) search is a refinement of a previous one (a longer term, or more terms), only the tracks
+ * which matched the previous search are filtered. A small stack of previous results is kept, so removing characters
+ * from a search returns cached results.
+ *
+ * Cached results are only valid for the tracks they were filtered from. Callers should call invalidate() whenever
+ * their source tracks change, and pass the generation() at the time the source tracks were captured to filter().
+ * Can be used from multiple threads.
+ */
+template <typename TrackListType>
+class IncrementalFilter
+{
+public:
+    explicit IncrementalFilter(size_t maxDepth = 10)
+        : m_maxDepth{std::max<size_t>(maxDepth, 1)}
+    { }
+
+    void setSearchIndex(std::shared_ptr<const TrackSearchIndex> index)
+    {
+        const std::scoped_lock lock{m_mutex};
+        m_searchIndex = std::move(index);
+        m_results.clear();
+    }
+
+    /** Returns the current generation of source tracks. */
+    [[nodiscard]] uint64_t generation() const
+    {
+        return m_generation.load(std::memory_order_acquire);
+    }
+
+    /** Marks all cached results as stale. */
+    void invalidate()
+    {
+        m_generation.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    /*!
+     * Filters @p tracks using @p search, narrowing cached results if possible.
+     * @param generation the generation() at the time @p tracks were captured.
+     */
+    TrackListType filter(const QString& search, const TrackListType& tracks, uint64_t generation)
+    {
+        const std::scoped_lock lock{m_mutex};
+
+        ScriptParser parser;
+        parser.setSearchIndex(m_searchIndex);
+
+        const ParsedScript script = parser.parseQuery(search);
+        if(!script.isValid()) {
+            return {};
+        }
+
+        const auto terms = searchTerms(script);
+        if(!terms) {
+            // Queries can't be narrowed in general (e.g. playcount<1 -> playcount<10)
+            return parser.filter(script, tracks);
+        }
+
+        if(generation != m_resultsGeneration) {
+            m_results.clear();
+            m_resultsGeneration = generation;
+        }
+
+        // Drop results which aren't a subset of this search
+        while(!m_results.empty() && !refines(terms.value(), m_results.back().terms)) {
+            m_results.pop_back();
+        }
+
+        if(!m_results.empty() && m_results.back().terms == terms.value()) {
+            return m_results.back().tracks;
+        }
+
+        TrackListType filteredTracks = parser.filter(script, m_results.empty() ? tracks : m_results.back().tracks);
+
+        if(m_results.size() >= m_maxDepth) {
+            m_results.pop_front();
+        }
+        m_results.emplace_back(terms.value(), filteredTracks);
+
+        return filteredTracks;
+    }
+
+private:
+    struct Result
+    {
+        QStringList terms;
+        TrackListType tracks;
+    };
+
+    [[nodiscard]] std::optional<QStringList> searchTerms(const ParsedScript& script) const
+    {
+        if(script.expressions.size() != 1) {
+            return {};
+        }
+
+        const auto& expr = script.expressions.front();
+        if(expr.type != Expr::Literal && expr.type != Expr::QuotedLiteral) {
+            return {};
+        }
+
+        const QString search  = std::get<QString>(expr.value);
+        const bool singleTerm = expr.type == Expr::QuotedLiteral;
+
+        if(m_searchIndex) {
+            return TrackSearchIndex::searchTerms(search, singleTerm);
+        }
+
+        return singleTerm ? QStringList{search} : search.split(u' ', Qt::SkipEmptyParts);
+    }
+
+    /** Returns @c true if every track matching @p terms also matches @p previousTerms. */
+    [[nodiscard]] bool refines(const QStringList& terms, const QStringList& previousTerms) const
+    {
+        // Indexed terms are already folded
+        const auto cs = m_searchIndex ? Qt::CaseSensitive : Qt::CaseInsensitive;
+
+        return std::ranges::all_of(previousTerms, [&terms, cs](const QString& previousTerm) {
+            return std::ranges::any_of(
+                terms, [&previousTerm, cs](const QString& term) { return term.contains(previousTerm, cs); });
+        });
+    }
+
+    size_t m_maxDepth;
+    std::shared_ptr<const TrackSearchIndex> m_searchIndex;
+
+    std::mutex m_mutex;
+    std::atomic<uint64_t> m_generation{0};
+    uint64_t m_resultsGeneration{0};
+    std::deque<Result> m_results;
+};
+} // namespace Fooyin
@@ -30,6 +30,7 @@
 
 namespace Fooyin {
 class ScriptParserPrivate;
+class TrackSearchIndex;
 
 struct ScriptError
 {
@@ -51,6 +52,14 @@ struct ParsedScript
     }
 };
 
+struct ScriptCacheStats
+{
+    uint64_t hits{0};
+    uint64_t misses{0};
+    int size{0};
+    int limit{0};
+};
+
 /*!
  * Parses and evaluates scripts for a given Track, TrackList or Playlist.
  * @note this class will take ownership of ScriptRegistry if passed in the constructor.
@@ -64,6 +73,12 @@ public:
 
     [[nodiscard]] ScriptRegistry* registry() const;
 
+    /*!
+     * Sets the index used to match simple (non-query) searches.
+     * Without an index, the metadata of each track is searched directly.
+     */
+    void setSearchIndex(std::shared_ptr<const TrackSearchIndex> index);
+
     ParsedScript parse(const QString& input);
     ParsedScript parseQuery(const QString& input);
 
@@ -85,8 +100,22 @@ public:
     PlaylistTrackList filter(const QString& input, const PlaylistTrackList& tracks);
     PlaylistTrackList filter(const ParsedScript& input, const PlaylistTrackList& tracks);
 
-    [[nodiscard]] int cacheLimit() const;
-    void setCacheLimit(int limit);
+    /*!
+     * Format scripts evaluated against a single Track are compiled into a flat program on first use,
+     * which resolves variables and functions once and folds constant sub-expressions.
+     * Enabled by default; disabling it forces the tree-walking evaluator.
+     */
+    void setCompileScripts(bool enabled);
+
+    /*!
+     * Parsed scripts are kept in a cache shared between all parsers, so a script only needs
+     * to be parsed once regardless of which parser or thread uses it.
+     * The limit is the total number of parsed scripts kept across the whole cache.
+     */
+    [[nodiscard]] static int cacheLimit();
+    static void setCacheLimit(int limit);
+    [[nodiscard]] static ScriptCacheStats cacheStats();
+    /** Clears this parser's compiled programs. The shared parse cache is left untouched. */
     void clearCache();
 
 private:
@@ -26,6 +26,8 @@
 
 #include <QObject>
 
+#include <functional>
+
 namespace Fooyin {
 class LibraryManager;
 class PlayerController;
@@ -35,7 +37,9 @@ class ScriptRegistryPrivate;
 class FYCORE_EXPORT ScriptRegistry
 {
 public:
-    using FuncRet = std::variant<int, uint64_t, float, QString, QStringList>;
+    using FuncRet      = std::variant<int, uint64_t, float, QString, QStringList>;
+    using VariableFunc = std::function<ScriptResult(const Track&)>;
+    using FunctionFunc = std::function<ScriptResult(const ScriptValueList&, const Track&)>;
 
     ScriptRegistry();
     explicit ScriptRegistry(LibraryManager* libraryManager);
@@ -59,6 +63,20 @@ public:
     [[nodiscard]] virtual ScriptResult function(const QString& func, const ScriptValueList& args,
                                                 const Playlist& playlist) const;
 
+    /*!
+     * Resolves @p var once so it can be evaluated for many tracks without repeating the lookup.
+     * The returned function must give the same result as value() for a Track.
+     * @note subclasses which override value() for a Track must also override this.
+     */
+    [[nodiscard]] virtual VariableFunc variableResolver(const QString& var) const;
+    /*!
+     * Resolves @p func once so it can be called for many tracks without repeating the lookup.
+     * The returned function must give the same result as function() for a Track.
+     */
+    [[nodiscard]] virtual FunctionFunc functionResolver(const QString& func) const;
+    /** Returns true if the result of @p func only depends on its arguments. */
+    [[nodiscard]] virtual bool isConstantFunction(const QString& func) const;
+
     virtual void setValue(const QString& var, const FuncRet& value, Track& track);
 
 protected:
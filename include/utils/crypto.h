@@ -26,10 +26,59 @@
 #include <QCryptographicHash>
 #include <QString>
 
+#include <concepts>
+
 namespace Fooyin {
+// Also holds the keys returned by Utils::generateNodeKey
 using Md5Hash = QByteArray;
 
 namespace Utils {
+/*!
+ * A fast, non-cryptographic 128-bit hash for deduplicating in-memory nodes
+ * (library tree, filter and playlist groups).
+ *
+ * Strings are hashed as UTF-16 without conversion, and each added value is length-delimited,
+ * so ("ab", "c") and ("a", "bc") produce different keys. Results are deterministic, but
+ * must not be relied on for anything security related.
+ */
+class FYUTILS_EXPORT KeyHasher
+{
+public:
+    KeyHasher();
+
+    void addData(QStringView data);
+    void addData(QByteArrayView data);
+    void addData(const QUuid& id);
+    void addData(uint64_t value);
+
+    [[nodiscard]] Md5Hash result() const;
+
+private:
+    void addBytes(const char* data, size_t size);
+
+    uint64_t m_low;
+    uint64_t m_high;
+};
+
+template <typename T>
+void addDataToKey(KeyHasher& hash, const T& arg)
+{
+    if constexpr(std::integral<T>) {
+        hash.addData(static_cast<uint64_t>(arg));
+    }
+    else {
+        hash.addData(arg);
+    }
+}
+
+template <typename... Args>
+Md5Hash generateNodeKey(const Args&... args)
+{
+    KeyHasher hash;
+    (addDataToKey(hash, args), ...);
+    return hash.result();
+}
+
 template <typename T>
 void addDataToHash(QCryptographicHash& hash, const T& arg)
 {
@@ -47,6 +47,7 @@ public:
     [[nodiscard]] QSqlError lastError() const;
 
     void bindValue(const QString& placeholder, const QVariant& value);
+    void bindValue(int pos, const QVariant& value);
     [[nodiscard]] QString executedQuery() const;
     bool exec();
 
@@ -0,0 +1,142 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <vector>
+
+namespace Fooyin {
+/*!
+ * A bounded, lock-free queue for exactly one producer thread and one consumer thread.
+ * All slots are allocated up front, so pushing and popping never allocate.
+ * The capacity is rounded up to the next power of two.
+ */
+template <typename QueueItem>
+class SpscQueue
+{
+public:
+    explicit SpscQueue(std::size_t capacity);
+
+    SpscQueue(const SpscQueue& other)            = delete;
+    SpscQueue& operator=(const SpscQueue& other) = delete;
+
+    [[nodiscard]] std::size_t capacity() const;
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] bool empty() const;
+
+    // Producer
+    [[nodiscard]] std::size_t freeSpace() const;
+    bool push(QueueItem item);
+
+    // Consumer
+    QueueItem* front();
+    void pop();
+    void clear();
+
+private:
+    static constexpr std::size_t CacheLineSize = 64;
+
+    std::vector<QueueItem> m_slots;
+    std::size_t m_mask;
+
+    alignas(CacheLineSize) std::atomic<std::size_t> m_head{0};
+    alignas(CacheLineSize) std::atomic<std::size_t> m_tail{0};
+};
+
+template <typename QueueItem>
+SpscQueue<QueueItem>::SpscQueue(std::size_t capacity)
+    : m_slots(std::bit_ceil(std::max<std::size_t>(capacity, 2)))
+    , m_mask{m_slots.size() - 1}
+{ }
+
+template <typename QueueItem>
+std::size_t SpscQueue<QueueItem>::capacity() const
+{
+    return m_slots.size();
+}
+
+template <typename QueueItem>
+std::size_t SpscQueue<QueueItem>::size() const
+{
+    const std::size_t head = m_head.load(std::memory_order_acquire);
+    const std::size_t tail = m_tail.load(std::memory_order_acquire);
+    return tail - head;
+}
+
+template <typename QueueItem>
+bool SpscQueue<QueueItem>::empty() const
+{
+    return size() == 0;
+}
+
+template <typename QueueItem>
+std::size_t SpscQueue<QueueItem>::freeSpace() const
+{
+    return capacity() - size();
+}
+
+template <typename QueueItem>
+bool SpscQueue<QueueItem>::push(QueueItem item)
+{
+    const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+    if(tail - m_head.load(std::memory_order_acquire) >= m_slots.size()) {
+        return false;
+    }
+
+    m_slots[tail & m_mask] = std::move(item);
+    m_tail.store(tail + 1, std::memory_order_release);
+
+    return true;
+}
+
+template <typename QueueItem>
+QueueItem* SpscQueue<QueueItem>::front()
+{
+    const std::size_t head = m_head.load(std::memory_order_relaxed);
+    if(head == m_tail.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+
+    return &m_slots[head & m_mask];
+}
+
+template <typename QueueItem>
+void SpscQueue<QueueItem>::pop()
+{
+    const std::size_t head = m_head.load(std::memory_order_relaxed);
+    if(head == m_tail.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    // Release the item's resources on the consumer side rather than when the slot is next reused
+    m_slots[head & m_mask] = QueueItem{};
+    m_head.store(head + 1, std::memory_order_release);
+}
+
+template <typename QueueItem>
+void SpscQueue<QueueItem>::clear()
+{
+    while(front()) {
+        pop();
+    }
+}
+} // namespace Fooyin
@@ -0,0 +1,68 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "fyutils_export.h"
+
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+
+namespace Fooyin {
+class StringPoolPrivate;
+
+/*!
+ * Thread-safe pool of shared string values.
+ *
+ * Interning a string returns a copy which shares its data with every other string of
+ * the same value that was interned, so values which repeat across many objects (artists,
+ * albums, genres etc.) are only stored once. Interned strings of equal value also point
+ * to the same data, so comparing them short-circuits on the data pointer.
+ */
+class FYUTILS_EXPORT StringPool
+{
+public:
+    StringPool();
+    ~StringPool();
+
+    StringPool(const StringPool& other)            = delete;
+    StringPool& operator=(const StringPool& other) = delete;
+
+    /** Returns the application-wide pool. */
+    static StringPool& global();
+
+    [[nodiscard]] QString intern(const QString& str);
+    [[nodiscard]] QStringList intern(const QStringList& list);
+
+    /** Returns the number of unique strings and lists in the pool. */
+    [[nodiscard]] size_t size() const;
+
+    /*!
+     * Removes all values which are no longer referenced outside of the pool.
+     * @returns the number of values removed.
+     */
+    size_t purge();
+    void clear();
+
+private:
+    std::unique_ptr<StringPoolPrivate> p;
+};
+} // namespace Fooyin
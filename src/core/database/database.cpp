@@ -30,8 +30,6 @@
 
 using namespace Qt::StringLiterals;
 
-constexpr auto CurrentSchemaVersion = 14;
-
 namespace {
 Fooyin::DbConnection::DbParams dbConnectionParams()
 {
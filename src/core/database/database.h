@@ -27,6 +27,9 @@
 #include <QObject>
 
 namespace Fooyin {
+/** The schema version the database is upgraded to on startup. */
+constexpr int CurrentSchemaVersion = 16;
+
 class FYCORE_EXPORT Database : public QObject
 {
     Q_OBJECT
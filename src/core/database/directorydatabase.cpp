@@ -0,0 +1,85 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "directorydatabase.h"
+
+#include <utils/database/dbquery.h>
+#include <utils/database/dbtransaction.h>
+
+using namespace Qt::StringLiterals;
+
+namespace Fooyin {
+DirectoryDatabase::Directories DirectoryDatabase::directories(int libraryId, const QString& filterHash) const
+{
+    const auto statement = u"SELECT Path, ModifiedTime, FileCount FROM LibraryDirectories "
+                           "WHERE LibraryID = :libraryId AND FilterHash = :filterHash;"_s;
+
+    DbQuery query{db(), statement};
+
+    query.bindValue(u":libraryId"_s, libraryId);
+    query.bindValue(u":filterHash"_s, filterHash);
+
+    if(!query.exec()) {
+        return {};
+    }
+
+    Directories directories;
+
+    while(query.next()) {
+        directories.emplace(query.value(0).toString(),
+                            Directory{query.value(1).toLongLong(), query.value(2).toInt()});
+    }
+
+    return directories;
+}
+
+bool DirectoryDatabase::storeDirectories(int libraryId, const QString& filterHash, const Directories& directories)
+{
+    DbTransaction transaction{db()};
+
+    if(!transaction) {
+        return false;
+    }
+
+    DbQuery clearQuery{db(), u"DELETE FROM LibraryDirectories WHERE LibraryID = :libraryId;"_s};
+    clearQuery.bindValue(u":libraryId"_s, libraryId);
+    if(!clearQuery.exec()) {
+        return false;
+    }
+
+    const auto statement = u"INSERT INTO LibraryDirectories (LibraryID, Path, ModifiedTime, FileCount, FilterHash) "
+                           "VALUES (:libraryId, :path, :modifiedTime, :fileCount, :filterHash);"_s;
+
+    DbQuery query{db(), statement};
+
+    for(const auto& [path, directory] : directories) {
+        query.bindValue(u":libraryId"_s, libraryId);
+        query.bindValue(u":path"_s, path);
+        query.bindValue(u":modifiedTime"_s, static_cast<qint64>(directory.modifiedTime));
+        query.bindValue(u":fileCount"_s, directory.fileCount);
+        query.bindValue(u":filterHash"_s, filterHash);
+
+        if(!query.exec()) {
+            return false;
+        }
+    }
+
+    return transaction.commit();
+}
+} // namespace Fooyin
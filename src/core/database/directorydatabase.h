@@ -0,0 +1,46 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <utils/database/dbmodule.h>
+
+#include <unordered_map>
+
+namespace Fooyin {
+/*!
+ * Persists the directories found by the last completed scan of each library, so
+ * incremental scans can skip listing directories which haven't changed.
+ */
+class DirectoryDatabase : public DbModule
+{
+public:
+    struct Directory
+    {
+        int64_t modifiedTime{0};
+        int fileCount{0};
+    };
+    using Directories = std::unordered_map<QString, Directory>;
+
+    /** Returns the directories of library @p libraryId, if they were found using filters with hash @p filterHash. */
+    [[nodiscard]] Directories directories(int libraryId, const QString& filterHash) const;
+    /** Replaces the directories of library @p libraryId. */
+    bool storeDirectories(int libraryId, const QString& filterHash, const Directories& directories);
+};
+} // namespace Fooyin
@@ -22,6 +22,9 @@
 #include <utils/database/dbquery.h>
 #include <utils/database/dbtransaction.h>
 
+#include <algorithm>
+#include <utility>
+
 using namespace Qt::StringLiterals;
 
 namespace Fooyin {
@@ -53,9 +56,10 @@ std::vector<PlaylistInfo> PlaylistDatabase::getAllPlaylists()
     return playlists;
 }
 
-TrackList PlaylistDatabase::getPlaylistTracks(const Playlist& playlist, const std::unordered_map<int, Track>& tracks)
+TrackList PlaylistDatabase::getPlaylistTracks(const Playlist& playlist, const std::unordered_map<int, Track>& tracks,
+                                              bool& indexesValid)
 {
-    return populatePlaylistTracks(playlist, tracks);
+    return populatePlaylistTracks(playlist, tracks, indexesValid);
 }
 
 int PlaylistDatabase::insertPlaylist(const QString& name, int index, bool isAutoPlaylist, const QString& autoQuery)
@@ -82,44 +86,46 @@ int PlaylistDatabase::insertPlaylist(const QString& name, int index, bool isAuto
 
 bool PlaylistDatabase::savePlaylist(Playlist& playlist)
 {
-    bool updated{false};
-
-    if(playlist.modified()) {
-        const auto statement = u"UPDATE Playlists SET Name = :name, PlaylistIndex = :index, IsAutoPlaylist = "
-                               ":isAutoPlaylist, Query = :query WHERE PlaylistID = :id;"_s;
-
-        DbQuery query{db(), statement};
-
-        query.bindValue(u":name"_s, playlist.name());
-        query.bindValue(u":index"_s, playlist.index());
-        query.bindValue(u":isAutoPlaylist"_s, playlist.isAutoPlaylist());
-        query.bindValue(u":query"_s, playlist.query());
-        query.bindValue(u":id"_s, playlist.dbId());
-
-        updated = query.exec();
-    }
-
-    if(!playlist.isAutoPlaylist() && playlist.tracksModified()) {
-        updated = insertPlaylistTracks(playlist.dbId(), playlist.tracks());
+    DbTransaction transaction{db()};
+    if(!transaction) {
+        return false;
     }
 
-    if(updated) {
+    if(writePlaylist(playlist) && transaction.commit()) {
         playlist.resetFlags();
         return true;
     }
 
+    saveFailed(playlist);
     return false;
 }
 
 bool PlaylistDatabase::saveModifiedPlaylists(const PlaylistList& playlists)
 {
     DbTransaction transaction{db()};
+    if(!transaction) {
+        return false;
+    }
+
+    std::vector<Playlist*> saved;
 
     for(const auto& playlist : playlists) {
-        savePlaylist(*playlist);
+        if(writePlaylist(*playlist)) {
+            saved.push_back(playlist);
+        }
+        else {
+            saveFailed(*playlist);
+        }
     }
 
-    return transaction.commit();
+    if(!transaction.commit()) {
+        std::ranges::for_each(saved, [](Playlist* playlist) { saveFailed(*playlist); });
+        return false;
+    }
+
+    std::ranges::for_each(saved, [](Playlist* playlist) { playlist->resetFlags(); });
+
+    return saved.size() == playlists.size();
 }
 
 bool PlaylistDatabase::removePlaylist(int id)
@@ -176,21 +182,170 @@ bool PlaylistDatabase::insertPlaylistTracks(int playlistId, const TrackList& tra
         return false;
     }
 
+    // Indexes match the playlist, leaving gaps for tracks which aren't stored
     for(int i{0}; const auto& track : tracks) {
         if(track.isValid() && track.isInDatabase()) {
-            if(!insertPlaylistTrack(playlistId, track, i++)) {
+            if(!insertPlaylistTrack(playlistId, track, i)) {
+                return false;
+            }
+        }
+        ++i;
+    }
+
+    return true;
+}
+
+bool PlaylistDatabase::savePlaylistTracks(int playlistId, const TrackList& tracks,
+                                          const std::vector<PlaylistTrackEdit>& edits)
+{
+    if(std::ranges::any_of(edits, [](const auto& edit) { return edit.type == PlaylistTrackEdit::Type::Reset; })) {
+        return insertPlaylistTracks(playlistId, tracks);
+    }
+
+    for(const auto& edit : edits) {
+        bool success{false};
+
+        switch(edit.type) {
+            case(PlaylistTrackEdit::Type::Insert):
+                success = insertTracksAt(playlistId, edit.index, edit.tracks);
+                break;
+            case(PlaylistTrackEdit::Type::Remove):
+                success = removeTracksAt(playlistId, edit.index, edit.count);
+                break;
+            case(PlaylistTrackEdit::Type::Move):
+                success = moveTracks(playlistId, edit.index, edit.count, edit.destination);
+                break;
+            case(PlaylistTrackEdit::Type::Reset):
+                break;
+        }
+
+        if(!success) {
+            return insertPlaylistTracks(playlistId, tracks);
+        }
+    }
+
+    return true;
+}
+
+bool PlaylistDatabase::writePlaylist(const Playlist& playlist)
+{
+    if(playlist.modified()) {
+        const auto statement = u"UPDATE Playlists SET Name = :name, PlaylistIndex = :index, IsAutoPlaylist = "
+                               ":isAutoPlaylist, Query = :query WHERE PlaylistID = :id;"_s;
+
+        DbQuery query{db(), statement};
+
+        query.bindValue(u":name"_s, playlist.name());
+        query.bindValue(u":index"_s, playlist.index());
+        query.bindValue(u":isAutoPlaylist"_s, playlist.isAutoPlaylist());
+        query.bindValue(u":query"_s, playlist.query());
+        query.bindValue(u":id"_s, playlist.dbId());
+
+        if(!query.exec()) {
+            return false;
+        }
+    }
+
+    if(!playlist.isAutoPlaylist() && playlist.tracksModified()) {
+        return savePlaylistTracks(playlist.dbId(), playlist.tracks(), playlist.trackEdits());
+    }
+
+    return true;
+}
+
+void PlaylistDatabase::saveFailed(Playlist& playlist)
+{
+    // Some edits may have been applied before the failure, so the stored tracks can't be trusted
+    if(playlist.tracksModified()) {
+        playlist.setTracksModified(true);
+    }
+}
+
+bool PlaylistDatabase::insertTracksAt(int playlistId, int index, const TrackList& tracks)
+{
+    const auto statement = u"UPDATE PlaylistTracks SET TrackIndex = TrackIndex + :count "
+                           "WHERE PlaylistID = :id AND TrackIndex >= :index;"_s;
+
+    DbQuery query{db(), statement};
+    query.bindValue(u":count"_s, static_cast<int>(tracks.size()));
+    query.bindValue(u":id"_s, playlistId);
+    query.bindValue(u":index"_s, index);
+
+    if(!query.exec()) {
+        return false;
+    }
+
+    for(int i{index}; const auto& track : tracks) {
+        if(track.isValid() && track.isInDatabase()) {
+            if(!insertPlaylistTrack(playlistId, track, i)) {
                 return false;
             }
         }
+        ++i;
     }
 
     return true;
 }
 
+bool PlaylistDatabase::removeTracksAt(int playlistId, int index, int count)
+{
+    const auto deleteStatement = u"DELETE FROM PlaylistTracks "
+                                 "WHERE PlaylistID = :id AND TrackIndex >= :index AND TrackIndex < :end;"_s;
+
+    DbQuery deleteQuery{db(), deleteStatement};
+    deleteQuery.bindValue(u":id"_s, playlistId);
+    deleteQuery.bindValue(u":index"_s, index);
+    deleteQuery.bindValue(u":end"_s, index + count);
+
+    if(!deleteQuery.exec()) {
+        return false;
+    }
+
+    const auto shiftStatement = u"UPDATE PlaylistTracks SET TrackIndex = TrackIndex - :count "
+                                "WHERE PlaylistID = :id AND TrackIndex >= :end;"_s;
+
+    DbQuery shiftQuery{db(), shiftStatement};
+    shiftQuery.bindValue(u":count"_s, count);
+    shiftQuery.bindValue(u":id"_s, playlistId);
+    shiftQuery.bindValue(u":end"_s, index + count);
+
+    return shiftQuery.exec();
+}
+
+bool PlaylistDatabase::moveTracks(int playlistId, int index, int count, int destination)
+{
+    if(index == destination || count <= 0) {
+        return true;
+    }
+
+    // Tracks between the old and new position shift by count in the opposite direction
+    const int start = std::min(index, destination);
+    const int end   = std::max(index, destination) + count;
+
+    const auto statement = u"UPDATE PlaylistTracks SET TrackIndex = CASE "
+                           "WHEN TrackIndex >= :index AND TrackIndex < :indexEnd THEN TrackIndex + :offset "
+                           "ELSE TrackIndex + :shift END "
+                           "WHERE PlaylistID = :id AND TrackIndex >= :start AND TrackIndex < :end;"_s;
+
+    DbQuery query{db(), statement};
+    query.bindValue(u":index"_s, index);
+    query.bindValue(u":indexEnd"_s, index + count);
+    query.bindValue(u":offset"_s, destination - index);
+    query.bindValue(u":shift"_s, destination > index ? -count : count);
+    query.bindValue(u":id"_s, playlistId);
+    query.bindValue(u":start"_s, start);
+    query.bindValue(u":end"_s, end);
+
+    return query.exec();
+}
+
 TrackList PlaylistDatabase::populatePlaylistTracks(const Playlist& playlist,
-                                                   const std::unordered_map<int, Track>& tracks)
+                                                   const std::unordered_map<int, Track>& tracks, bool& indexesValid)
 {
-    const auto statement = u"SELECT TrackID FROM PlaylistTracks WHERE PlaylistID=:playlistId ORDER BY TrackIndex;"_s;
+    const auto statement
+        = u"SELECT TrackID, TrackIndex FROM PlaylistTracks WHERE PlaylistID=:playlistId ORDER BY TrackIndex;"_s;
+
+    indexesValid = false;
 
     DbQuery query{db(), statement};
     query.bindValue(u":playlistId"_s, playlist.dbId());
@@ -200,14 +355,21 @@ TrackList PlaylistDatabase::populatePlaylistTracks(const Playlist& playlist,
     }
 
     TrackList playlistTracks;
+    bool contiguous{true};
 
     while(query.next()) {
         const int trackId = query.value(0).toInt();
         if(tracks.contains(trackId)) {
+            contiguous &= std::cmp_equal(query.value(1).toInt(), playlistTracks.size());
             playlistTracks.push_back(tracks.at(trackId));
         }
+        else {
+            contiguous = false;
+        }
     }
 
+    indexesValid = contiguous;
+
     return playlistTracks;
 }
 } // namespace Fooyin
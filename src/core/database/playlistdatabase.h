@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include "fycore_export.h"
+
 #include <core/playlist/playlist.h>
 #include <core/track.h>
 #include <utils/database/dbmodule.h>
@@ -33,22 +35,43 @@ struct PlaylistInfo
     QString query;
 };
 
-class PlaylistDatabase : public DbModule
+class FYCORE_EXPORT PlaylistDatabase : public DbModule
 {
 public:
     std::vector<PlaylistInfo> getAllPlaylists();
-    TrackList getPlaylistTracks(const Playlist& playlist, const std::unordered_map<int, Track>& tracks);
+    /*!
+     * Returns the stored tracks of @p playlist which exist in @p tracks.
+     * @param indexesValid set to @c true if every stored track was found and stored indexes are contiguous,
+     * meaning later edits can be saved as deltas.
+     */
+    TrackList getPlaylistTracks(const Playlist& playlist, const std::unordered_map<int, Track>& tracks,
+                                bool& indexesValid);
 
     int insertPlaylist(const QString& name, int index, bool isAutoPlaylist, const QString& autoQuery);
 
+    /*!
+     * Saves any changes to @p playlist in a single transaction.
+     * Flags and track edits are only reset once committed; on failure the next save rewrites all tracks.
+     */
     bool savePlaylist(Playlist& playlist);
     bool saveModifiedPlaylists(const PlaylistList& playlists);
+    /*!
+     * Saves @p tracks as the tracks of the playlist with @p playlistId by replaying @p edits
+     * against the stored tracks. Falls back to rewriting all tracks if an edit can't be applied.
+     */
+    bool savePlaylistTracks(int playlistId, const TrackList& tracks, const std::vector<PlaylistTrackEdit>& edits);
     bool removePlaylist(int id);
     bool renamePlaylist(int id, const QString& name);
 
 private:
     bool insertPlaylistTrack(int playlistId, const Fooyin::Track& track, int index);
     bool insertPlaylistTracks(int playlistId, const TrackList& tracks);
-    TrackList populatePlaylistTracks(const Playlist& playlist, const std::unordered_map<int, Track>& tracks);
+    bool writePlaylist(const Playlist& playlist);
+    static void saveFailed(Playlist& playlist);
+    bool insertTracksAt(int playlistId, int index, const TrackList& tracks);
+    bool removeTracksAt(int playlistId, int index, int count);
+    bool moveTracks(int playlistId, int index, int count, int destination);
+    TrackList populatePlaylistTracks(const Playlist& playlist, const std::unordered_map<int, Track>& tracks,
+                                     bool& indexesValid);
 };
 } // namespace Fooyin
@@ -0,0 +1,300 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "sortcachedatabase.h"
+
+#include <core/constants.h>
+#include <utils/crypto.h>
+#include <utils/database/dbquery.h>
+#include <utils/database/dbtransaction.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <ranges>
+#include <type_traits>
+#include <unordered_set>
+
+using namespace Qt::StringLiterals;
+
+namespace {
+// Indexes are spaced out so tracks which change can usually be given a new index without moving their neighbours
+constexpr int64_t IndexSpacing = 1024;
+
+struct SortRow
+{
+    int64_t index{0};
+    bool kept{false};
+};
+
+// Gives each track an index which is increasing in sorted order, keeping the cached index of as many
+// unchanged tracks as possible. Returns false if there was no room and every track needs a new index.
+bool assignIndexes(const Fooyin::TrackList& tracks, const Fooyin::SortCacheDatabase::CachedSorts& cachedSorts,
+                   const std::vector<QString>& stamps, std::vector<SortRow>& rows)
+{
+    rows.assign(tracks.size(), {});
+
+    int64_t lastKept{0};
+    for(size_t i{0}; i < tracks.size(); ++i) {
+        const Fooyin::Track& track = tracks.at(i);
+        const auto cached          = cachedSorts.find(track.id());
+        if(cached != cachedSorts.cend() && cached->second.index > lastKept && cached->second.stamp == stamps.at(i)
+           && cached->second.sortKey == track.sort()) {
+            rows[i]  = {.index = cached->second.index, .kept = true};
+            lastKept = cached->second.index;
+        }
+    }
+
+    // Spread each run of new indexes evenly over the gap between the kept indexes either side
+    int64_t lower{0};
+    size_t runStart{0};
+
+    for(size_t i{0}; i <= rows.size(); ++i) {
+        if(i < rows.size() && !rows.at(i).kept) {
+            continue;
+        }
+
+        const auto runLength = static_cast<int64_t>(i - runStart);
+        if(runLength > 0) {
+            const int64_t step = i < rows.size() ? (rows.at(i).index - lower) / (runLength + 1) : IndexSpacing;
+            if(step < 1) {
+                return false;
+            }
+            for(int64_t n{0}; n < runLength; ++n) {
+                rows[runStart + static_cast<size_t>(n)].index = lower + (step * (n + 1));
+            }
+        }
+
+        if(i < rows.size()) {
+            lower = rows.at(i).index;
+        }
+        runStart = i + 1;
+    }
+
+    return true;
+}
+} // namespace
+
+namespace Fooyin {
+QString SortCacheDatabase::scriptHash(const QString& script)
+{
+    return Utils::generateHash(script);
+}
+
+bool SortCacheDatabase::usesPlayStats(const QString& script)
+{
+    using namespace Constants::MetaData;
+
+    // Checked loosely, so a script which only mentions a field in passing still has it stamped.
+    // This also covers RATING_STARS and RATING_EDITOR.
+    static const std::array<QLatin1StringView, 4> fields{QLatin1StringView{PlayCount}, QLatin1StringView{Rating},
+                                                         QLatin1StringView{FirstPlayed}, QLatin1StringView{LastPlayed}};
+
+    return std::ranges::any_of(fields,
+                               [&script](const auto field) { return script.contains(field, Qt::CaseInsensitive); });
+}
+
+QString SortCacheDatabase::trackStamp(const Track& track, bool includePlayStats)
+{
+    Utils::KeyHasher hasher;
+
+    const auto addNumber = [&hasher](auto value) {
+        if constexpr(std::is_floating_point_v<decltype(value)>) {
+            hasher.addData(static_cast<uint64_t>(std::bit_cast<uint32_t>(static_cast<float>(value))));
+        }
+        else {
+            hasher.addData(static_cast<uint64_t>(value));
+        }
+    };
+
+    hasher.addData(track.filepath());
+    addNumber(track.subsong());
+    addNumber(track.offset());
+    addNumber(track.libraryId());
+    addNumber(track.isEnabled());
+    addNumber(track.addedTime());
+    addNumber(track.modifiedTime());
+    addNumber(track.lastModified());
+
+    // Metadata can be edited without changing the file's modification time, so every tag is stamped
+    const auto metadata = track.metadata();
+    for(auto it = metadata.cbegin(); it != metadata.cend(); ++it) {
+        hasher.addData(it.key());
+        hasher.addData(it.value());
+    }
+    hasher.addData(track.serialiseExtraTags());
+    hasher.addData(track.serialiseExtraProperties());
+    hasher.addData(track.cuePath());
+
+    addNumber(track.duration());
+    addNumber(track.fileSize());
+    addNumber(track.bitrate());
+    addNumber(track.sampleRate());
+    addNumber(track.channels());
+    addNumber(track.bitDepth());
+    hasher.addData(track.codec());
+    hasher.addData(track.codecProfile());
+    hasher.addData(track.tool());
+    hasher.addData(track.tagType());
+    hasher.addData(track.encoding());
+    addNumber(track.rgTrackGain());
+    addNumber(track.rgAlbumGain());
+    addNumber(track.rgTrackPeak());
+    addNumber(track.rgAlbumPeak());
+
+    if(includePlayStats) {
+        addNumber(track.playCount());
+        addNumber(track.rating());
+        addNumber(track.firstPlayed());
+        addNumber(track.lastPlayed());
+    }
+
+    return QString::fromLatin1(hasher.result().toHex());
+}
+
+TrackList SortCacheDatabase::restoreSorts(const CachedSorts& cachedSorts, const TrackList& tracks,
+                                          bool includePlayStats, TrackList& changedTracks)
+{
+    std::vector<std::pair<int64_t, Track>> cachedTracks;
+    cachedTracks.reserve(tracks.size());
+
+    for(const Track& track : tracks) {
+        const auto cached = cachedSorts.find(track.id());
+        if(cached != cachedSorts.cend() && cached->second.stamp == trackStamp(track, includePlayStats)) {
+            Track cachedTrack{track};
+            cachedTrack.setSort(cached->second.sortKey);
+            cachedTracks.emplace_back(cached->second.index, cachedTrack);
+        }
+        else {
+            changedTracks.push_back(track);
+        }
+    }
+
+    std::ranges::sort(cachedTracks, {}, &std::pair<int64_t, Track>::first);
+
+    TrackList sortedTracks;
+    sortedTracks.reserve(tracks.size());
+    std::ranges::transform(cachedTracks, std::back_inserter(sortedTracks),
+                           [](const auto& cachedTrack) { return cachedTrack.second; });
+
+    return sortedTracks;
+}
+
+SortCacheDatabase::CachedSorts SortCacheDatabase::cachedSorts(const QString& scriptHash) const
+{
+    const auto statement
+        = u"SELECT TrackID, Stamp, SortKey, SortIndex FROM TrackSorts WHERE ScriptHash = :scriptHash;"_s;
+
+    DbQuery query{db(), statement};
+
+    query.bindValue(u":scriptHash"_s, scriptHash);
+
+    if(!query.exec()) {
+        return {};
+    }
+
+    CachedSorts sorts;
+
+    while(query.next()) {
+        sorts.emplace(query.value(0).toInt(),
+                      CachedSort{query.value(1).toString(), query.value(2).toString(), query.value(3).toLongLong()});
+    }
+
+    return sorts;
+}
+
+bool SortCacheDatabase::storeSorts(const QString& script, const TrackList& sortedTracks)
+{
+    const QString hash              = scriptHash(script);
+    const bool includePlayStats     = usesPlayStats(script);
+    const CachedSorts previousSorts = cachedSorts(hash);
+
+    TrackList tracks;
+    std::vector<QString> stamps;
+    tracks.reserve(sortedTracks.size());
+    stamps.reserve(sortedTracks.size());
+
+    for(const Track& track : sortedTracks) {
+        if(track.isInDatabase()) {
+            tracks.push_back(track);
+            stamps.push_back(trackStamp(track, includePlayStats));
+        }
+    }
+
+    std::vector<SortRow> rows;
+    if(!assignIndexes(tracks, previousSorts, stamps, rows)) {
+        // No room left between neighbours, so renumber everything
+        for(size_t i{0}; i < rows.size(); ++i) {
+            rows[i] = {.index = static_cast<int64_t>(i + 1) * IndexSpacing, .kept = false};
+        }
+    }
+
+    DbTransaction transaction{db()};
+
+    if(!transaction) {
+        return false;
+    }
+
+    // Rows from a previous sort script
+    DbQuery clearQuery{db(), u"DELETE FROM TrackSorts WHERE ScriptHash != :scriptHash;"_s};
+    clearQuery.bindValue(u":scriptHash"_s, hash);
+    if(!clearQuery.exec()) {
+        return false;
+    }
+
+    std::unordered_set<int> trackIds;
+    trackIds.reserve(tracks.size());
+
+    const auto statement = u"INSERT OR REPLACE INTO TrackSorts (TrackID, ScriptHash, Stamp, SortKey, SortIndex) "
+                           "VALUES (:trackId, :scriptHash, :stamp, :sortKey, :sortIndex);"_s;
+
+    DbQuery query{db(), statement};
+
+    for(size_t i{0}; i < tracks.size(); ++i) {
+        const Track& track = tracks.at(i);
+        trackIds.emplace(track.id());
+
+        if(rows.at(i).kept) {
+            continue;
+        }
+
+        query.bindValue(u":trackId"_s, track.id());
+        query.bindValue(u":scriptHash"_s, hash);
+        query.bindValue(u":stamp"_s, stamps.at(i));
+        query.bindValue(u":sortKey"_s, track.sort());
+        query.bindValue(u":sortIndex"_s, static_cast<qint64>(rows.at(i).index));
+
+        if(!query.exec()) {
+            return false;
+        }
+    }
+
+    DbQuery deleteQuery{db(), u"DELETE FROM TrackSorts WHERE TrackID = :trackId;"_s};
+
+    for(const int id : previousSorts | std::views::keys) {
+        if(!trackIds.contains(id)) {
+            deleteQuery.bindValue(u":trackId"_s, id);
+            if(!deleteQuery.exec()) {
+                return false;
+            }
+        }
+    }
+
+    return transaction.commit();
+}
+} // namespace Fooyin
@@ -0,0 +1,70 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include "fycore_export.h"
+
+#include <core/track.h>
+#include <utils/database/dbmodule.h>
+
+#include <unordered_map>
+
+namespace Fooyin {
+/*!
+ * Persists the library sort keys computed from a sort script, along with the
+ * resulting order, so unchanged tracks can skip script evaluation on startup.
+ */
+class FYCORE_EXPORT SortCacheDatabase : public DbModule
+{
+public:
+    struct CachedSort
+    {
+        QString stamp;
+        QString sortKey;
+        int64_t index{-1};
+    };
+    using CachedSorts = std::unordered_map<int, CachedSort>;
+
+    /** Returns a hash identifying the sort script @p script. */
+    static QString scriptHash(const QString& script);
+    /** Returns true if @p script could read the playback statistics (play count, rating etc.) of a track. */
+    static bool usesPlayStats(const QString& script);
+    /*!
+     * Returns a stamp which changes whenever any field of @p track which could affect its sort key changes.
+     * Playback statistics are only included if @p includePlayStats is set, as they change on every play.
+     */
+    static QString trackStamp(const Track& track, bool includePlayStats);
+
+    /*!
+     * Restores the cached order of @p tracks.
+     * @returns the tracks which are unchanged since they were cached, with their cached sort keys and in
+     * their cached order. Any other tracks are appended to @p changedTracks.
+     */
+    static TrackList restoreSorts(const CachedSorts& cachedSorts, const TrackList& tracks, bool includePlayStats,
+                                  TrackList& changedTracks);
+
+    /** Returns the cached sort keys of all tracks for the script with hash @p scriptHash. */
+    [[nodiscard]] CachedSorts cachedSorts(const QString& scriptHash) const;
+    /*!
+     * Updates the cache to hold the sort keys and order of @p sortedTracks, evaluated with @p script.
+     * Only rows which have changed are written.
+     */
+    bool storeSorts(const QString& script, const TrackList& sortedTracks);
+};
+} // namespace Fooyin
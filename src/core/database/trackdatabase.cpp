@@ -28,11 +28,14 @@
 #include <QFileInfo>
 #include <QLoggingCategory>
 
+#include <set>
+#include <unordered_map>
+
 Q_LOGGING_CATEGORY(TRK_DB, "fy.trackdb")
 
 using namespace Qt::StringLiterals;
 
-using BindingsMap = std::map<QString, QVariant>;
+constexpr auto RevisionSetting = "TracksRevision";
 
 namespace {
 QString fetchTrackColumns()
@@ -84,45 +87,184 @@ QString fetchTrackColumns()
     return columns;
 }
 
-BindingsMap trackBindings(const Fooyin::Track& track)
-{
-    return {{u":filePath"_s, track.filepath()},
-            {u":subsong"_s, track.subsong()},
-            {u":title"_s, track.title()},
-            {u":trackNumber"_s, track.trackNumber()},
-            {u":trackTotal"_s, track.trackTotal()},
-            {u":artists"_s, track.artist()},
-            {u":albumArtist"_s, track.albumArtist()},
-            {u":album"_s, track.album()},
-            {u":discNumber"_s, track.discNumber()},
-            {u":discTotal"_s, track.discTotal()},
-            {u":date"_s, track.date()},
-            {u":composer"_s, track.composer()},
-            {u":performer"_s, track.performer()},
-            {u":genres"_s, track.genre()},
-            {u":comment"_s, track.comment()},
-            {u":cuePath"_s, track.cuePath()},
-            {u":offset"_s, static_cast<quint64>(track.offset())},
-            {u":duration"_s, static_cast<quint64>(track.duration())},
-            {u":fileSize"_s, static_cast<quint64>(track.fileSize())},
-            {u":bitRate"_s, track.bitrate()},
-            {u":sampleRate"_s, track.sampleRate()},
-            {u":channels"_s, track.channels()},
-            {u":bitDepth"_s, track.bitDepth()},
-            {u":codec"_s, track.codec()},
-            {u":codecProfile"_s, track.codecProfile()},
-            {u":tool"_s, track.tool()},
-            {u":tagTypes"_s, track.tagType()},
-            {u":encoding"_s, track.encoding()},
-            {u":extraTags"_s, track.serialiseExtraTags()},
-            {u":extraProperties"_s, track.serialiseExtraProperties()},
-            {u":modifiedDate"_s, static_cast<quint64>(track.modifiedTime())},
-            {u":trackHash"_s, track.hash()},
-            {u":libraryID"_s, track.libraryId()},
-            {u":rgTrackGain"_s, track.rgTrackGain()},
-            {u":rgAlbumGain"_s, track.rgAlbumGain()},
-            {u":rgTrackPeak"_s, track.rgTrackPeak()},
-            {u":rgAlbumPeak"_s, track.rgAlbumPeak()}};
+// Must match the order of columns in insertTrackColumns
+constexpr auto TrackColumnCount = 37;
+constexpr auto StatsColumnCount = 6;
+// SQLite versions prior to 3.32 limit statements to 999 host parameters
+constexpr auto MaxBoundValues = 999;
+constexpr auto TrackBatchSize = MaxBoundValues / TrackColumnCount;
+constexpr auto StatsBatchSize = MaxBoundValues / StatsColumnCount;
+
+struct TrackStats
+{
+    uint64_t added{0};
+    uint64_t firstPlayed{0};
+    uint64_t lastPlayed{0};
+    int playCount{0};
+    float rating{0};
+};
+
+QString insertTrackColumns()
+{
+    static const QString columns = u"FilePath,"
+                                   "Subsong,"
+                                   "Title,"
+                                   "TrackNumber,"
+                                   "TrackTotal,"
+                                   "Artists,"
+                                   "AlbumArtist,"
+                                   "Album,"
+                                   "DiscNumber,"
+                                   "DiscTotal,"
+                                   "Date,"
+                                   "Composer,"
+                                   "Performer,"
+                                   "Genres,"
+                                   "Comment,"
+                                   "CuePath,"
+                                   "Offset,"
+                                   "Duration,"
+                                   "FileSize,"
+                                   "BitRate,"
+                                   "SampleRate,"
+                                   "Channels,"
+                                   "BitDepth,"
+                                   "Codec,"
+                                   "CodecProfile,"
+                                   "Tool,"
+                                   "TagTypes,"
+                                   "Encoding,"
+                                   "ExtraTags,"
+                                   "ExtraProperties,"
+                                   "ModifiedDate,"
+                                   "TrackHash,"
+                                   "LibraryID,"
+                                   "RGTrackGain,"
+                                   "RGAlbumGain,"
+                                   "RGTrackPeak,"
+                                   "RGAlbumPeak"_s;
+
+    return columns;
+}
+
+QString valuesPlaceholder(int columns, int rows)
+{
+    QString row = u"("_s;
+    for(int i{0}; i < columns; ++i) {
+        row.append(i == 0 ? u"?"_s : u",?"_s);
+    }
+    row.append(u")"_s);
+
+    QStringList values;
+    values.reserve(rows);
+    for(int i{0}; i < rows; ++i) {
+        values.append(row);
+    }
+
+    return values.join(u","_s);
+}
+
+QString insertTracksStatement(int rows)
+{
+    return u"INSERT INTO Tracks (%1) VALUES %2;"_s.arg(insertTrackColumns(), valuesPlaceholder(TrackColumnCount, rows));
+}
+
+QString updateTrackStatement()
+{
+    static const QString statement = []() {
+        QStringList columns = insertTrackColumns().split(u',');
+        for(QString& column : columns) {
+            column.append(u" = ?"_s);
+        }
+        return u"UPDATE Tracks SET %1 WHERE TrackID = ?;"_s.arg(columns.join(u","_s));
+    }();
+
+    return statement;
+}
+
+int bindTrack(Fooyin::DbQuery& query, int pos, const Fooyin::Track& track)
+{
+    query.bindValue(pos++, track.filepath());
+    query.bindValue(pos++, track.subsong());
+    query.bindValue(pos++, track.title());
+    query.bindValue(pos++, track.trackNumber());
+    query.bindValue(pos++, track.trackTotal());
+    query.bindValue(pos++, track.artist());
+    query.bindValue(pos++, track.albumArtist());
+    query.bindValue(pos++, track.album());
+    query.bindValue(pos++, track.discNumber());
+    query.bindValue(pos++, track.discTotal());
+    query.bindValue(pos++, track.date());
+    query.bindValue(pos++, track.composer());
+    query.bindValue(pos++, track.performer());
+    query.bindValue(pos++, track.genre());
+    query.bindValue(pos++, track.comment());
+    query.bindValue(pos++, track.cuePath());
+    query.bindValue(pos++, static_cast<quint64>(track.offset()));
+    query.bindValue(pos++, static_cast<quint64>(track.duration()));
+    query.bindValue(pos++, static_cast<quint64>(track.fileSize()));
+    query.bindValue(pos++, track.bitrate());
+    query.bindValue(pos++, track.sampleRate());
+    query.bindValue(pos++, track.channels());
+    query.bindValue(pos++, track.bitDepth());
+    query.bindValue(pos++, track.codec());
+    query.bindValue(pos++, track.codecProfile());
+    query.bindValue(pos++, track.tool());
+    query.bindValue(pos++, track.tagType());
+    query.bindValue(pos++, track.encoding());
+    query.bindValue(pos++, track.serialiseExtraTags());
+    query.bindValue(pos++, track.serialiseExtraProperties());
+    query.bindValue(pos++, static_cast<quint64>(track.modifiedTime()));
+    query.bindValue(pos++, track.hash());
+    query.bindValue(pos++, track.libraryId());
+    query.bindValue(pos++, track.rgTrackGain());
+    query.bindValue(pos++, track.rgAlbumGain());
+    query.bindValue(pos++, track.rgTrackPeak());
+    query.bindValue(pos++, track.rgAlbumPeak());
+
+    return pos;
+}
+
+bool mergeStats(const Fooyin::Track& track, TrackStats& stats)
+{
+    bool changed{false};
+
+    const uint64_t trackAdded       = track.addedTime();
+    const uint64_t trackFirstPlayed = track.firstPlayed();
+    const uint64_t trackLastPlayed  = track.lastPlayed();
+    const int trackPlayCount        = track.playCount();
+    const float trackRating         = track.rating();
+
+    if(trackAdded != stats.added) {
+        if(stats.added == 0 || (trackAdded > 0 && trackAdded < stats.added)) {
+            stats.added = trackAdded;
+            changed     = true;
+        }
+    }
+    if(trackFirstPlayed != stats.firstPlayed) {
+        if(stats.firstPlayed == 0 || (trackFirstPlayed > 0 && trackFirstPlayed < stats.firstPlayed)) {
+            stats.firstPlayed = trackFirstPlayed;
+            changed           = true;
+        }
+    }
+    if(trackLastPlayed != stats.lastPlayed) {
+        if(trackLastPlayed > stats.lastPlayed) {
+            stats.lastPlayed = trackLastPlayed;
+            changed          = true;
+        }
+    }
+    if(trackPlayCount != stats.playCount) {
+        if(trackPlayCount > stats.playCount) {
+            stats.playCount = trackPlayCount;
+            changed         = true;
+        }
+    }
+    if(trackRating != stats.rating) {
+        stats.rating = trackRating;
+        changed      = true;
+    }
+
+    return changed;
 }
 
 Fooyin::Track readToTrack(const Fooyin::DbQuery& q)
@@ -193,7 +335,14 @@ Fooyin::Track readToTrack(const Fooyin::DbQuery& q)
 namespace Fooyin {
 bool TrackDatabase::storeTracks(TrackList& tracks)
 {
-    if(tracks.empty()) {
+    std::vector<Track*> newTracks;
+    for(auto& track : tracks) {
+        if(track.id() < 0) {
+            newTracks.push_back(&track);
+        }
+    }
+
+    if(newTracks.empty()) {
         return true;
     }
 
@@ -203,12 +352,50 @@ bool TrackDatabase::storeTracks(TrackList& tracks)
         return false;
     }
 
-    for(auto& track : tracks) {
-        if(track.id() < 0) {
-            insertTrack(track);
+    // Full batches share a single prepared statement
+    DbQuery batchQuery;
+    TrackList insertedTracks;
+    insertedTracks.reserve(newTracks.size());
+
+    const auto total = static_cast<int>(newTracks.size());
+
+    for(int start{0}; start < total; start += TrackBatchSize) {
+        const int count = std::min(TrackBatchSize, total - start);
+
+        DbQuery remainderQuery;
+        DbQuery& query = count == TrackBatchSize ? batchQuery : remainderQuery;
+        if(query.status() == DbQuery::Status::None) {
+            query = DbQuery{db(), insertTracksStatement(count)};
+        }
+
+        int pos{0};
+        for(int i{0}; i < count; ++i) {
+            pos = bindTrack(query, pos, *newTracks.at(start + i));
+        }
+
+        if(query.exec()) {
+            // Rows inserted by a single statement are assigned consecutive rowids
+            const int lastId = query.lastInsertId().toInt();
+            for(int i{0}; i < count; ++i) {
+                Track* track = newTracks.at(start + i);
+                track->setId(lastId - count + 1 + i);
+                insertedTracks.push_back(*track);
+            }
+        }
+        else {
+            // Fall back to inserting individually so a single bad row doesn't drop the whole batch
+            for(int i{0}; i < count; ++i) {
+                Track* track = newTracks.at(start + i);
+                if(insertTrack(*track)) {
+                    insertedTracks.push_back(*track);
+                }
+            }
         }
     }
 
+    insertOrUpdateStats(insertedTracks);
+    bumpRevision();
+
     return transaction.commit();
 }
 
@@ -224,15 +411,88 @@ bool TrackDatabase::updateTracks(TrackList& tracks)
         return false;
     }
 
-    for(auto& track : tracks) {
+    DbQuery query{db(), updateTrackStatement()};
+
+    for(const auto& track : tracks) {
         if(track.id() >= 0) {
-            updateTrack(track);
+            const int pos = bindTrack(query, 0, track);
+            query.bindValue(pos, track.id());
+            query.exec();
         }
     }
 
+    bumpRevision();
+
     return transaction.commit();
 }
 
+TrackTableState TrackDatabase::tableState() const
+{
+    TrackTableState state;
+
+    {
+        const auto statement = u"SELECT Value FROM Settings WHERE Name = :name;"_s;
+
+        DbQuery query{db(), statement};
+
+        query.bindValue(u":name"_s, QString::fromLatin1(RevisionSetting));
+
+        if(query.exec() && query.next()) {
+            state.revision = query.value(0).toULongLong();
+        }
+    }
+
+    const auto statement = u"SELECT COUNT(*), MAX(TrackID) FROM Tracks;"_s;
+
+    DbQuery query{db(), statement};
+
+    if(query.exec() && query.next()) {
+        state.count = query.value(0).toInt();
+        state.maxId = query.value(1).isNull() ? -1 : query.value(1).toInt();
+    }
+
+    return state;
+}
+
+bool TrackDatabase::loadTrackStats(TrackList& tracks) const
+{
+    const auto statement
+        = u"SELECT TrackHash, AddedDate, FirstPlayed, LastPlayed, PlayCount, Rating FROM TrackStats;"_s;
+
+    DbQuery query{db(), statement};
+
+    if(!query.exec()) {
+        return false;
+    }
+
+    std::unordered_map<QString, TrackStats> stats;
+
+    while(query.next()) {
+        stats.emplace(query.value(0).toString(), TrackStats{.added       = query.value(1).toULongLong(),
+                                                            .firstPlayed = query.value(2).toULongLong(),
+                                                            .lastPlayed  = query.value(3).toULongLong(),
+                                                            .playCount   = query.value(4).toInt(),
+                                                            .rating      = query.value(5).toFloat()});
+    }
+
+    for(Track& track : tracks) {
+        const auto statsIt = stats.find(track.hash());
+        if(statsIt == stats.cend()) {
+            continue;
+        }
+
+        const TrackStats& entry = statsIt->second;
+
+        track.setAddedTime(entry.added);
+        track.setFirstPlayed(entry.firstPlayed);
+        track.setLastPlayed(entry.lastPlayed);
+        track.setPlayCount(entry.playCount);
+        track.setRating(entry.rating);
+    }
+
+    return true;
+}
+
 bool TrackDatabase::reloadTrack(Track& track) const
 {
     const auto statement = u"SELECT %1 FROM TracksView WHERE TrackID = :trackId;"_s.arg(fetchTrackColumns());
@@ -348,87 +608,53 @@ bool TrackDatabase::updateTrack(const Track& track)
         return false;
     }
 
-    const auto statement = u"UPDATE TRACKS SET "
-                           "FilePath = :filePath,"
-                           "Subsong = :subsong,"
-                           "Title = :title, "
-                           "TrackNumber = :trackNumber,"
-                           "TrackTotal = :trackTotal,"
-                           "Artists = :artists,"
-                           "AlbumArtist = :albumArtist,"
-                           "Album = :album,"
-                           "DiscNumber = :discNumber,"
-                           "DiscTotal = :discTotal,"
-                           "Date = :date,"
-                           "Composer = :composer,"
-                           "Performer = :performer,"
-                           "Genres = :genres,"
-                           "Comment = :comment,"
-                           "CuePath = :cuePath,"
-                           "Offset = :offset,"
-                           "Duration = :duration,"
-                           "FileSize = :fileSize,"
-                           "BitRate = :bitRate,"
-                           "SampleRate = :sampleRate,"
-                           "Channels = :channels,"
-                           "BitDepth = :bitDepth,"
-                           "Codec = :codec,"
-                           "CodecProfile = :codecProfile,"
-                           "Tool = :tool,"
-                           "TagTypes = :tagTypes,"
-                           "Encoding = :encoding,"
-                           "ExtraTags = :extraTags,"
-                           "ExtraProperties = :extraProperties,"
-                           "ModifiedDate = :modifiedDate,"
-                           "TrackHash = :trackHash,"
-                           "LibraryID = :libraryID,"
-                           "RGTrackGain = :rgTrackGain,"
-                           "RGAlbumGain = :rgAlbumGain,"
-                           "RGTrackPeak = :rgTrackPeak,"
-                           "RGAlbumPeak = :rgAlbumPeak"
-                           " WHERE TrackID = :trackId;"_s;
+    DbTransaction transaction{db()};
 
-    DbQuery query{db(), statement};
+    if(!transaction) {
+        return false;
+    }
 
-    query.bindValue(u":trackId"_s, track.id());
+    DbQuery query{db(), updateTrackStatement()};
+
+    const int pos = bindTrack(query, 0, track);
+    query.bindValue(pos, track.id());
 
-    const auto bindings = trackBindings(track);
-    for(const auto& [name, value] : bindings) {
-        query.bindValue(name, value);
+    if(!query.exec()) {
+        return false;
     }
 
-    return query.exec();
+    bumpRevision();
+
+    return transaction.commit();
 }
 
 bool TrackDatabase::updateTrackStats(const Track& track)
 {
-    return insertOrUpdateStats(track);
+    return insertOrUpdateStats({track});
 }
 
 bool TrackDatabase::updateTrackStats(const TrackList& tracks)
 {
-    bool success{true};
-
     DbTransaction transaction{db()};
 
-    for(const Track& track : tracks) {
-        if(!insertOrUpdateStats(track)) {
-            success = false;
-        }
-    }
-
-    return success && transaction.commit();
+    return insertOrUpdateStats(tracks) && transaction.commit();
 }
 
 bool TrackDatabase::deleteTrack(int id)
 {
-    const QString statement = u"DELETE FROM Tracks WHERE TrackID = :trackID;"_s;
+    DbTransaction transaction{db()};
 
-    DbQuery query{db(), statement};
+    if(!transaction) {
+        return false;
+    }
 
-    query.bindValue(u":trackID"_s, id);
+    if(!deleteTrackRow(id)) {
+        return false;
+    }
 
-    return query.exec();
+    bumpRevision();
+
+    return transaction.commit();
 }
 
 bool TrackDatabase::deleteTracks(const TrackList& tracks)
@@ -443,8 +669,10 @@ bool TrackDatabase::deleteTracks(const TrackList& tracks)
         return false;
     }
 
-    const int fileCount = static_cast<int>(
-        std::count_if(tracks.cbegin(), tracks.cend(), [this](const Track& track) { return deleteTrack(track.id()); }));
+    const int fileCount = static_cast<int>(std::count_if(
+        tracks.cbegin(), tracks.cend(), [this](const Track& track) { return deleteTrackRow(track.id()); }));
+
+    bumpRevision();
 
     const auto success = transaction.commit();
 
@@ -496,6 +724,8 @@ std::set<int> TrackDatabase::deleteLibraryTracks(int libraryId)
         return {};
     }
 
+    bumpRevision();
+
     return tracksToRemove;
 }
 
@@ -587,192 +817,150 @@ int TrackDatabase::trackCount() const
     return -1;
 }
 
-bool TrackDatabase::insertTrack(Track& track) const
+void TrackDatabase::bumpRevision() const
 {
-    const auto statement = u"INSERT INTO Tracks ("
-                           "FilePath,"
-                           "Subsong,"
-                           "Title,"
-                           "TrackNumber,"
-                           "TrackTotal,"
-                           "Artists,"
-                           "AlbumArtist,"
-                           "Album,"
-                           "DiscNumber,"
-                           "DiscTotal,"
-                           "Date,"
-                           "Composer,"
-                           "Performer,"
-                           "Genres,"
-                           "Comment,"
-                           "CuePath,"
-                           "Offset,"
-                           "Duration,"
-                           "FileSize,"
-                           "BitRate,"
-                           "SampleRate,"
-                           "Channels,"
-                           "BitDepth,"
-                           "Codec,"
-                           "CodecProfile,"
-                           "Tool,"
-                           "TagTypes,"
-                           "Encoding,"
-                           "ExtraTags,"
-                           "ExtraProperties,"
-                           "ModifiedDate,"
-                           "TrackHash,"
-                           "LibraryID,"
-                           "RGTrackGain,"
-                           "RGAlbumGain,"
-                           "RGTrackPeak,"
-                           "RGAlbumPeak"
-                           ") "
-                           "VALUES ("
-                           ":filePath,"
-                           ":subsong,"
-                           ":title, "
-                           ":trackNumber,"
-                           ":trackTotal,"
-                           ":artists,"
-                           ":albumArtist,"
-                           ":album,"
-                           ":discNumber,"
-                           ":discTotal,"
-                           ":date, "
-                           ":composer,"
-                           ":performer,"
-                           ":genres,"
-                           ":comment,"
-                           ":cuePath,"
-                           ":offset,"
-                           ":duration,"
-                           ":fileSize,"
-                           ":bitRate,"
-                           ":sampleRate,"
-                           ":channels,"
-                           ":bitDepth,"
-                           ":codec,"
-                           ":codecProfile,"
-                           ":tool,"
-                           ":tagTypes,"
-                           ":encoding,"
-                           ":extraTags,"
-                           ":extraProperties,"
-                           ":modifiedDate,"
-                           ":trackHash,"
-                           ":libraryID,"
-                           ":rgTrackGain,"
-                           ":rgAlbumGain,"
-                           ":rgTrackPeak,"
-                           ":rgAlbumPeak"
-                           ");"_s;
+    const auto updateStatement = u"UPDATE Settings SET Value = CAST(Value AS INTEGER) + 1 WHERE Name = :name;"_s;
 
-    DbQuery query{db(), statement};
+    DbQuery updateQuery{db(), updateStatement};
+    updateQuery.bindValue(u":name"_s, QString::fromLatin1(RevisionSetting));
 
-    const auto bindings = trackBindings(track);
-    for(const auto& [name, value] : bindings) {
-        query.bindValue(name, value);
+    if(updateQuery.exec() && updateQuery.numRowsAffected() > 0) {
+        return;
     }
 
+    const auto insertStatement = u"INSERT OR REPLACE INTO Settings (Name, Value) VALUES (:name, 1);"_s;
+
+    DbQuery insertQuery{db(), insertStatement};
+    insertQuery.bindValue(u":name"_s, QString::fromLatin1(RevisionSetting));
+    insertQuery.exec();
+}
+
+bool TrackDatabase::deleteTrackRow(int id) const
+{
+    const QString statement = u"DELETE FROM Tracks WHERE TrackID = :trackID;"_s;
+
+    DbQuery query{db(), statement};
+
+    query.bindValue(u":trackID"_s, id);
+
+    return query.exec();
+}
+
+bool TrackDatabase::insertTrack(Track& track) const
+{
+    DbQuery query{db(), insertTracksStatement(1)};
+
+    bindTrack(query, 0, track);
+
     if(!query.exec()) {
         return false;
     }
 
     track.setId(query.lastInsertId().toInt());
 
-    return insertOrUpdateStats(track);
+    return true;
 }
 
-bool TrackDatabase::insertOrUpdateStats(const Track& track) const
+bool TrackDatabase::insertOrUpdateStats(const TrackList& tracks) const
 {
-    if(track.hash().isEmpty()) {
-        qCWarning(TRK_DB) << "Cannot insert/update track stats (Hash empty)";
-        return false;
+    std::vector<const Track*> validTracks;
+    for(const Track& track : tracks) {
+        if(track.hash().isEmpty()) {
+            qCWarning(TRK_DB) << "Cannot insert/update track stats (Hash empty)";
+            continue;
+        }
+        validTracks.push_back(&track);
     }
 
-    uint64_t added{0};
-    uint64_t firstPlayed{0};
-    uint64_t lastPlayed{0};
-    int playCount{0};
-    float rating{0};
+    if(validTracks.empty()) {
+        return validTracks.size() == tracks.size();
+    }
 
-    {
-        const auto statement = u"SELECT AddedDate, FirstPlayed, LastPlayed, PlayCount, Rating FROM "
-                               "TrackStats WHERE TrackHash = :trackHash;"_s;
+    std::unordered_map<QString, TrackStats> stats;
+
+    const auto total = static_cast<int>(validTracks.size());
+
+    for(int start{0}; start < total; start += MaxBoundValues) {
+        const int count = std::min(MaxBoundValues, total - start);
+
+        QStringList placeholders;
+        placeholders.reserve(count);
+        for(int i{0}; i < count; ++i) {
+            placeholders.append(u"?"_s);
+        }
+
+        const auto statement = u"SELECT TrackHash, AddedDate, FirstPlayed, LastPlayed, PlayCount, Rating FROM "
+                               "TrackStats WHERE TrackHash IN (%1);"_s.arg(placeholders.join(u","_s));
 
         DbQuery query{db(), statement};
 
-        query.bindValue(u":trackHash"_s, track.hash());
+        for(int i{0}; i < count; ++i) {
+            query.bindValue(i, validTracks.at(start + i)->hash());
+        }
 
         if(!query.exec()) {
             return false;
         }
 
-        if(query.next()) {
-            added       = query.value(0).toULongLong();
-            firstPlayed = query.value(1).toULongLong();
-            lastPlayed  = query.value(2).toULongLong();
-            playCount   = query.value(3).toInt();
-            rating      = query.value(4).toFloat();
+        while(query.next()) {
+            stats.emplace(query.value(0).toString(),
+                          TrackStats{.added       = query.value(1).toULongLong(),
+                                     .firstPlayed = query.value(2).toULongLong(),
+                                     .lastPlayed  = query.value(3).toULongLong(),
+                                     .playCount   = query.value(4).toInt(),
+                                     .rating      = query.value(5).toFloat()});
         }
     }
 
-    bool dbNeedsUpdate{false};
-
-    const uint64_t trackAdded       = track.addedTime();
-    const uint64_t trackFirstPlayed = track.firstPlayed();
-    const uint64_t trackLastPlayed  = track.lastPlayed();
-    const int trackPlayCount        = track.playCount();
-    const float trackRating         = track.rating();
+    std::vector<QString> changedHashes;
+    std::set<QString> seenHashes;
 
-    if(trackAdded != added) {
-        if(added == 0 || (trackAdded > 0 && trackAdded < added)) {
-            added         = trackAdded;
-            dbNeedsUpdate = true;
+    for(const Track* track : validTracks) {
+        if(mergeStats(*track, stats[track->hash()]) && seenHashes.emplace(track->hash()).second) {
+            changedHashes.push_back(track->hash());
         }
     }
-    if(trackFirstPlayed != firstPlayed) {
-        if(firstPlayed == 0 || (trackFirstPlayed > 0 && trackFirstPlayed < firstPlayed)) {
-            firstPlayed   = trackFirstPlayed;
-            dbNeedsUpdate = true;
-        }
-    }
-    if(trackLastPlayed != lastPlayed) {
-        if(trackLastPlayed > lastPlayed) {
-            lastPlayed    = trackLastPlayed;
-            dbNeedsUpdate = true;
-        }
-    }
-    if(trackPlayCount != playCount) {
-        if(trackPlayCount > playCount) {
-            playCount     = trackPlayCount;
-            dbNeedsUpdate = true;
-        }
-    }
-    if(trackRating != rating) {
-        rating        = trackRating;
-        dbNeedsUpdate = true;
-    }
 
-    if(!dbNeedsUpdate) {
-        return true;
+    if(changedHashes.empty()) {
+        return validTracks.size() == tracks.size();
     }
 
-    const auto statement = u"INSERT OR REPLACE INTO TrackStats (TrackHash, AddedDate, FirstPlayed, LastPlayed, "
-                           u"PlayCount, Rating) VALUES "
-                           "(:trackHash, :addedDate, :firstPlayed, :lastPlayed, :playCount, :rating);"_s;
+    bool success{true};
+    DbQuery batchQuery;
 
-    DbQuery query{db(), statement};
+    const auto changedCount = static_cast<int>(changedHashes.size());
 
-    query.bindValue(u":trackHash"_s, track.hash());
-    query.bindValue(u":addedDate"_s, QVariant::fromValue(added));
-    query.bindValue(u":firstPlayed"_s, QVariant::fromValue(firstPlayed));
-    query.bindValue(u":lastPlayed"_s, QVariant::fromValue(lastPlayed));
-    query.bindValue(u":playCount"_s, playCount);
-    query.bindValue(u":rating"_s, rating);
+    for(int start{0}; start < changedCount; start += StatsBatchSize) {
+        const int count = std::min(StatsBatchSize, changedCount - start);
 
-    return query.exec();
+        DbQuery remainderQuery;
+        DbQuery& query = count == StatsBatchSize ? batchQuery : remainderQuery;
+        if(query.status() == DbQuery::Status::None) {
+            const auto statement = u"INSERT OR REPLACE INTO TrackStats (TrackHash, AddedDate, FirstPlayed, "
+                                   "LastPlayed, PlayCount, Rating) VALUES %1;"_s.arg(
+                                       valuesPlaceholder(StatsColumnCount, count));
+            query = DbQuery{db(), statement};
+        }
+
+        int pos{0};
+        for(int i{0}; i < count; ++i) {
+            const QString& hash     = changedHashes.at(start + i);
+            const TrackStats& entry = stats.at(hash);
+
+            query.bindValue(pos++, hash);
+            query.bindValue(pos++, QVariant::fromValue(entry.added));
+            query.bindValue(pos++, QVariant::fromValue(entry.firstPlayed));
+            query.bindValue(pos++, QVariant::fromValue(entry.lastPlayed));
+            query.bindValue(pos++, entry.playCount);
+            query.bindValue(pos++, entry.rating);
+        }
+
+        if(!query.exec()) {
+            success = false;
+        }
+    }
+
+    return success && validTracks.size() == tracks.size();
 }
 
 void TrackDatabase::removeUnmanagedTracks() const
@@ -782,7 +970,9 @@ void TrackDatabase::removeUnmanagedTracks() const
 
     DbQuery query{db(), statement};
 
-    query.exec();
+    if(query.exec() && query.numRowsAffected() > 0) {
+        bumpRevision();
+    }
 }
 
 void TrackDatabase::updateLastSeenStats() const
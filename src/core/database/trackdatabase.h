@@ -27,12 +27,29 @@
 #include <set>
 
 namespace Fooyin {
+/*!
+ * Identifies the contents of the Tracks table.
+ * The revision is incremented on every write, so caches built from the table
+ * can be validated without reading it.
+ */
+struct TrackTableState
+{
+    uint64_t revision{0};
+    int count{0};
+    int maxId{-1};
+
+    bool operator==(const TrackTableState& other) const = default;
+};
+
 class FYCORE_EXPORT TrackDatabase : public DbModule
 {
 public:
     bool storeTracks(TrackList& tracks);
     bool updateTracks(TrackList& tracks);
 
+    [[nodiscard]] TrackTableState tableState() const;
+    bool loadTrackStats(TrackList& tracks) const;
+
     bool reloadTrack(Track& track) const;
     bool reloadTracks(TrackList& tracks) const;
     [[nodiscard]] TrackList getAllTracks() const;
@@ -54,8 +71,10 @@ public:
 
 private:
     [[nodiscard]] int trackCount() const;
+    void bumpRevision() const;
+    bool deleteTrackRow(int id) const;
     bool insertTrack(Track& track) const;
-    bool insertOrUpdateStats(const Track& track) const;
+    bool insertOrUpdateStats(const TrackList& tracks) const;
     void removeUnmanagedTracks() const;
     void updateLastSeenStats() const;
     void deleteExpiredStats() const;
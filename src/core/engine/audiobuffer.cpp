@@ -19,6 +19,8 @@
 
 #include <core/engine/audiobuffer.h>
 
+#include "audiokernels.h"
+
 #include <QDebug>
 #include <QLoggingCategory>
 
@@ -257,17 +259,23 @@ void AudioBuffer::scale(double volume)
             p->scale<uint8_t>(volume);
             break;
         case(SampleFormat::S16):
-            p->scale<int16_t>(volume);
+            Audio::Kernels::scaleS16(reinterpret_cast<int16_t*>(p->m_buffer.data()),
+                                     p->m_buffer.size() / sizeof(int16_t), static_cast<float>(volume));
             break;
         case(SampleFormat::S24):
-        case(SampleFormat::S32):
             p->scale<int32_t>(volume);
             break;
+        case(SampleFormat::S32):
+            Audio::Kernels::scaleS32(reinterpret_cast<int32_t*>(p->m_buffer.data()),
+                                     p->m_buffer.size() / sizeof(int32_t), volume);
+            break;
         case(SampleFormat::F32):
-            p->scale<float>(volume);
+            Audio::Kernels::scaleF32(reinterpret_cast<float*>(p->m_buffer.data()), p->m_buffer.size() / sizeof(float),
+                                     static_cast<float>(volume));
             break;
         case(SampleFormat::F64):
-            p->scale<double>(volume);
+            Audio::Kernels::scaleF64(reinterpret_cast<double*>(p->m_buffer.data()),
+                                     p->m_buffer.size() / sizeof(double), volume);
             break;
         case(SampleFormat::Unknown):
         default:
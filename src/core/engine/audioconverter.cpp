@@ -19,11 +19,14 @@
 
 #include <core/engine/audioconverter.h>
 
+#include "audiokernels.h"
+
 #include <core/engine/audiobuffer.h>
 #include <utils/fymath.h>
 
 #include <array>
 #include <cfenv>
+#include <cstring>
 
 namespace {
 using ChannelMap = std::array<int, 32>;
@@ -205,9 +208,57 @@ double convertDoubleToDouble(const double inSample)
     return inSample;
 }
 
+// Converts interleaved samples when the channel layout is unchanged using the vectorised kernels
+bool convertInterleaved(const Fooyin::AudioFormat& inFormat, const std::byte* input,
+                        const Fooyin::AudioFormat& outFormat, std::byte* output, int samples)
+{
+    using SampleFormat = Fooyin::SampleFormat;
+    namespace Kernels  = Fooyin::Audio::Kernels;
+
+    if(inFormat.channelCount() != outFormat.channelCount()) {
+        return false;
+    }
+
+    const auto count = static_cast<size_t>(samples) * static_cast<size_t>(outFormat.channelCount());
+
+    const SampleFormat inSampleFormat  = inFormat.sampleFormat();
+    const SampleFormat outSampleFormat = outFormat.sampleFormat();
+
+    if(inSampleFormat == outSampleFormat) {
+        std::memcpy(output, input, count * static_cast<size_t>(inFormat.bytesPerSample()));
+        return true;
+    }
+
+    const bool inS32  = inSampleFormat == SampleFormat::S24 || inSampleFormat == SampleFormat::S32;
+    const bool outS32 = outSampleFormat == SampleFormat::S24 || outSampleFormat == SampleFormat::S32;
+
+    if(inSampleFormat == SampleFormat::S16 && outSampleFormat == SampleFormat::F32) {
+        Kernels::convertS16ToF32(reinterpret_cast<const int16_t*>(input), reinterpret_cast<float*>(output), count);
+        return true;
+    }
+    if(inS32 && outSampleFormat == SampleFormat::F32) {
+        Kernels::convertS32ToF32(reinterpret_cast<const int32_t*>(input), reinterpret_cast<float*>(output), count);
+        return true;
+    }
+    if(inSampleFormat == SampleFormat::F32 && outSampleFormat == SampleFormat::S16) {
+        Kernels::convertF32ToS16(reinterpret_cast<const float*>(input), reinterpret_cast<int16_t*>(output), count);
+        return true;
+    }
+    if(inSampleFormat == SampleFormat::F32 && outS32) {
+        Kernels::convertF32ToS32(reinterpret_cast<const float*>(input), reinterpret_cast<int32_t*>(output), count);
+        return true;
+    }
+
+    return false;
+}
+
 bool convertFormat(const Fooyin::AudioFormat& inFormat, const std::byte* input, const Fooyin::AudioFormat& outFormat,
                    std::byte* output, int samples)
 {
+    if(convertInterleaved(inFormat, input, outFormat, output, samples)) {
+        return true;
+    }
+
     ChannelMap channels;
     std::iota(channels.begin(), channels.end(), -1);
 
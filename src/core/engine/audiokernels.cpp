@@ -0,0 +1,536 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "audiokernels.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FY_KERNELS_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(FY_KERNELS_SSE2) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FY_KERNELS_AVX2
+#include <immintrin.h>
+#define FY_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace {
+constexpr float S16Scale    = 32768.0F;
+constexpr float S16Max      = 32767.0F;
+constexpr float S32Scale    = 2147483648.0F;
+// Largest float below 2^31
+constexpr float S32FloatMax = 2147483520.0F;
+constexpr double S32Min     = -2147483648.0;
+constexpr double S32Max     = 2147483647.0;
+
+// Scalar kernels, also used for the tails of the vector kernels
+
+void scaleS16Scalar(int16_t* samples, size_t count, float gain)
+{
+    for(size_t i{0}; i < count; ++i) {
+        const float sample = std::clamp(static_cast<float>(samples[i]) * gain, -S16Scale, S16Max);
+        samples[i]         = static_cast<int16_t>(std::nearbyint(sample));
+    }
+}
+
+void scaleS32Scalar(int32_t* samples, size_t count, double gain)
+{
+    for(size_t i{0}; i < count; ++i) {
+        const double sample = std::clamp(static_cast<double>(samples[i]) * gain, S32Min, S32Max);
+        samples[i]          = static_cast<int32_t>(std::nearbyint(sample));
+    }
+}
+
+void scaleF32Scalar(float* samples, size_t count, float gain)
+{
+    for(size_t i{0}; i < count; ++i) {
+        samples[i] *= gain;
+    }
+}
+
+void scaleF64Scalar(double* samples, size_t count, double gain)
+{
+    for(size_t i{0}; i < count; ++i) {
+        samples[i] *= gain;
+    }
+}
+
+void convertS16ToF32Scalar(const int16_t* input, float* output, size_t count)
+{
+    for(size_t i{0}; i < count; ++i) {
+        output[i] = static_cast<float>(input[i]) * (1.0F / S16Scale);
+    }
+}
+
+void convertS32ToF32Scalar(const int32_t* input, float* output, size_t count)
+{
+    for(size_t i{0}; i < count; ++i) {
+        output[i] = static_cast<float>(input[i]) * (1.0F / S32Scale);
+    }
+}
+
+void convertF32ToS16Scalar(const float* input, int16_t* output, size_t count)
+{
+    for(size_t i{0}; i < count; ++i) {
+        const float sample = std::clamp(input[i] * S16Scale, -S16Scale, S16Max);
+        output[i]          = static_cast<int16_t>(std::nearbyint(sample));
+    }
+}
+
+void convertF32ToS32Scalar(const float* input, int32_t* output, size_t count)
+{
+    for(size_t i{0}; i < count; ++i) {
+        const float sample = std::clamp(input[i] * S32Scale, -S32Scale, S32FloatMax);
+        output[i]          = static_cast<int32_t>(std::nearbyint(sample));
+    }
+}
+
+#ifdef FY_KERNELS_SSE2
+// The float to int conversions below round using the current rounding mode, which defaults to nearest
+
+void loadS16x8(const int16_t* input, __m128& low, __m128& high)
+{
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input));
+    // Sign extend by shifting each 16 bit sample into the top of a 32 bit lane
+    low  = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16));
+    high = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16));
+}
+
+void storeS16x8(int16_t* output, __m128 low, __m128 high)
+{
+    const __m128i packed = _mm_packs_epi32(_mm_cvtps_epi32(low), _mm_cvtps_epi32(high));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output), packed);
+}
+
+void scaleS16Sse2(int16_t* samples, size_t count, float gain)
+{
+    const __m128 factor = _mm_set1_ps(gain);
+
+    size_t i{0};
+    for(; i + 8 <= count; i += 8) {
+        __m128 low;
+        __m128 high;
+        loadS16x8(samples + i, low, high);
+        storeS16x8(samples + i, _mm_mul_ps(low, factor), _mm_mul_ps(high, factor));
+    }
+
+    scaleS16Scalar(samples + i, count - i, gain);
+}
+
+__m128i scaleS32x2Sse2(__m128i samples, __m128d factor, __m128d minValue, __m128d maxValue)
+{
+    __m128d scaled = _mm_mul_pd(_mm_cvtepi32_pd(samples), factor);
+    scaled         = _mm_min_pd(_mm_max_pd(scaled, minValue), maxValue);
+    return _mm_cvtpd_epi32(scaled);
+}
+
+void scaleS32Sse2(int32_t* samples, size_t count, double gain)
+{
+    const __m128d factor   = _mm_set1_pd(gain);
+    const __m128d minValue = _mm_set1_pd(S32Min);
+    const __m128d maxValue = _mm_set1_pd(S32Max);
+
+    size_t i{0};
+    for(; i + 4 <= count; i += 4) {
+        const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + i));
+        const __m128i low   = scaleS32x2Sse2(input, factor, minValue, maxValue);
+        const __m128i high  = scaleS32x2Sse2(_mm_unpackhi_epi64(input, input), factor, minValue, maxValue);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(samples + i), _mm_unpacklo_epi64(low, high));
+    }
+
+    scaleS32Scalar(samples + i, count - i, gain);
+}
+
+void scaleF32Sse2(float* samples, size_t count, float gain)
+{
+    const __m128 factor = _mm_set1_ps(gain);
+
+    size_t i{0};
+    for(; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(samples + i, _mm_mul_ps(_mm_loadu_ps(samples + i), factor));
+    }
+
+    scaleF32Scalar(samples + i, count - i, gain);
+}
+
+void scaleF64Sse2(double* samples, size_t count, double gain)
+{
+    const __m128d factor = _mm_set1_pd(gain);
+
+    size_t i{0};
+    for(; i + 2 <= count; i += 2) {
+        _mm_storeu_pd(samples + i, _mm_mul_pd(_mm_loadu_pd(samples + i), factor));
+    }
+
+    scaleF64Scalar(samples + i, count - i, gain);
+}
+
+void convertS16ToF32Sse2(const int16_t* input, float* output, size_t count)
+{
+    const __m128 factor = _mm_set1_ps(1.0F / S16Scale);
+
+    size_t i{0};
+    for(; i + 8 <= count; i += 8) {
+        __m128 low;
+        __m128 high;
+        loadS16x8(input + i, low, high);
+        _mm_storeu_ps(output + i, _mm_mul_ps(low, factor));
+        _mm_storeu_ps(output + i + 4, _mm_mul_ps(high, factor));
+    }
+
+    convertS16ToF32Scalar(input + i, output + i, count - i);
+}
+
+void convertS32ToF32Sse2(const int32_t* input, float* output, size_t count)
+{
+    const __m128 factor = _mm_set1_ps(1.0F / S32Scale);
+
+    size_t i{0};
+    for(; i + 4 <= count; i += 4) {
+        const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        _mm_storeu_ps(output + i, _mm_mul_ps(_mm_cvtepi32_ps(samples), factor));
+    }
+
+    convertS32ToF32Scalar(input + i, output + i, count - i);
+}
+
+void convertF32ToS16Sse2(const float* input, int16_t* output, size_t count)
+{
+    const __m128 factor   = _mm_set1_ps(S16Scale);
+    const __m128 minValue = _mm_set1_ps(-S16Scale);
+    const __m128 maxValue = _mm_set1_ps(S16Max);
+
+    size_t i{0};
+    for(; i + 8 <= count; i += 8) {
+        __m128 low  = _mm_mul_ps(_mm_loadu_ps(input + i), factor);
+        __m128 high = _mm_mul_ps(_mm_loadu_ps(input + i + 4), factor);
+        low         = _mm_min_ps(_mm_max_ps(low, minValue), maxValue);
+        high        = _mm_min_ps(_mm_max_ps(high, minValue), maxValue);
+        storeS16x8(output + i, low, high);
+    }
+
+    convertF32ToS16Scalar(input + i, output + i, count - i);
+}
+
+void convertF32ToS32Sse2(const float* input, int32_t* output, size_t count)
+{
+    const __m128 factor   = _mm_set1_ps(S32Scale);
+    const __m128 minValue = _mm_set1_ps(-S32Scale);
+    const __m128 maxValue = _mm_set1_ps(S32FloatMax);
+
+    size_t i{0};
+    for(; i + 4 <= count; i += 4) {
+        __m128 samples = _mm_mul_ps(_mm_loadu_ps(input + i), factor);
+        samples        = _mm_min_ps(_mm_max_ps(samples, minValue), maxValue);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_cvtps_epi32(samples));
+    }
+
+    convertF32ToS32Scalar(input + i, output + i, count - i);
+}
+#endif
+
+#ifdef FY_KERNELS_AVX2
+FY_TARGET_AVX2 void scaleS16Avx2(int16_t* samples, size_t count, float gain)
+{
+    const __m256 factor = _mm256_set1_ps(gain);
+
+    size_t i{0};
+    for(; i + 8 <= count; i += 8) {
+        const __m128i input  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + i));
+        const __m256 scaled  = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(input)), factor);
+        const __m256i ints   = _mm256_cvtps_epi32(scaled);
+        const __m128i packed = _mm_packs_epi32(_mm256_castsi256_si128(ints), _mm256_extracti128_si256(ints, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(samples + i), packed);
+    }
+
+    scaleS16Scalar(samples + i, count - i, gain);
+}
+
+FY_TARGET_AVX2 void scaleS32Avx2(int32_t* samples, size_t count, double gain)
+{
+    const __m256d factor   = _mm256_set1_pd(gain);
+    const __m256d minValue = _mm256_set1_pd(S32Min);
+    const __m256d maxValue = _mm256_set1_pd(S32Max);
+
+    size_t i{0};
+    for(; i + 4 <= count; i += 4) {
+        const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + i));
+        __m256d scaled      = _mm256_mul_pd(_mm256_cvtepi32_pd(input), factor);
+        scaled              = _mm256_min_pd(_mm256_max_pd(scaled, minValue), maxValue);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(samples + i), _mm256_cvtpd_epi32(scaled));
+    }
+
+    scaleS32Scalar(samples + i, count - i, gain);
+}
+
+FY_TARGET_AVX2 void scaleF32Avx2(float* samples, size_t count, float gain)
+{
+    const __m256 factor = _mm256_set1_ps(gain);
+
+    size_t i{0};
+    for(; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(samples + i, _mm256_mul_ps(_mm256_loadu_ps(samples + i), factor));
+    }
+
+    scaleF32Scalar(samples + i, count - i, gain);
+}
+
+FY_TARGET_AVX2 void scaleF64Avx2(double* samples, size_t count, double gain)
+{
+    const __m256d factor = _mm256_set1_pd(gain);
+
+    size_t i{0};
+    for(; i + 4 <= count; i += 4) {
+        _mm256_storeu_pd(samples + i, _mm256_mul_pd(_mm256_loadu_pd(samples + i), factor));
+    }
+
+    scaleF64Scalar(samples + i, count - i, gain);
+}
+
+FY_TARGET_AVX2 void convertS16ToF32Avx2(const int16_t* input, float* output, size_t count)
+{
+    const __m256 factor = _mm256_set1_ps(1.0F / S16Scale);
+
+    size_t i{0};
+    for(; i + 8 <= count; i += 8) {
+        const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        _mm256_storeu_ps(output + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(samples)), factor));
+    }
+
+    convertS16ToF32Scalar(input + i, output + i, count - i);
+}
+
+FY_TARGET_AVX2 void convertS32ToF32Avx2(const int32_t* input, float* output, size_t count)
+{
+    const __m256 factor = _mm256_set1_ps(1.0F / S32Scale);
+
+    size_t i{0};
+    for(; i + 8 <= count; i += 8) {
+        const __m256i samples = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+        _mm256_storeu_ps(output + i, _mm256_mul_ps(_mm256_cvtepi32_ps(samples), factor));
+    }
+
+    convertS32ToF32Scalar(input + i, output + i, count - i);
+}
+
+FY_TARGET_AVX2 void convertF32ToS16Avx2(const float* input, int16_t* output, size_t count)
+{
+    const __m256 factor   = _mm256_set1_ps(S16Scale);
+    const __m256 minValue = _mm256_set1_ps(-S16Scale);
+    const __m256 maxValue = _mm256_set1_ps(S16Max);
+
+    size_t i{0};
+    for(; i + 8 <= count; i += 8) {
+        __m256 samples       = _mm256_mul_ps(_mm256_loadu_ps(input + i), factor);
+        samples              = _mm256_min_ps(_mm256_max_ps(samples, minValue), maxValue);
+        const __m256i ints   = _mm256_cvtps_epi32(samples);
+        const __m128i packed = _mm_packs_epi32(_mm256_castsi256_si128(ints), _mm256_extracti128_si256(ints, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), packed);
+    }
+
+    convertF32ToS16Scalar(input + i, output + i, count - i);
+}
+
+FY_TARGET_AVX2 void convertF32ToS32Avx2(const float* input, int32_t* output, size_t count)
+{
+    const __m256 factor   = _mm256_set1_ps(S32Scale);
+    const __m256 minValue = _mm256_set1_ps(-S32Scale);
+    const __m256 maxValue = _mm256_set1_ps(S32FloatMax);
+
+    size_t i{0};
+    for(; i + 8 <= count; i += 8) {
+        __m256 samples = _mm256_mul_ps(_mm256_loadu_ps(input + i), factor);
+        samples        = _mm256_min_ps(_mm256_max_ps(samples, minValue), maxValue);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), _mm256_cvtps_epi32(samples));
+    }
+
+    convertF32ToS32Scalar(input + i, output + i, count - i);
+}
+#endif
+
+Fooyin::Audio::Kernels::Isa findIsa()
+{
+    using Isa = Fooyin::Audio::Kernels::Isa;
+
+#ifdef FY_KERNELS_AVX2
+    if(__builtin_cpu_supports("avx2")) {
+        return Isa::AVX2;
+    }
+#endif
+#ifdef FY_KERNELS_SSE2
+    return Isa::SSE2;
+#else
+    return Isa::Scalar;
+#endif
+}
+} // namespace
+
+namespace Fooyin::Audio::Kernels {
+Isa detectedIsa()
+{
+    static const Isa isa = findIsa();
+    return isa;
+}
+
+void scaleS16(int16_t* samples, size_t count, float gain, Isa isa)
+{
+    switch(isa) {
+#ifdef FY_KERNELS_AVX2
+        case(Isa::AVX2):
+            scaleS16Avx2(samples, count, gain);
+            break;
+#endif
+#ifdef FY_KERNELS_SSE2
+        case(Isa::SSE2):
+            scaleS16Sse2(samples, count, gain);
+            break;
+#endif
+        default:
+            scaleS16Scalar(samples, count, gain);
+    }
+}
+
+void scaleS32(int32_t* samples, size_t count, double gain, Isa isa)
+{
+    switch(isa) {
+#ifdef FY_KERNELS_AVX2
+        case(Isa::AVX2):
+            scaleS32Avx2(samples, count, gain);
+            break;
+#endif
+#ifdef FY_KERNELS_SSE2
+        case(Isa::SSE2):
+            scaleS32Sse2(samples, count, gain);
+            break;
+#endif
+        default:
+            scaleS32Scalar(samples, count, gain);
+    }
+}
+
+void scaleF32(float* samples, size_t count, float gain, Isa isa)
+{
+    switch(isa) {
+#ifdef FY_KERNELS_AVX2
+        case(Isa::AVX2):
+            scaleF32Avx2(samples, count, gain);
+            break;
+#endif
+#ifdef FY_KERNELS_SSE2
+        case(Isa::SSE2):
+            scaleF32Sse2(samples, count, gain);
+            break;
+#endif
+        default:
+            scaleF32Scalar(samples, count, gain);
+    }
+}
+
+void scaleF64(double* samples, size_t count, double gain, Isa isa)
+{
+    switch(isa) {
+#ifdef FY_KERNELS_AVX2
+        case(Isa::AVX2):
+            scaleF64Avx2(samples, count, gain);
+            break;
+#endif
+#ifdef FY_KERNELS_SSE2
+        case(Isa::SSE2):
+            scaleF64Sse2(samples, count, gain);
+            break;
+#endif
+        default:
+            scaleF64Scalar(samples, count, gain);
+    }
+}
+
+void convertS16ToF32(const int16_t* input, float* output, size_t count, Isa isa)
+{
+    switch(isa) {
+#ifdef FY_KERNELS_AVX2
+        case(Isa::AVX2):
+            convertS16ToF32Avx2(input, output, count);
+            break;
+#endif
+#ifdef FY_KERNELS_SSE2
+        case(Isa::SSE2):
+            convertS16ToF32Sse2(input, output, count);
+            break;
+#endif
+        default:
+            convertS16ToF32Scalar(input, output, count);
+    }
+}
+
+void convertS32ToF32(const int32_t* input, float* output, size_t count, Isa isa)
+{
+    switch(isa) {
+#ifdef FY_KERNELS_AVX2
+        case(Isa::AVX2):
+            convertS32ToF32Avx2(input, output, count);
+            break;
+#endif
+#ifdef FY_KERNELS_SSE2
+        case(Isa::SSE2):
+            convertS32ToF32Sse2(input, output, count);
+            break;
+#endif
+        default:
+            convertS32ToF32Scalar(input, output, count);
+    }
+}
+
+void convertF32ToS16(const float* input, int16_t* output, size_t count, Isa isa)
+{
+    switch(isa) {
+#ifdef FY_KERNELS_AVX2
+        case(Isa::AVX2):
+            convertF32ToS16Avx2(input, output, count);
+            break;
+#endif
+#ifdef FY_KERNELS_SSE2
+        case(Isa::SSE2):
+            convertF32ToS16Sse2(input, output, count);
+            break;
+#endif
+        default:
+            convertF32ToS16Scalar(input, output, count);
+    }
+}
+
+void convertF32ToS32(const float* input, int32_t* output, size_t count, Isa isa)
+{
+    switch(isa) {
+#ifdef FY_KERNELS_AVX2
+        case(Isa::AVX2):
+            convertF32ToS32Avx2(input, output, count);
+            break;
+#endif
+#ifdef FY_KERNELS_SSE2
+        case(Isa::SSE2):
+            convertF32ToS32Sse2(input, output, count);
+            break;
+#endif
+        default:
+            convertF32ToS32Scalar(input, output, count);
+    }
+}
+} // namespace Fooyin::Audio::Kernels
@@ -0,0 +1,52 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include "fycore_export.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Fooyin::Audio::Kernels {
+/*!
+ * Instruction sets the sample kernels can be run with.
+ * Scalar is always available; the others depend on the build and the running CPU.
+ */
+enum class Isa : uint8_t
+{
+    Scalar = 0,
+    SSE2,
+    AVX2,
+};
+
+/** Returns the fastest instruction set supported by both the build and the running CPU. */
+FYCORE_EXPORT Isa detectedIsa();
+
+// Multiply each sample in place by @p gain, rounding and saturating integer formats
+FYCORE_EXPORT void scaleS16(int16_t* samples, size_t count, float gain, Isa isa = detectedIsa());
+FYCORE_EXPORT void scaleS32(int32_t* samples, size_t count, double gain, Isa isa = detectedIsa());
+FYCORE_EXPORT void scaleF32(float* samples, size_t count, float gain, Isa isa = detectedIsa());
+FYCORE_EXPORT void scaleF64(double* samples, size_t count, double gain, Isa isa = detectedIsa());
+
+// Convert @p count interleaved samples between formats, rounding to nearest and saturating integer output
+FYCORE_EXPORT void convertS16ToF32(const int16_t* input, float* output, size_t count, Isa isa = detectedIsa());
+FYCORE_EXPORT void convertS32ToF32(const int32_t* input, float* output, size_t count, Isa isa = detectedIsa());
+FYCORE_EXPORT void convertF32ToS16(const float* input, int16_t* output, size_t count, Isa isa = detectedIsa());
+FYCORE_EXPORT void convertF32ToS32(const float* input, int32_t* output, size_t count, Isa isa = detectedIsa());
+} // namespace Fooyin::Audio::Kernels
@@ -589,7 +589,8 @@ void AudioPlaybackEngine::resetWorkers(bool resetFade)
 {
     m_bufferTimer.stop();
     m_clock.setPaused(true);
-    QMetaObject::invokeMethod(&m_renderer, [this, resetFade]() { m_renderer.reset(resetFade); });
+    const uint32_t epoch = m_renderer.flushQueue();
+    QMetaObject::invokeMethod(&m_renderer, [this, resetFade, epoch]() { m_renderer.reset(resetFade, epoch); });
     m_totalBufferTime = 0;
 }
 
@@ -604,7 +605,8 @@ void AudioPlaybackEngine::stopWorkers(bool full)
 
     m_pendingSeek = {};
 
-    QMetaObject::invokeMethod(&m_renderer, &AudioRenderer::stop);
+    const uint32_t epoch = m_renderer.flushQueue();
+    QMetaObject::invokeMethod(&m_renderer, [this, epoch]() { m_renderer.stop(epoch); });
 
     if(full) {
         QMetaObject::invokeMethod(&m_renderer, &AudioRenderer::closeOutput);
@@ -726,7 +728,8 @@ bool AudioPlaybackEngine::checkReadyToDecode()
 
 void AudioPlaybackEngine::readNextBuffer()
 {
-    if(!m_decoder || m_totalBufferTime >= m_bufferLength) {
+    // Leave room for both a buffer and an end of track marker
+    if(!m_decoder || m_totalBufferTime >= m_bufferLength || m_renderer.queueSpace() < 2) {
         return;
     }
 
@@ -739,14 +742,14 @@ void AudioPlaybackEngine::readNextBuffer()
     if(buffer.isValid()) {
         m_totalBufferTime += buffer.duration();
         m_lastBufferEnd = buffer.endTime();
-        QMetaObject::invokeMethod(&m_renderer, [this, buffer]() { m_renderer.queueBuffer(buffer); });
+        m_renderer.queueBuffer(buffer);
     }
 
     const bool endOfCueTrack = (m_currentTrack.hasCue() && buffer.endTime() >= m_endPosition);
 
     if(!buffer.isValid() || endOfCueTrack) {
         m_bufferTimer.stop();
-        QMetaObject::invokeMethod(&m_renderer, [this]() { m_renderer.queueBuffer({}); });
+        m_renderer.queueEndOfTrack();
         m_ending = true;
         emit trackAboutToFinish();
     }
@@ -44,6 +44,8 @@ using namespace std::chrono_literals;
 using namespace Qt::StringLiterals;
 
 constexpr auto FadeInterval = 10;
+// Each decoded buffer is at most 100ms, so this comfortably covers the maximum buffer length
+constexpr auto BufferQueueSize = 1024;
 
 namespace {
 void alignBufferOffset(int& bufferOffset, int oldBps, int newBps)
@@ -63,6 +65,9 @@ AudioRenderer::AudioRenderer(SettingsManager* settings, QObject* parent)
     , m_gainScale{1.0}
     , m_bufferSize{0}
     , m_bufferPrefilled{false}
+    , m_bufferQueue{BufferQueueSize}
+    , m_producerEpoch{0}
+    , m_queueEpoch{0}
     , m_samplePos{0}
     , m_currentBufferOffset{0}
     , m_isRunning{false}
@@ -104,10 +109,6 @@ void AudioRenderer::init(const Track& track, const AudioFormat& format, bool for
         m_audioOutput->uninit();
     }
 
-    for(auto& buffer : m_bufferQueue) {
-        buffer = Audio::convert(buffer, m_format);
-    }
-
     const bool success = (isGapless && m_audioOutput->initialised() && resetResampler()) || initOutput();
 
     // Align offset in case format was changed
@@ -122,14 +123,14 @@ void AudioRenderer::start()
     m_writeTimer.start(m_writeInterval, Qt::PreciseTimer, this);
 }
 
-void AudioRenderer::stop()
+void AudioRenderer::stop(uint32_t epoch)
 {
     m_samplePos = 0;
     m_isRunning = false;
     m_writeTimer.stop();
 
     resetFade(0);
-    resetBuffer();
+    resetBuffer(epoch);
     m_fadeVolume = -1;
 }
 
@@ -149,13 +150,13 @@ void AudioRenderer::drainOutput()
     }
 }
 
-void AudioRenderer::reset(bool stopFade)
+void AudioRenderer::reset(bool stopFade, uint32_t epoch)
 {
     if(validOutputState()) {
         m_audioOutput->reset();
     }
 
-    resetBuffer();
+    resetBuffer(epoch);
 
     if(stopFade) {
         resetFade(0);
@@ -221,17 +222,28 @@ void AudioRenderer::pause(int fadeLength)
     m_fadeTimer.start(FadeInterval, this);
 }
 
-void AudioRenderer::queueBuffer(const AudioBuffer& buffer)
+size_t AudioRenderer::queueSpace() const
+{
+    return m_bufferQueue.freeSpace();
+}
+
+bool AudioRenderer::queueBuffer(const AudioBuffer& buffer)
 {
     if(!buffer.isValid()) {
-        m_bufferQueue.push_back(buffer);
-        return;
+        return false;
     }
+    return m_bufferQueue.push({.buffer = buffer, .epoch = m_producerEpoch});
+}
 
-    auto convertedBuffer = Audio::convert(buffer, m_format);
-    if(convertedBuffer.isValid()) {
-        m_bufferQueue.push_back(convertedBuffer);
-    }
+bool AudioRenderer::queueEndOfTrack()
+{
+    return m_bufferQueue.push({.epoch = m_producerEpoch, .endOfTrack = true});
+}
+
+uint32_t AudioRenderer::flushQueue()
+{
+    // Buffers queued before this point are discarded once the renderer is reset with the returned epoch
+    return ++m_producerEpoch;
 }
 
 bool AudioRenderer::resetResampler()
@@ -310,14 +322,33 @@ void AudioRenderer::timerEvent(QTimerEvent* event)
     QObject::timerEvent(event);
 }
 
-void AudioRenderer::resetBuffer()
+AudioRenderer::QueuedBuffer* AudioRenderer::nextBuffer()
+{
+    while(QueuedBuffer* queued = m_bufferQueue.front()) {
+        if(queued->epoch == m_queueEpoch) {
+            return queued;
+        }
+        if(static_cast<int32_t>(queued->epoch - m_queueEpoch) > 0) {
+            // Queued after a flush which we haven't been reset for yet
+            return nullptr;
+        }
+        m_bufferQueue.pop();
+    }
+
+    return nullptr;
+}
+
+void AudioRenderer::resetBuffer(uint32_t epoch)
 {
     m_bufferPrefilled        = false;
     m_samplePos              = 0;
     m_currentBufferOffset    = 0;
     m_currentBufferResampled = false;
-    m_bufferQueue            = {};
+    m_queueEpoch             = epoch;
     m_tempBuffer.reset();
+
+    // Drop anything queued before the flush
+    nextBuffer();
 }
 
 void AudioRenderer::resetFade(int length)
@@ -538,7 +569,7 @@ void AudioRenderer::writeNext()
         return;
     }
 
-    if(m_bufferQueue.empty()) {
+    if(!nextBuffer()) {
         qCDebug(RENDERER) << "Unable to write next buffer: Empty buffer queue";
         return;
     }
@@ -559,23 +590,37 @@ void AudioRenderer::writeNext()
 
 int AudioRenderer::writeAudioSamples(int samples)
 {
-    m_tempBuffer = {};
+    // Reuse the temporary buffer's allocation between writes
+    m_tempBuffer.clear();
+    bool hasTempData{false};
     int samplesBuffered{0};
 
-    while(m_isRunning && !m_bufferQueue.empty() && samplesBuffered < samples) {
-        AudioBuffer& buffer = m_bufferQueue.front();
+    while(m_isRunning && samplesBuffered < samples) {
+        QueuedBuffer* queued = nextBuffer();
+        if(!queued) {
+            break;
+        }
 
-        if(!buffer.isValid()) {
-            // End of file
+        if(queued->endOfTrack) {
             m_currentBufferOffset    = 0;
             m_currentBufferResampled = false;
-            m_bufferQueue.pop_front();
+            m_bufferQueue.pop();
             emit finished();
             return samplesBuffered;
         }
 
+        AudioBuffer& buffer = queued->buffer;
+
         if(!m_currentBufferResampled) {
             m_currentBufferResampled = true;
+
+            buffer = Audio::convert(buffer, m_format);
+            if(!buffer.isValid()) {
+                m_currentBufferResampled = false;
+                m_bufferQueue.pop();
+                continue;
+            }
+
             buffer.scale(m_gainScale);
 
             if(m_resampler) {
@@ -589,7 +634,7 @@ int AudioRenderer::writeAudioSamples(int samples)
             m_currentBufferOffset    = 0;
             m_currentBufferResampled = false;
             emit bufferProcessed(buffer);
-            m_bufferQueue.pop_front();
+            m_bufferQueue.pop();
             continue;
         }
 
@@ -598,23 +643,27 @@ int AudioRenderer::writeAudioSamples(int samples)
         const int bytes       = sampleCount * sstride;
         const auto fdata      = buffer.constData().subspan(m_currentBufferOffset, static_cast<size_t>(bytes));
 
-        if(!m_tempBuffer.isValid()) {
-            m_tempBuffer = {fdata, buffer.format(), buffer.startTime()};
-        }
-        else {
-            m_tempBuffer.append(fdata);
+        if(!hasTempData) {
+            hasTempData = true;
+            if(m_tempBuffer.isValid() && m_tempBuffer.format() == buffer.format()) {
+                m_tempBuffer.setStartTime(buffer.startTime());
+            }
+            else {
+                m_tempBuffer = {buffer.format(), buffer.startTime()};
+            }
         }
+        m_tempBuffer.append(fdata);
 
         samplesBuffered += sampleCount;
         m_currentBufferOffset += bytes;
     }
 
-    m_tempBuffer.fillRemainingWithSilence();
-
-    if(!m_tempBuffer.isValid()) {
+    if(!hasTempData) {
         return 0;
     }
 
+    m_tempBuffer.fillRemainingWithSilence();
+
     return samplesBuffered;
 }
 
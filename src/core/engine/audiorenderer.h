@@ -24,11 +24,12 @@
 
 #include "ffmpeg/ffmpegresampler.h"
 
+#include <core/engine/audiobuffer.h>
+#include <utils/spscqueue.h>
+
 #include <QBasicTimer>
 #include <QObject>
 
-#include <deque>
-
 namespace Fooyin {
 class AudioBuffer;
 class AudioFormat;
@@ -43,17 +44,21 @@ public:
 
     void init(const Track& track, const AudioFormat& format, bool forceReload = false);
     void start();
-    void stop();
+    void stop(uint32_t epoch);
     void closeOutput();
     void drainOutput();
-    void reset(bool stopFade);
+    void reset(bool stopFade, uint32_t epoch);
 
     void play();
     void play(int fadeLength);
     void pause();
     void pause(int fadeLength);
 
-    void queueBuffer(const AudioBuffer& buffer);
+    // Called from the decoding thread
+    [[nodiscard]] size_t queueSpace() const;
+    bool queueBuffer(const AudioBuffer& buffer);
+    bool queueEndOfTrack();
+    uint32_t flushQueue();
 
     bool resetResampler();
     void updateOutput(const OutputCreator& output, const QString& device);
@@ -74,7 +79,15 @@ protected:
     void timerEvent(QTimerEvent* event) override;
 
 private:
-    void resetBuffer();
+    struct QueuedBuffer
+    {
+        AudioBuffer buffer;
+        uint32_t epoch{0};
+        bool endOfTrack{false};
+    };
+
+    QueuedBuffer* nextBuffer();
+    void resetBuffer(uint32_t epoch);
     void resetFade(int length);
     void handleFading();
 
@@ -105,7 +118,9 @@ private:
     bool m_bufferPrefilled;
     std::unique_ptr<FFmpegResampler> m_resampler;
 
-    std::deque<AudioBuffer> m_bufferQueue;
+    SpscQueue<QueuedBuffer> m_bufferQueue;
+    uint32_t m_producerEpoch;
+    uint32_t m_queueEpoch;
     AudioBuffer m_tempBuffer;
     int m_samplePos;
     int m_currentBufferOffset;
@@ -21,6 +21,7 @@
 
 #include "ffmpegcodec.h"
 #include "ffmpegframe.h"
+#include "ffmpegseekindex.h"
 #include "ffmpegstream.h"
 #include "ffmpegutils.h"
 #include "internalcoresettings.h"
@@ -49,6 +50,8 @@ using namespace Qt::StringLiterals;
 
 constexpr AVRational TimeBaseAv = {1, AV_TIME_BASE};
 constexpr AVRational TimeBaseMs = {1, 1000};
+// Decoded before the seek target after an indexed seek, as MP3 frames can depend on previous ones
+constexpr uint64_t SeekIndexPrerollMs = 100;
 
 using namespace std::chrono_literals;
 
@@ -393,15 +396,18 @@ public:
     void reset();
     bool setup(const AudioSource& source);
     void checkIsVbr(const Track& track);
+    void setupSeekIndex(const Track& track);
 
     bool createCodec(AVStream* avStream);
 
     void decodeAudio(const PacketPtr& packet);
     [[nodiscard]] int sendAVPacket(const PacketPtr& packet) const;
     int receiveAVFrames();
+    [[nodiscard]] uint64_t currentPosition() const;
 
     void readNext();
     void seek(uint64_t pos);
+    bool seekIndexed(uint64_t pos);
 
     FFmpegDecoder* m_self;
 
@@ -419,30 +425,40 @@ public:
     bool m_isDecoding{false};
     bool m_isVbr{false};
     bool m_returnFrame{false};
+    bool m_useSeekIndex{false};
+    bool m_recordSeekIndex{false};
+    bool m_indexedSeek{false};
 
     AudioDecoder::DecoderOptions m_options;
     AudioBuffer m_buffer;
     Frame m_frame;
     int m_bufferPos{0};
     int64_t m_seekPos{0};
-    uint64_t m_currentPos{0};
+    // Counted in frames so positions derived from it don't accumulate rounding errors
+    uint64_t m_currentFrame{0};
     int m_bitrate{0};
     int m_skipBytes{0};
+    FFmpegSeekIndex m_seekIndex;
 };
 
 void FFmpegInputPrivate::reset()
 {
-    m_error      = false;
-    m_eof        = false;
-    m_isDecoding = false;
-    m_draining   = false;
-    m_isVbr      = false;
-    m_bitrate    = 0;
-    m_bufferPos  = 0;
-    m_currentPos = 0;
-    m_skipBytes  = 0;
+    m_error        = false;
+    m_eof          = false;
+    m_isDecoding   = false;
+    m_draining     = false;
+    m_isVbr        = false;
+    m_bitrate      = 0;
+    m_bufferPos    = 0;
+    m_currentFrame = 0;
+    m_skipBytes    = 0;
     m_buffer.clear();
 
+    m_useSeekIndex    = false;
+    m_recordSeekIndex = false;
+    m_indexedSeek     = false;
+    m_seekIndex       = {};
+
     m_context.reset();
     m_ioContext.reset();
     m_stream = {};
@@ -486,6 +502,35 @@ void FFmpegInputPrivate::checkIsVbr(const Track& track)
            || codec == AV_CODEC_ID_OPUS || codec == AV_CODEC_ID_VORBIS;
 }
 
+void FFmpegInputPrivate::setupSeekIndex(const Track& track)
+{
+    const FySettings settings;
+    if(!settings.value(Settings::Core::Internal::FFmpegSeekIndex, true).toBool()) {
+        return;
+    }
+
+    if(!m_isSeekable || track.hasCue() || m_audioFormat.sampleRate() <= 0) {
+        return;
+    }
+
+    // Only streams where a timestamp seek has to be estimated from the bitrate. APE keeps its own
+    // skip handling, as its demuxer can't recover from a byte seek.
+    const auto codec   = m_codec.context()->codec_id;
+    const bool vbrMp3  = codec == AV_CODEC_ID_MP3 && m_isVbr;
+    const bool rawAdts = codec == AV_CODEC_ID_AAC && QLatin1String{m_context->iformat->name} == "aac"_L1;
+    if(!vbrMp3 && !rawAdts) {
+        return;
+    }
+
+    m_seekIndex = FFmpegSeekIndex{track, m_audioFormat.sampleRate()};
+    if(!m_seekIndex.isValid()) {
+        return;
+    }
+
+    m_useSeekIndex    = true;
+    m_recordSeekIndex = !m_seekIndex.load();
+}
+
 bool FFmpegInputPrivate::createCodec(AVStream* avStream)
 {
     if(!avStream) {
@@ -598,7 +643,8 @@ int FFmpegInputPrivate::receiveAVFrames()
 
     if(!m_returnFrame) {
         const auto sampleCount   = m_audioFormat.bytesPerFrame() * m_frame.sampleCount();
-        const uint64_t startTime = m_codec.context()->codec_id == AV_CODEC_ID_APE ? m_currentPos : m_frame.ptsMs();
+        const uint64_t startTime
+            = m_indexedSeek || m_codec.context()->codec_id == AV_CODEC_ID_APE ? currentPosition() : m_frame.ptsMs();
 
         if(m_codec.isPlanar()) {
             m_buffer = {m_audioFormat, startTime};
@@ -610,7 +656,7 @@ int FFmpegInputPrivate::receiveAVFrames()
         }
 
         if(!(m_options & AudioDecoder::NoSeeking)) {
-            // Handle seeking of APE files
+            // Handle seeking of APE files and indexed seeks
             if(m_skipBytes > 0) {
                 const auto len = std::min(sampleCount, m_skipBytes);
                 m_skipBytes -= len;
@@ -625,12 +671,18 @@ int FFmpegInputPrivate::receiveAVFrames()
             }
         }
 
-        m_currentPos += m_audioFormat.durationForBytes(m_buffer.byteCount());
+        m_currentFrame += static_cast<uint64_t>(m_audioFormat.framesForBytes(m_buffer.byteCount()));
     }
 
     return result;
 }
 
+uint64_t FFmpegInputPrivate::currentPosition() const
+{
+    const auto sampleRate = static_cast<uint64_t>(m_audioFormat.sampleRate());
+    return sampleRate > 0 ? m_currentFrame * 1000 / sampleRate : 0;
+}
+
 void FFmpegInputPrivate::readNext()
 {
     if(!m_isDecoding) {
@@ -648,6 +700,14 @@ void FFmpegInputPrivate::readNext()
         if(readResult == AVERROR_EOF && !m_eof) {
             decodeAudio(packet);
             m_eof = true;
+
+            if(m_recordSeekIndex) {
+                m_recordSeekIndex = false;
+                m_seekIndex.finish();
+                if(!m_seekIndex.save()) {
+                    qCDebug(FFMPEG) << "Unable to save seek index";
+                }
+            }
         }
         else {
             receiveAVFrames();
@@ -675,6 +735,14 @@ void FFmpegInputPrivate::readNext()
         }
     }
 
+    if(m_recordSeekIndex && packet->pts != AV_NOPTS_VALUE) {
+        // Kept on the same timeline as frame timestamps, so positions match those of a regular seek
+        const auto frame = av_rescale_q(packet->pts, m_timeBase, {1, m_audioFormat.sampleRate()});
+        if(frame >= 0) {
+            m_seekIndex.addPacket(static_cast<uint64_t>(frame), packet->pos);
+        }
+    }
+
     if(m_seekPos > 0 && m_codec.context()->codec_id == AV_CODEC_ID_APE) {
         const auto packetPts = av_rescale_q_rnd(packet->pts, m_timeBase, TimeBaseMs, AVRounding::AV_ROUND_DOWN);
         m_skipBytes          = m_audioFormat.bytesForDuration(std::abs(m_seekPos - packetPts));
@@ -690,7 +758,17 @@ void FFmpegInputPrivate::seek(uint64_t pos)
         return;
     }
 
-    m_seekPos = static_cast<int64_t>(pos);
+    // Packet timestamps are only exact when read contiguously from the start of the stream
+    if(pos > 0) {
+        m_recordSeekIndex = false;
+    }
+
+    if(m_useSeekIndex && seekIndexed(pos)) {
+        return;
+    }
+
+    m_seekPos     = static_cast<int64_t>(pos);
+    m_indexedSeek = false;
 
     constexpr static auto min = std::numeric_limits<int64_t>::min();
     constexpr static auto max = std::numeric_limits<int64_t>::max();
@@ -702,12 +780,42 @@ void FFmpegInputPrivate::seek(uint64_t pos)
     }
     avcodec_flush_buffers(m_codec.context());
 
-    m_bufferPos  = 0;
-    m_buffer     = {};
-    m_eof        = false;
-    m_draining   = false;
-    m_skipBytes  = 0;
-    m_currentPos = pos;
+    m_bufferPos    = 0;
+    m_buffer       = {};
+    m_eof          = false;
+    m_draining     = false;
+    m_skipBytes    = 0;
+    m_currentFrame = static_cast<uint64_t>(m_audioFormat.framesForDuration(pos));
+}
+
+bool FFmpegInputPrivate::seekIndexed(uint64_t pos)
+{
+    const int target     = m_audioFormat.framesForDuration(pos);
+    const int preroll    = m_audioFormat.framesForDuration(std::min(pos, SeekIndexPrerollMs));
+    const auto seekEntry = m_seekIndex.find(static_cast<uint64_t>(target - preroll));
+    if(!seekEntry) {
+        return false;
+    }
+
+    if(av_seek_frame(m_context.get(), m_codec.streamIndex(), seekEntry->pos, AVSEEK_FLAG_BYTE) < 0) {
+        return false;
+    }
+    avcodec_flush_buffers(m_codec.context());
+
+    // Timestamps after a byte seek are unreliable, so track the position ourselves and trim the
+    // decoded output up to the requested sample
+    const auto entryFrame = static_cast<int>(seekEntry->frame);
+
+    m_bufferPos    = 0;
+    m_buffer       = {};
+    m_eof          = false;
+    m_draining     = false;
+    m_seekPos      = -1;
+    m_indexedSeek  = true;
+    m_skipBytes    = m_audioFormat.bytesForFrames(target - entryFrame);
+    m_currentFrame = static_cast<uint64_t>(target);
+
+    return true;
 }
 
 FFmpegDecoder::FFmpegDecoder()
@@ -733,6 +841,7 @@ std::optional<AudioFormat> FFmpegDecoder::init(const AudioSource& source, const
 
     if(p->setup(source)) {
         p->checkIsVbr(track);
+        p->setupSeekIndex(track);
         return p->m_audioFormat;
     }
 
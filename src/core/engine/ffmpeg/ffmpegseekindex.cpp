@@ -0,0 +1,250 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ffmpegseekindex.h"
+
+#include <core/track.h>
+#include <utils/crypto.h>
+#include <utils/fypaths.h>
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <mutex>
+#include <utility>
+
+using namespace Qt::StringLiterals;
+
+namespace {
+constexpr quint32 IndexMagic   = 0x46595349; // FYSI
+constexpr quint32 IndexVersion = 1;
+// Serialised size of each entry (frame and position)
+constexpr qint64 EntrySize = 16;
+// Spacing between entries
+constexpr uint64_t IntervalMs = 250;
+// Indexes unused for longer than this are removed, as are the least recently used beyond the size limit
+constexpr auto MaxUnusedDays  = 180;
+constexpr qint64 MaxCacheSize = 64LL * 1024 * 1024;
+
+QString indexDir()
+{
+    return Fooyin::Utils::cachePath(u"seekindex"_s);
+}
+} // namespace
+
+namespace Fooyin {
+FFmpegSeekIndex::FFmpegSeekIndex()
+    : m_fileSize{-1}
+    , m_fileModified{-1}
+    , m_sampleRate{0}
+    , m_interval{0}
+    , m_complete{false}
+{ }
+
+FFmpegSeekIndex::FFmpegSeekIndex(const Track& track, int sampleRate)
+    : m_hash{track.hash()}
+    , m_filepath{track.filepath()}
+    , m_fileSize{static_cast<int64_t>(track.fileSize())}
+    , m_fileModified{static_cast<int64_t>(track.modifiedTime())}
+    , m_sampleRate{sampleRate}
+    , m_interval{static_cast<uint64_t>(sampleRate) * IntervalMs / 1000}
+    , m_complete{false}
+{ }
+
+bool FFmpegSeekIndex::isValid() const
+{
+    return !m_hash.isEmpty() && m_sampleRate > 0;
+}
+
+bool FFmpegSeekIndex::isComplete() const
+{
+    return m_complete;
+}
+
+bool FFmpegSeekIndex::isEmpty() const
+{
+    return m_entries.empty();
+}
+
+bool FFmpegSeekIndex::load()
+{
+    m_complete = false;
+    m_entries.clear();
+
+    if(!isValid()) {
+        return false;
+    }
+
+    QFile file{indexPath()};
+    if(!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream stream{&file};
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic{0};
+    quint32 version{0};
+    QString filepath;
+    qint64 fileSize{0};
+    qint64 fileModified{0};
+    qint32 sampleRate{0};
+    quint32 count{0};
+
+    stream >> magic >> version >> filepath >> fileSize >> fileModified >> sampleRate >> count;
+
+    if(stream.status() != QDataStream::Ok || magic != IndexMagic || version != IndexVersion || filepath != m_filepath
+       || fileSize != m_fileSize || fileModified != m_fileModified || sampleRate != m_sampleRate) {
+        // Built from an older version of the file, so will never be used again
+        file.remove();
+        return false;
+    }
+
+    // Don't trust the count of a truncated or corrupt index
+    if(std::cmp_greater(count, (file.size() - file.pos()) / EntrySize)) {
+        file.remove();
+        return false;
+    }
+
+    m_entries.reserve(count);
+
+    for(quint32 i{0}; i < count; ++i) {
+        quint64 frame{0};
+        qint64 pos{0};
+        stream >> frame >> pos;
+        m_entries.push_back({frame, pos});
+    }
+
+    if(stream.status() != QDataStream::Ok) {
+        m_entries.clear();
+        return false;
+    }
+
+    m_complete = true;
+
+    // Marks the index as recently used for pruning
+    file.setFileTime(QDateTime::currentDateTimeUtc(), QFileDevice::FileModificationTime);
+
+    return true;
+}
+
+bool FFmpegSeekIndex::save()
+{
+    if(!isValid() || !m_complete) {
+        return false;
+    }
+
+    QSaveFile file{indexPath()};
+    if(!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    QDataStream stream{&file};
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    stream << IndexMagic << IndexVersion << m_filepath << static_cast<qint64>(m_fileSize)
+           << static_cast<qint64>(m_fileModified) << static_cast<qint32>(m_sampleRate)
+           << static_cast<quint32>(m_entries.size());
+
+    for(const auto& entry : m_entries) {
+        stream << static_cast<quint64>(entry.frame) << static_cast<qint64>(entry.pos);
+    }
+
+    if(stream.status() != QDataStream::Ok || !file.commit()) {
+        return false;
+    }
+
+    static std::once_flag pruned;
+    std::call_once(pruned, &FFmpegSeekIndex::prune);
+
+    return true;
+}
+
+void FFmpegSeekIndex::prune()
+{
+    const QDateTime oldest = QDateTime::currentDateTimeUtc().addDays(-MaxUnusedDays);
+
+    qint64 totalSize{0};
+    const QFileInfoList indexes = QDir{indexDir()}.entryInfoList({u"*.idx"_s}, QDir::Files, QDir::Time);
+
+    // Sorted by most recently used first
+    for(const QFileInfo& index : indexes) {
+        totalSize += index.size();
+        if(totalSize > MaxCacheSize || index.lastModified() < oldest) {
+            QFile::remove(index.absoluteFilePath());
+        }
+    }
+}
+
+void FFmpegSeekIndex::clear()
+{
+    m_complete = false;
+    m_entries.clear();
+}
+
+void FFmpegSeekIndex::addPacket(uint64_t frame, int64_t pos)
+{
+    if(m_complete || pos < 0) {
+        return;
+    }
+
+    if(!m_entries.empty()) {
+        const auto& last = m_entries.back();
+        if(frame < last.frame + m_interval || pos <= last.pos) {
+            return;
+        }
+    }
+
+    m_entries.push_back({frame, pos});
+}
+
+void FFmpegSeekIndex::finish()
+{
+    m_complete = !m_entries.empty();
+}
+
+std::optional<SeekIndexEntry> FFmpegSeekIndex::find(uint64_t frame) const
+{
+    if(m_entries.empty()) {
+        return {};
+    }
+
+    // An incomplete index only covers the part of the stream decoded so far
+    if(!m_complete && frame > m_entries.back().frame + m_interval) {
+        return {};
+    }
+
+    auto it = std::ranges::upper_bound(m_entries, frame, {}, &SeekIndexEntry::frame);
+    if(it == m_entries.cbegin()) {
+        return {};
+    }
+
+    return *std::prev(it);
+}
+
+QString FFmpegSeekIndex::indexPath() const
+{
+    // The metadata hash alone is shared by copies of a track in different files
+    return indexDir() + u'/' + Utils::generateHash(m_hash, m_filepath) + u".idx"_s;
+}
+} // namespace Fooyin
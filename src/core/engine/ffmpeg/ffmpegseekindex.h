@@ -0,0 +1,84 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "fycore_export.h"
+
+#include <QString>
+
+#include <optional>
+#include <vector>
+
+namespace Fooyin {
+class Track;
+
+struct SeekIndexEntry
+{
+    // Position of the first sample of the packet, in samples from the start of the stream
+    uint64_t frame{0};
+    // Byte offset of the packet in the file
+    int64_t pos{0};
+};
+
+/*!
+ * A persistent index of packet offsets for streams which FFmpeg can't seek accurately
+ * (VBR MP3 without a TOC, raw ADTS AAC).
+ *
+ * The index is recorded while a track is decoded from start to end, and is stored in the
+ * cache directory keyed by the track hash and path. It is only used while the path, size and
+ * modification time of the file match those it was built from. Indexes which haven't been used
+ * for a long time, or which exceed the cache size limit, are removed once per session.
+ */
+class FYCORE_EXPORT FFmpegSeekIndex
+{
+public:
+    FFmpegSeekIndex();
+    FFmpegSeekIndex(const Track& track, int sampleRate);
+
+    [[nodiscard]] bool isValid() const;
+    [[nodiscard]] bool isComplete() const;
+    [[nodiscard]] bool isEmpty() const;
+
+    bool load();
+    bool save();
+
+    void clear();
+    void addPacket(uint64_t frame, int64_t pos);
+    void finish();
+
+    /** Returns the last entry at or before @p frame, if the index covers it. */
+    [[nodiscard]] std::optional<SeekIndexEntry> find(uint64_t frame) const;
+
+    /** Removes unused and least recently used indexes from the cache. */
+    static void prune();
+
+private:
+    [[nodiscard]] QString indexPath() const;
+
+    QString m_hash;
+    QString m_filepath;
+    int64_t m_fileSize;
+    int64_t m_fileModified;
+    int m_sampleRate;
+    uint64_t m_interval;
+    bool m_complete;
+    std::vector<SeekIndexEntry> m_entries;
+};
+} // namespace Fooyin
@@ -81,9 +81,12 @@ constexpr auto SaveActivePlaylistState = "Playlist/SaveActivePlaylistState";
 constexpr auto SavePlaybackState       = "Player/SavePlaybackState";
 constexpr auto LibraryRestrictTypes    = "Library/RestrictTypes";
 constexpr auto LibraryExcludeTypes     = "Library/ExcludeTypes";
+constexpr auto LibraryScanThreads      = "Library/ScanThreads";
+constexpr auto LibrarySkipUnchanged    = "Library/SkipUnchangedDirectories";
 constexpr auto ExternalRestrictTypes   = "Library/ExternalRestrictTypes";
 constexpr auto ExternalExcludeTypes    = "Library/ExternalExcludeTypes";
 constexpr auto FFmpegAllExtensions     = "Engine/FFmpegAllExtensions";
+constexpr auto FFmpegSeekIndex         = "Engine/FFmpegSeekIndex";
 
 enum CoreInternalSettings : uint32_t
 {
@@ -0,0 +1,251 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "directorymanifest.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+
+#ifdef Q_OS_UNIX
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+#include <optional>
+#include <ranges>
+#include <set>
+
+namespace {
+// Entries added within the timestamp granularity of a directory may not change its modification time,
+// so recently modified directories are always listed again on the next walk
+constexpr int64_t RacyInterval = 2'000'000'000;
+
+QString parentPath(const QString& path)
+{
+    return path.left(path.lastIndexOf(u'/'));
+}
+
+#ifdef Q_OS_UNIX
+using DirId = std::pair<dev_t, ino_t>;
+
+struct DirStat
+{
+    int64_t modifiedTime{0};
+    DirId id;
+};
+
+std::optional<DirStat> statDir(const QString& dir)
+{
+    struct stat st{};
+    if(::stat(QFile::encodeName(dir).constData(), &st) != 0 || !S_ISDIR(st.st_mode)) {
+        return {};
+    }
+
+#ifdef Q_OS_MACOS
+    const auto& mtime = st.st_mtimespec;
+#else
+    const auto& mtime = st.st_mtim;
+#endif
+
+    return DirStat{.modifiedTime = (static_cast<int64_t>(mtime.tv_sec) * 1'000'000'000) + mtime.tv_nsec,
+                   .id           = {st.st_dev, st.st_ino}};
+}
+
+// Reads entries directly so only candidate files, symlinks and filesystems without entry types need a stat.
+// Empty files are skipped as in a full scan.
+template <typename Accept, typename Func>
+void readDir(const QString& dir, Accept&& acceptFile, Func&& func)
+{
+    DIR* handle = ::opendir(QFile::encodeName(dir).constData());
+    if(!handle) {
+        return;
+    }
+
+    const int fd = ::dirfd(handle);
+
+    while(const dirent* entry = ::readdir(handle)) {
+        // Also skips '.' and '..'
+        if(entry->d_name[0] == '.') {
+            continue;
+        }
+
+        const QString name = QFile::decodeName(entry->d_name);
+
+        if(entry->d_type == DT_DIR) {
+            func(name, true);
+            continue;
+        }
+
+        if(entry->d_type != DT_REG && entry->d_type != DT_LNK && entry->d_type != DT_UNKNOWN) {
+            continue;
+        }
+
+        if(entry->d_type == DT_REG && !acceptFile(name)) {
+            continue;
+        }
+
+        struct stat st{};
+        if(::fstatat(fd, entry->d_name, &st, 0) != 0) {
+            continue;
+        }
+
+        if(S_ISDIR(st.st_mode)) {
+            func(name, true);
+        }
+        else if(S_ISREG(st.st_mode) && st.st_size > 0 && acceptFile(name)) {
+            func(name, false);
+        }
+    }
+
+    ::closedir(handle);
+}
+#else
+using DirId = QString;
+
+struct DirStat
+{
+    int64_t modifiedTime{0};
+    DirId id;
+};
+
+std::optional<DirStat> statDir(const QString& dir)
+{
+    const QFileInfo info{dir};
+    if(!info.isDir()) {
+        return {};
+    }
+
+    return DirStat{.modifiedTime = info.lastModified().toMSecsSinceEpoch() * 1'000'000,
+                   .id           = info.canonicalFilePath()};
+}
+
+template <typename Accept, typename Func>
+void readDir(const QString& dir, Accept&& acceptFile, Func&& func)
+{
+    const QFileInfoList entries = QDir{dir}.entryInfoList(QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot);
+    for(const QFileInfo& entry : entries) {
+        if(entry.isDir()) {
+            func(entry.fileName(), true);
+        }
+        else if(entry.size() > 0 && acceptFile(entry.fileName())) {
+            func(entry.fileName(), false);
+        }
+    }
+}
+#endif
+} // namespace
+
+namespace Fooyin {
+DirectoryManifest::DirectoryManifest(DirectoryDatabase::Directories previous, QStringList extensions)
+    : m_previous{std::move(previous)}
+    , m_extensions{std::move(extensions)}
+    , m_unchangedFiles{0}
+{
+    for(const auto& dir : m_previous | std::views::keys) {
+        m_previousChildren[parentPath(dir)].append(dir);
+    }
+}
+
+void DirectoryManifest::walk(const QString& root)
+{
+    const int64_t now = QDateTime::currentMSecsSinceEpoch() * 1'000'000;
+
+    std::set<DirId> visited;
+    std::vector<QString> pending{root};
+
+    while(!pending.empty()) {
+        const QString dir = std::move(pending.back());
+        pending.pop_back();
+
+        const auto dirStat = statDir(dir);
+        // Symlinks are followed, so guard against loops
+        if(!dirStat || !visited.emplace(dirStat->id).second) {
+            continue;
+        }
+
+        if(const auto prevIt = m_previous.find(dir);
+           prevIt != m_previous.cend() && prevIt->second.modifiedTime != 0
+           && prevIt->second.modifiedTime == dirStat->modifiedTime) {
+            m_directories.emplace(dir, prevIt->second);
+            m_unchanged.emplace(dir);
+            m_unchangedFiles += prevIt->second.fileCount;
+
+            if(const auto childIt = m_previousChildren.find(dir); childIt != m_previousChildren.cend()) {
+                pending.insert(pending.end(), childIt->second.cbegin(), childIt->second.cend());
+            }
+            continue;
+        }
+
+        int fileCount{0};
+
+        const auto acceptFile = [this](const QString& name) {
+            return isLibraryFile(name);
+        };
+        readDir(dir, acceptFile, [this, &dir, &pending, &fileCount](const QString& name, bool isDir) {
+            const QString path = dir + u'/' + name;
+            if(isDir) {
+                pending.push_back(path);
+            }
+            else {
+                m_files.emplace_back(path);
+                ++fileCount;
+            }
+        });
+
+        const int64_t modifiedTime = now - dirStat->modifiedTime < RacyInterval ? 0 : dirStat->modifiedTime;
+        m_directories.emplace(dir, DirectoryDatabase::Directory{modifiedTime, fileCount});
+    }
+}
+
+QFileInfoList DirectoryManifest::files() const
+{
+    return m_files;
+}
+
+bool DirectoryManifest::isUnchanged(const QString& dir) const
+{
+    return m_unchanged.contains(dir);
+}
+
+size_t DirectoryManifest::unchangedDirCount() const
+{
+    return m_unchanged.size();
+}
+
+int DirectoryManifest::unchangedFileCount() const
+{
+    return m_unchangedFiles;
+}
+
+const DirectoryDatabase::Directories& DirectoryManifest::directories() const
+{
+    return m_directories;
+}
+
+bool DirectoryManifest::isLibraryFile(const QString& filename) const
+{
+    const auto dotIndex = filename.lastIndexOf(u'.');
+    if(dotIndex < 0) {
+        return false;
+    }
+
+    return m_extensions.contains(QStringView{filename}.sliced(dotIndex + 1), Qt::CaseInsensitive);
+}
+} // namespace Fooyin
@@ -0,0 +1,66 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "database/directorydatabase.h"
+
+#include <QFileInfoList>
+#include <QStringList>
+
+#include <unordered_set>
+
+namespace Fooyin {
+/*!
+ * Walks a library directory, only listing directories which have changed since the previous walk.
+ *
+ * A directory's modification time changes whenever an entry is added, removed or renamed directly
+ * within it, so an unchanged directory only costs a single stat, and its files and known
+ * subdirectories are taken from the previous walk. Files rewritten in place don't change it.
+ */
+class DirectoryManifest
+{
+public:
+    DirectoryManifest(DirectoryDatabase::Directories previous, QStringList extensions);
+
+    void walk(const QString& root);
+
+    /** Returns the files found in directories which were listed. */
+    [[nodiscard]] QFileInfoList files() const;
+    /** Returns true if @p dir was found unchanged, so it still contains the same files. */
+    [[nodiscard]] bool isUnchanged(const QString& dir) const;
+    [[nodiscard]] size_t unchangedDirCount() const;
+    [[nodiscard]] int unchangedFileCount() const;
+
+    /** Returns every directory found, to be compared against on the next walk. */
+    [[nodiscard]] const DirectoryDatabase::Directories& directories() const;
+
+private:
+    [[nodiscard]] bool isLibraryFile(const QString& filename) const;
+
+    DirectoryDatabase::Directories m_previous;
+    std::unordered_map<QString, QStringList> m_previousChildren;
+    QStringList m_extensions;
+
+    DirectoryDatabase::Directories m_directories;
+    std::unordered_set<QString> m_unchanged;
+    QFileInfoList m_files;
+    int m_unchangedFiles;
+};
+} // namespace Fooyin
@@ -0,0 +1,361 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "inotifywatcher.h"
+
+#include <utils/crypto.h>
+#include <utils/fileutils.h>
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QLoggingCategory>
+#include <QSocketNotifier>
+#include <QTimerEvent>
+
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <ranges>
+
+Q_LOGGING_CATEGORY(LIB_WATCHER, "fy.watcher")
+
+using namespace std::chrono_literals;
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
+constexpr auto MoveInterval  = 100ms;
+constexpr auto SweepInterval = 5min;
+#else
+constexpr auto MoveInterval  = 100;
+constexpr auto SweepInterval = 300000;
+#endif
+
+constexpr uint32_t WatchMask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF
+                             | IN_MOVE_SELF | IN_ONLYDIR | IN_EXCL_UNLINK;
+
+namespace {
+bool isUnder(const QString& path, const QString& dir)
+{
+    return path.size() > dir.size() && path.startsWith(dir) && path.at(dir.size()) == u'/';
+}
+
+QString replacePrefix(const QString& path, const QString& from, const QString& to)
+{
+    return to + path.sliced(from.size());
+}
+
+QByteArray dirSignature(const QString& dir)
+{
+    // Changes whenever an entry is added, removed or renamed, or a file is rewritten in place
+    Fooyin::Utils::KeyHasher hash;
+
+    const QFileInfoList entries
+        = QDir{dir}.entryInfoList(QDir::AllEntries | QDir::Hidden | QDir::NoDotAndDotDot, QDir::Name);
+    for(const QFileInfo& entry : entries) {
+        hash.addData(entry.fileName());
+        hash.addData(static_cast<uint64_t>(entry.lastModified().toMSecsSinceEpoch()));
+        hash.addData(static_cast<uint64_t>(entry.size()));
+    }
+
+    return hash.result();
+}
+} // namespace
+
+namespace Fooyin {
+InotifyWatcher::InotifyWatcher(QObject* parent)
+    : QObject{parent}
+    , m_fd{inotify_init1(IN_NONBLOCK | IN_CLOEXEC)}
+    , m_notifier{nullptr}
+    , m_limitReached{false}
+{
+    if(m_fd < 0) {
+        qCWarning(LIB_WATCHER) << "Failed to initialise inotify:" << qt_error_string(errno);
+        return;
+    }
+
+    m_notifier = new QSocketNotifier(m_fd, QSocketNotifier::Read, this);
+    QObject::connect(m_notifier, &QSocketNotifier::activated, this, &InotifyWatcher::readEvents);
+}
+
+InotifyWatcher::~InotifyWatcher()
+{
+    if(m_fd >= 0) {
+        ::close(m_fd);
+    }
+}
+
+bool InotifyWatcher::isValid() const
+{
+    return m_fd >= 0;
+}
+
+void InotifyWatcher::addPath(const QString& path)
+{
+    if(!isValid() || m_roots.contains(path)) {
+        return;
+    }
+
+    m_roots.append(path);
+    addWatches(path);
+}
+
+void InotifyWatcher::timerEvent(QTimerEvent* event)
+{
+    if(event->timerId() == m_moveTimer.timerId()) {
+        m_moveTimer.stop();
+        flushMoves();
+    }
+    else if(event->timerId() == m_sweepTimer.timerId()) {
+        sweep();
+    }
+    QObject::timerEvent(event);
+}
+
+bool InotifyWatcher::addWatch(const QString& dir)
+{
+    if(m_limitReached) {
+        return false;
+    }
+
+    const int wd = inotify_add_watch(m_fd, QFile::encodeName(dir).constData(), WatchMask);
+    if(wd < 0) {
+        if(errno == ENOSPC) {
+            qCWarning(LIB_WATCHER) << "inotify watch limit reached after" << m_watches.size()
+                                   << "directories; remaining directories will be checked periodically";
+            m_limitReached = true;
+        }
+        return false;
+    }
+
+    m_watches[wd] = dir;
+    m_unwatched.erase(dir);
+
+    return true;
+}
+
+void InotifyWatcher::addWatches(const QString& path)
+{
+    QStringList dirs = Utils::File::getAllSubdirectories(path);
+    dirs.prepend(path);
+
+    for(const QString& dir : dirs) {
+        if(!addWatch(dir) && m_limitReached && !m_unwatched.contains(dir)) {
+            m_unwatched.emplace(dir, dirSignature(dir));
+        }
+    }
+
+    if(!m_unwatched.empty() && !m_sweepTimer.isActive()) {
+        m_sweepTimer.start(SweepInterval, this);
+    }
+}
+
+void InotifyWatcher::removeWatches(const QString& path)
+{
+    std::erase_if(m_watches, [this, &path](const auto& watch) {
+        if(watch.second == path || isUnder(watch.second, path)) {
+            inotify_rm_watch(m_fd, watch.first);
+            return true;
+        }
+        return false;
+    });
+    std::erase_if(m_unwatched,
+                  [&path](const auto& dir) { return dir.first == path || isUnder(dir.first, path); });
+}
+
+void InotifyWatcher::renameWatches(const QString& from, const QString& to)
+{
+    // Watches follow the directory, so only the paths need updating
+    for(auto& dir : m_watches | std::views::values) {
+        if(dir == from || isUnder(dir, from)) {
+            dir = replacePrefix(dir, from, to);
+        }
+    }
+
+    std::unordered_map<QString, QByteArray> unwatched;
+    for(auto& [dir, signature] : m_unwatched) {
+        if(dir == from || isUnder(dir, from)) {
+            unwatched.emplace(replacePrefix(dir, from, to), std::move(signature));
+        }
+        else {
+            unwatched.emplace(dir, std::move(signature));
+        }
+    }
+    m_unwatched = std::move(unwatched);
+}
+
+void InotifyWatcher::readEvents()
+{
+    alignas(inotify_event) std::array<char, 16384> buffer;
+
+    while(true) {
+        const ssize_t length = ::read(m_fd, buffer.data(), buffer.size());
+        if(length <= 0) {
+            break;
+        }
+
+        for(ssize_t pos{0}; pos < length;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer.data() + pos);
+            const QString name = event->len > 0 ? QFile::decodeName(event->name) : QString{};
+            handleEvent(event->wd, event->mask, event->cookie, name);
+            pos += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+        }
+    }
+
+    if(!m_pendingMoves.empty()) {
+        // The other half of a move may not have been read yet
+        m_moveTimer.start(MoveInterval, this);
+    }
+}
+
+void InotifyWatcher::handleEvent(int wd, uint32_t mask, uint32_t cookie, const QString& name)
+{
+    if(mask & IN_Q_OVERFLOW) {
+        qCInfo(LIB_WATCHER) << "inotify event queue overflowed; rescanning libraries";
+        for(const QString& root : std::as_const(m_roots)) {
+            addWatches(root);
+            emit dirChanged(root);
+        }
+        return;
+    }
+
+    const auto watchIt = m_watches.find(wd);
+    if(watchIt == m_watches.cend()) {
+        return;
+    }
+
+    const QString dir = watchIt->second;
+
+    if(mask & IN_IGNORED) {
+        m_watches.erase(watchIt);
+        return;
+    }
+
+    if(mask & (IN_DELETE_SELF | IN_MOVE_SELF)) {
+        // Anything below a root is reported by its parent directory
+        if(m_roots.contains(dir)) {
+            emit fileRemoved(dir);
+        }
+        return;
+    }
+
+    const QString path = dir + u'/' + name;
+    const bool isDir   = (mask & IN_ISDIR) != 0;
+
+    if(mask & IN_CREATE) {
+        // New files are reported once written and closed
+        if(isDir) {
+            addWatches(path);
+            emit dirChanged(path);
+        }
+    }
+    else if(mask & IN_CLOSE_WRITE) {
+        emit fileChanged(path);
+    }
+    else if(mask & IN_DELETE) {
+        emit fileRemoved(path);
+    }
+    else if(mask & IN_MOVED_FROM) {
+        m_pendingMoves[cookie] = {.path = path, .isDir = isDir};
+    }
+    else if(mask & IN_MOVED_TO) {
+        movedTo(path, cookie, isDir);
+    }
+}
+
+void InotifyWatcher::movedTo(const QString& path, uint32_t cookie, bool isDir)
+{
+    const auto moveIt = m_pendingMoves.find(cookie);
+
+    if(moveIt == m_pendingMoves.cend()) {
+        // Moved in from outside of the watched directories
+        if(isDir) {
+            addWatches(path);
+            emit dirChanged(path);
+        }
+        else {
+            emit fileChanged(path);
+        }
+        return;
+    }
+
+    const QString from = moveIt->second.path;
+    m_pendingMoves.erase(moveIt);
+
+    if(isDir) {
+        renameWatches(from, path);
+    }
+    emit fileMoved(from, path);
+}
+
+void InotifyWatcher::flushMoves()
+{
+    // Anything left was moved out of the watched directories
+    for(const auto& move : m_pendingMoves | std::views::values) {
+        if(move.isDir) {
+            removeWatches(move.path);
+        }
+        emit fileRemoved(move.path);
+    }
+    m_pendingMoves.clear();
+}
+
+void InotifyWatcher::sweep()
+{
+    // Watches may have been freed since the limit was reached
+    m_limitReached = false;
+
+    QStringList dirs;
+    dirs.reserve(static_cast<qsizetype>(m_unwatched.size()));
+    for(const auto& dir : m_unwatched | std::views::keys) {
+        dirs.append(dir);
+    }
+
+    for(const QString& dir : std::as_const(dirs)) {
+        const auto dirIt = m_unwatched.find(dir);
+        if(dirIt == m_unwatched.end()) {
+            continue;
+        }
+
+        if(!QFileInfo::exists(dir)) {
+            m_unwatched.erase(dirIt);
+            continue;
+        }
+
+        const QByteArray signature = dirSignature(dir);
+        if(signature == dirIt->second) {
+            addWatch(dir);
+            continue;
+        }
+
+        dirIt->second = signature;
+        // Picks up any new subdirectories
+        addWatches(dir);
+        emit dirChanged(dir);
+    }
+
+    if(m_unwatched.empty()) {
+        qCInfo(LIB_WATCHER) << "All library directories are now watched";
+        m_sweepTimer.stop();
+    }
+}
+} // namespace Fooyin
+
+#include "moc_inotifywatcher.cpp"
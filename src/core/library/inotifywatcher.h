@@ -0,0 +1,88 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <QBasicTimer>
+#include <QObject>
+#include <QStringList>
+
+#include <unordered_map>
+
+class QSocketNotifier;
+
+namespace Fooyin {
+/*!
+ * Recursively watches directories using inotify, reporting changes per file.
+ *
+ * Paired move events are reported as moves so tracks can be relocated without re-reading tags.
+ * If the watch limit is reached, directories which couldn't be watched are checked periodically
+ * for changes instead.
+ */
+class InotifyWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit InotifyWatcher(QObject* parent = nullptr);
+    ~InotifyWatcher() override;
+
+    [[nodiscard]] bool isValid() const;
+
+    void addPath(const QString& path);
+
+signals:
+    void fileChanged(const QString& path);
+    void fileRemoved(const QString& path);
+    void fileMoved(const QString& from, const QString& to);
+    void dirChanged(const QString& path);
+
+protected:
+    void timerEvent(QTimerEvent* event) override;
+
+private:
+    struct PendingMove
+    {
+        QString path;
+        bool isDir{false};
+    };
+
+    bool addWatch(const QString& dir);
+    void addWatches(const QString& path);
+    void removeWatches(const QString& path);
+    void renameWatches(const QString& from, const QString& to);
+
+    void readEvents();
+    void handleEvent(int wd, uint32_t mask, uint32_t cookie, const QString& name);
+    void movedTo(const QString& path, uint32_t cookie, bool isDir);
+    void flushMoves();
+    void sweep();
+
+    int m_fd;
+    QSocketNotifier* m_notifier;
+    QStringList m_roots;
+    std::unordered_map<int, QString> m_watches;
+    std::unordered_map<uint32_t, PendingMove> m_pendingMoves;
+    QBasicTimer m_moveTimer;
+
+    bool m_limitReached;
+    std::unordered_map<QString, QByteArray> m_unwatched;
+    QBasicTimer m_sweepTimer;
+};
+} // namespace Fooyin
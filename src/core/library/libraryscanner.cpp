@@ -19,7 +19,9 @@
 
 #include "libraryscanner.h"
 
+#include "database/directorydatabase.h"
 #include "database/trackdatabase.h"
+#include "directorymanifest.h"
 #include "internalcoresettings.h"
 #include "librarywatcher.h"
 #include "playlist/playlistloader.h"
@@ -29,6 +31,7 @@
 #include <core/playlist/playlist.h>
 #include <core/playlist/playlistparser.h>
 #include <core/track.h>
+#include <utils/crypto.h>
 #include <utils/database/dbconnectionhandler.h>
 #include <utils/database/dbconnectionpool.h>
 #include <utils/fileutils.h>
@@ -39,10 +42,13 @@
 #include <QBuffer>
 #include <QDir>
 #include <QDirIterator>
-#include <QFileSystemWatcher>
 #include <QLoggingCategory>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrentMap>
 
 #include <ranges>
+#include <unordered_set>
 
 Q_LOGGING_CATEGORY(LIB_SCANNER, "fy.scanner")
 
@@ -52,6 +58,20 @@ constexpr auto BatchSize   = 250;
 constexpr auto ArchivePath = R"(unpack://%1|%2|file://%3!)";
 
 namespace {
+bool isUnder(const QString& path, const QString& dir)
+{
+    return path.size() > dir.size() && path.startsWith(dir) && path.at(dir.size()) == u'/';
+}
+
+void logStoreRate(const char* action, size_t count, const Fooyin::Timer& timer)
+{
+    const auto elapsedMs     = std::max<int64_t>(timer.elapsed().count(), 1);
+    const auto rowsPerSecond = static_cast<double>(count) * 1000.0 / static_cast<double>(elapsedMs);
+
+    qCDebug(LIB_SCANNER) << action << count << "tracks in" << timer.elapsedFormatted() << "-" << qRound(rowsPerSecond)
+                         << "rows/s";
+}
+
 void sortFiles(QFileInfoList& files)
 {
     std::ranges::sort(files, {}, &QFileInfo::filePath);
@@ -157,6 +177,24 @@ void readFileProperties(Fooyin::Track& track)
 } // namespace
 
 namespace Fooyin {
+struct ScannedFile
+{
+    enum class Action : uint8_t
+    {
+        Skip = 0,
+        ReadCue,
+        UpdateTrack,
+        AddTracks,
+        UpdateArchive,
+        AddArchive,
+    };
+
+    QString filepath;
+    Action action{Action::Skip};
+    std::optional<uint64_t> modifiedTime;
+    TrackList tracks;
+};
+
 class LibraryScannerPrivate
 {
 public:
@@ -180,10 +218,15 @@ public:
 
     Track matchMissingTrack(const Track& track);
 
+    void storeTracks(TrackList& tracks);
+    void updateTracks(TrackList& tracks);
     void checkBatchFinished();
     void removeMissingTrack(const Track& track);
+    void markMissing(const QStringList& paths);
+    bool moveTracks(const QString& from, const QString& to);
 
     [[nodiscard]] TrackList readTracks(const QString& filepath);
+    [[nodiscard]] TrackList readFileTracks(const QString& filepath) const;
     [[nodiscard]] TrackList readArchiveTracks(const QString& filepath);
     [[nodiscard]] TrackList readPlaylist(const QString& filepath);
     [[nodiscard]] TrackList readPlaylistTracks(const QString& filepath);
@@ -197,11 +240,22 @@ public:
     void setTrackProps(Track& track, const QString& file);
 
     void updateExistingTrack(Track& track, const QString& file);
+    void addNewTracks(TrackList& tracks, const QString& file);
     void readNewTrack(const QString& file);
 
+    void scanFile(ScannedFile& scanned, bool onlyModified) const;
+    void processScannedFile(ScannedFile& scanned, bool onlyModified);
     void readFile(const QString& file, bool onlyModified);
-    void populateExistingTracks(const TrackList& tracks, bool includeMissing = true);
+    bool readFiles(const QFileInfoList& files, bool onlyModified);
+    bool readFilesParallel(const QFileInfoList& files, bool onlyModified);
+    void populateExistingTracks(const TrackList& tracks, bool includeMissing = true,
+                                const DirectoryManifest* manifest = nullptr);
+    [[nodiscard]] std::pair<QStringList, QStringList> libraryFileTypes() const;
+    bool readAndSavePaths(const QStringList& paths, bool onlyModified);
+    bool readAndSaveFiles(const QFileInfoList& files, bool onlyModified);
     bool getAndSaveAllTracks(const QStringList& paths, const TrackList& tracks, bool onlyModified);
+    bool getAndSaveLibraryTracks(const TrackList& tracks, bool onlyModified);
+    bool getAndSaveChangedTracks(const LibraryChanges& changes, const TrackList& tracks);
 
     void changeLibraryStatus(LibraryInfo::Status status);
 
@@ -213,10 +267,12 @@ public:
     std::shared_ptr<AudioLoader> m_audioLoader;
 
     std::unique_ptr<DbConnectionHandler> m_dbHandler;
+    QThreadPool m_readerPool;
 
     bool m_monitor{false};
     LibraryInfo m_currentLibrary;
     TrackDatabase m_trackDatabase;
+    DirectoryDatabase m_directoryDatabase;
 
     TrackList m_tracksToStore;
     TrackList m_tracksToUpdate;
@@ -232,7 +288,7 @@ public:
     std::set<QString> m_filesScanned;
     size_t m_totalFiles{0};
 
-    std::unordered_map<int, LibraryWatcher> m_watchers;
+    std::unordered_map<int, std::unique_ptr<LibraryWatcher>> m_watchers;
 };
 
 void LibraryScannerPrivate::finishScan()
@@ -263,19 +319,11 @@ void LibraryScannerPrivate::cleanupScan()
 
 void LibraryScannerPrivate::addWatcher(const LibraryInfo& library)
 {
-    auto watchPaths = [this, library](const QString& path) {
-        QStringList dirs = Utils::File::getAllSubdirectories(path);
-        dirs.append(path);
-        m_watchers[library.id].addPaths(dirs);
-    };
-
-    watchPaths(library.path);
+    auto& watcher = m_watchers[library.id];
+    watcher       = std::make_unique<LibraryWatcher>(library.path);
 
-    QObject::connect(&m_watchers.at(library.id), &LibraryWatcher::libraryDirsChanged, m_self,
-                     [this, watchPaths, library](const QStringList& dirs) {
-                         std::ranges::for_each(dirs, watchPaths);
-                         emit m_self->directoriesChanged(library, dirs);
-                     });
+    QObject::connect(watcher.get(), &LibraryWatcher::libraryChanged, m_self,
+                     [this, library](const LibraryChanges& changes) { emit m_self->libraryChanged(library, changes); });
 }
 
 void LibraryScannerPrivate::reportProgress(const QString& file) const
@@ -309,14 +357,36 @@ Track LibraryScannerPrivate::matchMissingTrack(const Track& track)
     return {};
 }
 
+void LibraryScannerPrivate::storeTracks(TrackList& tracks)
+{
+    if(tracks.empty()) {
+        return;
+    }
+
+    const Timer timer;
+    m_trackDatabase.storeTracks(tracks);
+    logStoreRate("Stored", tracks.size(), timer);
+}
+
+void LibraryScannerPrivate::updateTracks(TrackList& tracks)
+{
+    if(tracks.empty()) {
+        return;
+    }
+
+    const Timer timer;
+    m_trackDatabase.updateTracks(tracks);
+    logStoreRate("Updated", tracks.size(), timer);
+}
+
 void LibraryScannerPrivate::checkBatchFinished()
 {
     if(m_tracksToStore.size() >= BatchSize || m_tracksToUpdate.size() > BatchSize) {
         if(m_tracksToStore.size() >= BatchSize) {
-            m_trackDatabase.storeTracks(m_tracksToStore);
+            storeTracks(m_tracksToStore);
         }
         if(m_tracksToUpdate.size() >= BatchSize) {
-            m_trackDatabase.updateTracks(m_tracksToUpdate);
+            updateTracks(m_tracksToUpdate);
         }
         emit m_self->scanUpdate({.addedTracks = m_tracksToStore, .updatedTracks = m_tracksToUpdate});
         m_tracksToStore.clear();
@@ -336,12 +406,128 @@ void LibraryScannerPrivate::removeMissingTrack(const Track& track)
     }
 }
 
+void LibraryScannerPrivate::markMissing(const QStringList& paths)
+{
+    // Tracks are disabled if they're still missing once any changed files have been read
+    const auto addMissing = [this](const QString& file, const TrackList& tracks) {
+        if(!QFileInfo::exists(file)) {
+            for(const Track& track : tracks) {
+                m_missingFiles[track.filename()].push_back(track);
+                m_missingHashes.emplace(track.hash(), track);
+            }
+        }
+    };
+
+    std::unordered_set<QString> dirs;
+
+    for(const QString& path : paths) {
+        if(const auto tracksIt = m_trackPaths.find(path); tracksIt != m_trackPaths.cend()) {
+            addMissing(path, tracksIt->second);
+        }
+        else {
+            dirs.emplace(path);
+        }
+    }
+
+    if(dirs.empty()) {
+        return;
+    }
+
+    // Look up each file and its parent directories, so the library is only walked once however many paths changed
+    const auto isChanged = [&dirs](const QString& file) {
+        if(dirs.contains(file)) {
+            return true;
+        }
+        for(qsizetype slash = file.lastIndexOf(u'/'); slash > 0; slash = file.lastIndexOf(u'/', slash - 1)) {
+            if(dirs.contains(file.first(slash))) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    for(const auto& [file, tracks] : m_trackPaths) {
+        if(isChanged(file)) {
+            addMissing(file, tracks);
+        }
+    }
+    for(const auto& [archive, tracks] : m_existingArchives) {
+        if(isChanged(archive)) {
+            addMissing(archive, tracks);
+        }
+    }
+}
+
+bool LibraryScannerPrivate::moveTracks(const QString& from, const QString& to)
+{
+    // Updates the paths of moved tracks without re-reading their tags.
+    // Returns false if the move needs to be handled as a removal and a new file.
+
+    const auto isSimpleTrack = [](const Track& track) {
+        return !track.hasCue() && !track.isInArchive();
+    };
+
+    std::vector<QString> paths;
+
+    if(const auto tracksIt = m_trackPaths.find(from); tracksIt != m_trackPaths.cend()) {
+        const bool sameType = QFileInfo{from}.suffix().compare(QFileInfo{to}.suffix(), Qt::CaseInsensitive) == 0;
+        if(!sameType || m_trackPaths.contains(to) || !std::ranges::all_of(tracksIt->second, isSimpleTrack)) {
+            return false;
+        }
+        paths.push_back(from);
+    }
+    else {
+        const auto isMovedArchive = [&from](const QString& archive) {
+            return isUnder(archive, from);
+        };
+        if(std::ranges::any_of(m_existingArchives | std::views::keys, isMovedArchive)) {
+            return false;
+        }
+
+        for(const auto& [file, tracks] : m_trackPaths) {
+            if(isUnder(file, from)) {
+                if(!std::ranges::all_of(tracks, isSimpleTrack)) {
+                    return false;
+                }
+                paths.push_back(file);
+            }
+        }
+    }
+
+    if(paths.empty()) {
+        return false;
+    }
+
+    for(const QString& path : paths) {
+        auto node           = m_trackPaths.extract(path);
+        const QString moved = path == from ? to : to + path.sliced(from.size());
+
+        for(Track& track : node.mapped()) {
+            qCDebug(LIB_SCANNER) << "Track moved:" << track.filepath() << "->" << moved;
+
+            track.setFilePath(moved);
+            track.generateHash();
+            m_tracksToUpdate.push_back(track);
+        }
+
+        node.key() = moved;
+        m_trackPaths.insert(std::move(node));
+    }
+
+    return true;
+}
+
 TrackList LibraryScannerPrivate::readTracks(const QString& filepath)
 {
     if(m_audioLoader->isArchive(filepath)) {
         return readArchiveTracks(filepath);
     }
 
+    return readFileTracks(filepath);
+}
+
+TrackList LibraryScannerPrivate::readFileTracks(const QString& filepath) const
+{
     auto tagReader = m_audioLoader->readerForFile(filepath);
     if(!tagReader) {
         return {};
@@ -683,15 +869,8 @@ void LibraryScannerPrivate::updateExistingTrack(Track& track, const QString& fil
     }
 }
 
-void LibraryScannerPrivate::readNewTrack(const QString& file)
+void LibraryScannerPrivate::addNewTracks(TrackList& tracks, const QString& file)
 {
-    qCDebug(LIB_SCANNER) << "Indexing new file:" << file;
-
-    TrackList tracks = readTracks(file);
-    if(tracks.empty()) {
-        return;
-    }
-
     for(Track& track : tracks) {
         Track refoundTrack = matchMissingTrack(track);
         if(refoundTrack.isInLibrary() || refoundTrack.isInDatabase()) {
@@ -719,9 +898,24 @@ void LibraryScannerPrivate::readNewTrack(const QString& file)
     }
 }
 
-void LibraryScannerPrivate::readFile(const QString& file, bool onlyModified)
+void LibraryScannerPrivate::readNewTrack(const QString& file)
 {
-    if(!m_self->mayRun()) {
+    qCDebug(LIB_SCANNER) << "Indexing new file:" << file;
+
+    TrackList tracks = readTracks(file);
+    if(!tracks.empty()) {
+        addNewTracks(tracks, file);
+    }
+}
+
+void LibraryScannerPrivate::scanFile(ScannedFile& scanned, bool onlyModified) const
+{
+    // Only reads from the scanner state, so this can be called from multiple reader threads at once
+
+    const QString& file = scanned.filepath;
+
+    if(file.endsWith(".cue"_L1)) {
+        scanned.action = ScannedFile::Action::ReadCue;
         return;
     }
 
@@ -735,78 +929,193 @@ void LibraryScannerPrivate::readFile(const QString& file, bool onlyModified)
 
     if(lastModifiedTime.isValid()) {
         lastModified = static_cast<uint64_t>(lastModifiedTime.toMSecsSinceEpoch());
+        scanned.modifiedTime = lastModified;
     }
 
+    const auto requiresUpdate = [this, lastModified, onlyModified](const Track& libraryTrack) {
+        return !libraryTrack.isEnabled() || libraryTrack.libraryId() != m_currentLibrary.id
+            || libraryTrack.modifiedTime() < lastModified || !onlyModified;
+    };
+
     if(m_trackPaths.contains(file)) {
         const Track& libraryTrack = m_trackPaths.at(file).front();
 
-        if(!libraryTrack.isEnabled() || libraryTrack.libraryId() != m_currentLibrary.id
-           || libraryTrack.modifiedTime() < lastModified || !onlyModified) {
+        if(requiresUpdate(libraryTrack)) {
             Track changedTrack{libraryTrack};
-            if(!m_audioLoader->readTrackMetadata(changedTrack)) {
-                return;
-            }
-
-            if(lastModifiedTime.isValid()) {
-                changedTrack.setModifiedTime(lastModified);
+            if(m_audioLoader->readTrackMetadata(changedTrack)) {
+                scanned.action = ScannedFile::Action::UpdateTrack;
+                scanned.tracks.push_back(changedTrack);
             }
-
-            updateExistingTrack(changedTrack, file);
         }
     }
     else if(m_existingArchives.contains(file)) {
-        const Track& libraryTrack = m_existingArchives.at(file).front();
+        // Archive entries report their own progress, so they're read when processed
+        if(requiresUpdate(m_existingArchives.at(file).front())) {
+            scanned.action = ScannedFile::Action::UpdateArchive;
+        }
+    }
+    else if(m_audioLoader->isArchive(file)) {
+        scanned.action = ScannedFile::Action::AddArchive;
+    }
+    else {
+        qCDebug(LIB_SCANNER) << "Indexing new file:" << file;
+
+        scanned.tracks = readFileTracks(file);
+        if(!scanned.tracks.empty()) {
+            scanned.action = ScannedFile::Action::AddTracks;
+        }
+    }
+}
+
+void LibraryScannerPrivate::processScannedFile(ScannedFile& scanned, bool onlyModified)
+{
+    const QString& file = scanned.filepath;
 
-        if(!libraryTrack.isEnabled() || libraryTrack.libraryId() != m_currentLibrary.id
-           || libraryTrack.modifiedTime() < lastModified || !onlyModified) {
+    // A cue sheet processed after this file was scanned may have claimed it
+    if(scanned.action != ScannedFile::Action::ReadCue && m_cueFilesScanned.contains(file)) {
+        return;
+    }
+
+    switch(scanned.action) {
+        case(ScannedFile::Action::ReadCue):
+            readCue(file, onlyModified);
+            break;
+        case(ScannedFile::Action::UpdateTrack): {
+            Track& changedTrack = scanned.tracks.front();
+            if(scanned.modifiedTime) {
+                changedTrack.setModifiedTime(scanned.modifiedTime.value());
+            }
+            updateExistingTrack(changedTrack, file);
+            break;
+        }
+        case(ScannedFile::Action::AddTracks):
+            addNewTracks(scanned.tracks, file);
+            break;
+        case(ScannedFile::Action::UpdateArchive): {
             TrackList tracks = readArchiveTracks(file);
             for(Track& track : tracks) {
                 updateExistingTrack(track, track.filepath());
             }
+            break;
         }
+        case(ScannedFile::Action::AddArchive):
+            readNewTrack(file);
+            break;
+        case(ScannedFile::Action::Skip):
+            break;
     }
-    else {
-        readNewTrack(file);
+}
+
+void LibraryScannerPrivate::readFile(const QString& file, bool onlyModified)
+{
+    if(!m_self->mayRun()) {
+        return;
+    }
+
+    ScannedFile scanned{.filepath = file};
+    scanFile(scanned, onlyModified);
+    processScannedFile(scanned, onlyModified);
+}
+
+bool LibraryScannerPrivate::readFiles(const QFileInfoList& files, bool onlyModified)
+{
+    for(const auto& file : files) {
+        if(!m_self->mayRun()) {
+            return false;
+        }
+
+        const QString filepath = file.absoluteFilePath();
+
+        if(file.suffix() == "cue"_L1) {
+            readCue(filepath, onlyModified);
+        }
+        else {
+            readFile(filepath, onlyModified);
+        }
+
+        fileScanned(filepath);
+        checkBatchFinished();
     }
+
+    return true;
 }
 
-void LibraryScannerPrivate::populateExistingTracks(const TrackList& tracks, bool includeMissing)
+bool LibraryScannerPrivate::readFilesParallel(const QFileInfoList& files, bool onlyModified)
 {
+    // Tags for each batch are read concurrently by the reader pool, then the results are applied in order
+    // on the scanner thread. This keeps progress reporting and database writes on a single thread.
+
+    std::vector<ScannedFile> pending;
+    pending.reserve(BatchSize);
+
+    auto fileIt = files.cbegin();
+
+    while(fileIt != files.cend()) {
+        if(!m_self->mayRun()) {
+            return false;
+        }
+
+        pending.clear();
+        for(; fileIt != files.cend() && std::cmp_less(pending.size(), BatchSize); ++fileIt) {
+            pending.push_back({.filepath = fileIt->absoluteFilePath()});
+        }
+
+        QtConcurrent::blockingMap(&m_readerPool, pending, [this, onlyModified](ScannedFile& scanned) {
+            if(m_self->mayRun()) {
+                scanFile(scanned, onlyModified);
+            }
+        });
+
+        for(ScannedFile& scanned : pending) {
+            if(!m_self->mayRun()) {
+                return false;
+            }
+
+            processScannedFile(scanned, onlyModified);
+            fileScanned(scanned.filepath);
+            checkBatchFinished();
+        }
+    }
+
+    return true;
+}
+
+void LibraryScannerPrivate::populateExistingTracks(const TrackList& tracks, bool includeMissing,
+                                                   const DirectoryManifest* manifest)
+{
+    // Files can't have gone missing from a directory whose entries haven't changed, and tracks
+    // from other libraries are left to the scans of those libraries
+    const auto isMissing = [this, manifest](const Track& track, const QString& path) {
+        if(manifest
+           && (track.libraryId() != m_currentLibrary.id || manifest->isUnchanged(path.left(path.lastIndexOf(u'/'))))) {
+            return false;
+        }
+        return !QFileInfo::exists(path);
+    };
+
     for(const Track& track : tracks) {
         m_trackPaths[track.filepath()].push_back(track);
         if(track.isInArchive()) {
             m_existingArchives[track.archivePath()].push_back(track);
         }
 
-        if(includeMissing) {
-            if(track.hasCue()) {
-                const auto cuePath = track.hasEmbeddedCue() ? track.filepath() : track.cuePath();
-                m_existingCueTracks[cuePath].emplace_back(track);
-                if(!QFileInfo::exists(cuePath)) {
-                    m_missingCueTracks[cuePath].emplace_back(track);
-                }
+        if(track.hasCue()) {
+            const auto cuePath = track.hasEmbeddedCue() ? track.filepath() : track.cuePath();
+            m_existingCueTracks[cuePath].emplace_back(track);
+            if(includeMissing && isMissing(track, cuePath)) {
+                m_missingCueTracks[cuePath].emplace_back(track);
             }
+        }
 
-            if(!track.isInArchive()) {
-                if(!QFileInfo::exists(track.filepath())) {
-                    m_missingFiles[track.filename()].push_back(track);
-                    m_missingHashes.emplace(track.hash(), track);
-                }
-            }
-            else {
-                if(!QFileInfo::exists(track.archivePath())) {
-                    m_missingFiles[track.filename()].push_back(track);
-                    m_missingHashes.emplace(track.hash(), track);
-                }
-            }
+        if(includeMissing && isMissing(track, track.isInArchive() ? track.archivePath() : track.filepath())) {
+            m_missingFiles[track.filename()].push_back(track);
+            m_missingHashes.emplace(track.hash(), track);
         }
     }
 }
 
-bool LibraryScannerPrivate::getAndSaveAllTracks(const QStringList& paths, const TrackList& tracks, bool onlyModified)
+std::pair<QStringList, QStringList> LibraryScannerPrivate::libraryFileTypes() const
 {
-    populateExistingTracks(tracks);
-
     using namespace Settings::Core::Internal;
 
     QStringList restrictExtensions = m_settings->fileValue(LibraryRestrictTypes).toStringList();
@@ -818,27 +1127,31 @@ bool LibraryScannerPrivate::getAndSaveAllTracks(const QStringList& paths, const
         restrictExtensions.append(u"cue"_s);
     }
 
-    const auto files = getFiles(paths, restrictExtensions, excludeExtensions, {});
+    return {restrictExtensions, excludeExtensions};
+}
+
+bool LibraryScannerPrivate::readAndSavePaths(const QStringList& paths, bool onlyModified)
+{
+    const auto [restrictExtensions, excludeExtensions] = libraryFileTypes();
+    return readAndSaveFiles(getFiles(paths, restrictExtensions, excludeExtensions, {}), onlyModified);
+}
+
+bool LibraryScannerPrivate::readAndSaveFiles(const QFileInfoList& files, bool onlyModified)
+{
+    using namespace Settings::Core::Internal;
 
     m_totalFiles = files.size();
     reportProgress({});
 
-    for(const auto& file : files) {
-        if(!m_self->mayRun()) {
-            return false;
-        }
+    const int readerThreads = m_settings->fileValue(LibraryScanThreads, QThread::idealThreadCount()).toInt();
+    m_readerPool.setMaxThreadCount(std::max(readerThreads, 1));
 
-        const QString filepath = file.absoluteFilePath();
+    qCDebug(LIB_SCANNER) << "Reading tags using" << m_readerPool.maxThreadCount() << "threads";
 
-        if(file.suffix() == "cue"_L1) {
-            readCue(filepath, onlyModified);
-        }
-        else {
-            readFile(filepath, onlyModified);
-        }
-
-        fileScanned(filepath);
-        checkBatchFinished();
+    const bool completed
+        = m_readerPool.maxThreadCount() > 1 ? readFilesParallel(files, onlyModified) : readFiles(files, onlyModified);
+    if(!completed) {
+        return false;
     }
 
     for(const auto& missingTracks : m_missingFiles | std::views::values) {
@@ -854,8 +1167,8 @@ bool LibraryScannerPrivate::getAndSaveAllTracks(const QStringList& paths, const
         }
     }
 
-    m_trackDatabase.storeTracks(m_tracksToStore);
-    m_trackDatabase.updateTracks(m_tracksToUpdate);
+    storeTracks(m_tracksToStore);
+    updateTracks(m_tracksToUpdate);
 
     if(!m_tracksToStore.empty() || !m_tracksToUpdate.empty()) {
         emit m_self->scanUpdate({m_tracksToStore, m_tracksToUpdate});
@@ -864,6 +1177,84 @@ bool LibraryScannerPrivate::getAndSaveAllTracks(const QStringList& paths, const
     return true;
 }
 
+bool LibraryScannerPrivate::getAndSaveAllTracks(const QStringList& paths, const TrackList& tracks, bool onlyModified)
+{
+    populateExistingTracks(tracks);
+    return readAndSavePaths(paths, onlyModified);
+}
+
+bool LibraryScannerPrivate::getAndSaveLibraryTracks(const TrackList& tracks, bool onlyModified)
+{
+    if(!m_settings->fileValue(Settings::Core::Internal::LibrarySkipUnchanged, false).toBool()) {
+        return getAndSaveAllTracks({m_currentLibrary.path}, tracks, onlyModified);
+    }
+
+    const auto [restrictExtensions, excludeExtensions] = libraryFileTypes();
+
+    QStringList extensions{restrictExtensions};
+    for(const auto& ext : excludeExtensions) {
+        extensions.removeAll(ext);
+    }
+    extensions.sort();
+
+    // Directories found using different file types can't be reused
+    const QString filterHash = Utils::generateHash(extensions.join(u';'));
+
+    const Timer timer;
+
+    // Full rescans list every directory, but still record them for the next scan
+    DirectoryManifest manifest{onlyModified ? m_directoryDatabase.directories(m_currentLibrary.id, filterHash)
+                                            : DirectoryDatabase::Directories{},
+                               extensions};
+    manifest.walk(m_currentLibrary.path);
+
+    QFileInfoList files = manifest.files();
+    sortFiles(files);
+
+    qCInfo(LIB_SCANNER) << "Found" << files.size() << "files in changed directories, skipped"
+                        << manifest.unchangedDirCount() << "unchanged directories (" << manifest.unchangedFileCount()
+                        << "files) in" << timer.elapsedFormatted();
+
+    populateExistingTracks(tracks, true, &manifest);
+
+    if(!readAndSaveFiles(files, onlyModified)) {
+        // Directories which weren't read must be listed again next time
+        return false;
+    }
+
+    m_directoryDatabase.storeDirectories(m_currentLibrary.id, filterHash, manifest.directories());
+
+    return true;
+}
+
+bool LibraryScannerPrivate::getAndSaveChangedTracks(const LibraryChanges& changes, const TrackList& tracks)
+{
+    // Only the reported files are read, and only tracks below removed or changed paths are checked for
+    // existence, rather than every track in the library
+    populateExistingTracks(tracks, false);
+
+    QStringList paths;
+    QStringList missingPaths{changes.removed};
+
+    for(const auto& [from, to] : changes.moved) {
+        if(!moveTracks(from, to)) {
+            missingPaths.append(from);
+            paths.append(to);
+        }
+    }
+
+    missingPaths.append(changes.dirs);
+    markMissing(missingPaths);
+
+    paths.append(changes.dirs);
+
+    paths.append(changes.modified);
+    paths.removeDuplicates();
+    paths.removeIf([](const QString& path) { return !QFileInfo::exists(path); });
+
+    return readAndSavePaths(paths, true);
+}
+
 void LibraryScannerPrivate::changeLibraryStatus(LibraryInfo::Status status)
 {
     m_currentLibrary.status = status;
@@ -885,6 +1276,7 @@ void LibraryScanner::initialiseThread()
 
     p->m_dbHandler = std::make_unique<DbConnectionHandler>(p->m_dbPool);
     p->m_trackDatabase.initialise(DbConnectionProvider{p->m_dbPool});
+    p->m_directoryDatabase.initialise(DbConnectionProvider{p->m_dbPool});
 }
 
 void LibraryScanner::stopThread()
@@ -942,7 +1334,7 @@ void LibraryScanner::scanLibrary(const LibraryInfo& library, const TrackList& tr
         if(p->m_monitor && !p->m_watchers.contains(library.id)) {
             p->addWatcher(library);
         }
-        p->getAndSaveAllTracks({library.path}, tracks, onlyModified);
+        p->getAndSaveLibraryTracks(tracks, onlyModified);
         p->cleanupScan();
     }
 
@@ -958,14 +1350,15 @@ void LibraryScanner::scanLibrary(const LibraryInfo& library, const TrackList& tr
     }
 }
 
-void LibraryScanner::scanLibraryDirectoies(const LibraryInfo& library, const QStringList& dirs, const TrackList& tracks)
+void LibraryScanner::scanLibraryChanges(const LibraryInfo& library, const LibraryChanges& changes,
+                                        const TrackList& tracks)
 {
     setState(Running);
 
     p->m_currentLibrary = library;
     p->changeLibraryStatus(LibraryInfo::Status::Scanning);
 
-    p->getAndSaveAllTracks(dirs, tracks, true);
+    p->getAndSaveChangedTracks(changes, tracks);
     p->cleanupScan();
 
     if(state() == Paused) {
@@ -1028,7 +1421,7 @@ void LibraryScanner::scanTracks(const TrackList& /*libraryTracks*/, const TrackL
     }
 
     if(!tracksToUpdate.empty()) {
-        p->m_trackDatabase.updateTracks(tracksToUpdate);
+        p->updateTracks(tracksToUpdate);
         p->m_trackDatabase.updateTrackStats(tracksToUpdate);
 
         emit scanUpdate({{}, tracksToUpdate});
@@ -1122,12 +1515,12 @@ void LibraryScanner::scanFiles(const TrackList& libraryTracks, const QList<QUrl>
     }
 
     if(!playlistTracksScanned.empty()) {
-        p->m_trackDatabase.storeTracks(playlistTracksScanned);
+        p->storeTracks(playlistTracksScanned);
         emit playlistLoaded(playlistTracksScanned);
     }
 
     if(!tracksScanned.empty()) {
-        p->m_trackDatabase.storeTracks(tracksScanned);
+        p->storeTracks(tracksScanned);
         emit scannedTracks(tracksScanned);
     }
 
@@ -1158,7 +1551,7 @@ void LibraryScanner::scanPlaylist(const TrackList& libraryTracks, const QList<QU
     }
 
     if(!tracksScanned.empty()) {
-        p->m_trackDatabase.storeTracks(tracksScanned);
+        p->storeTracks(tracksScanned);
         emit playlistLoaded(tracksScanned);
     }
 
@@ -0,0 +1,315 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "librarysnapshot.h"
+
+#include "database/database.h"
+
+#include <utils/fypaths.h>
+#include <utils/timer.h>
+
+#include <QDataStream>
+#include <QFile>
+#include <QLoggingCategory>
+#include <QSaveFile>
+
+#include <array>
+#include <cstring>
+#include <utility>
+
+Q_LOGGING_CATEGORY(LIB_SNAPSHOT, "fy.snapshot")
+
+using namespace Qt::StringLiterals;
+
+namespace {
+constexpr std::array<char, 4> FileMagic = {'F', 'Y', 'L', 'S'};
+constexpr uint16_t FileVersion          = 2;
+constexpr uint16_t ByteOrderMark        = 0xFEFF;
+constexpr auto StreamVersion            = QDataStream::Qt_6_0;
+
+struct FileHeader
+{
+    std::array<char, 4> magic{FileMagic};
+    uint16_t version{FileVersion};
+    uint16_t byteOrder{ByteOrderMark};
+    uint64_t revision{0};
+    int32_t trackCount{0};
+    int32_t maxTrackId{-1};
+    uint32_t entryCount{0};
+    // Snapshots written before a schema upgrade may be missing columns or hold stale values
+    uint32_t schemaVersion{Fooyin::CurrentSchemaVersion};
+};
+static_assert(sizeof(FileHeader) == 32);
+static_assert(std::is_trivially_copyable_v<FileHeader>);
+
+bool headerMatches(const FileHeader& header, const Fooyin::TrackTableState& state)
+{
+    return header.magic == FileMagic && header.version == FileVersion && header.byteOrder == ByteOrderMark
+        && header.revision == state.revision && header.trackCount == state.count
+        && header.maxTrackId == state.maxId && std::cmp_equal(header.entryCount, state.count)
+        && std::cmp_equal(header.schemaVersion, Fooyin::CurrentSchemaVersion);
+}
+
+void writeTrack(QDataStream& stream, const Fooyin::Track& track)
+{
+    stream << static_cast<qint32>(track.id()) << track.filepath() << static_cast<qint32>(track.subsong())
+           << track.title() << track.trackNumber() << track.trackTotal() << track.artists() << track.albumArtists()
+           << track.album() << track.discNumber() << track.discTotal() << track.date() << track.composers()
+           << track.performers() << track.genres() << track.comment() << track.cuePath()
+           << static_cast<quint64>(track.offset()) << static_cast<quint64>(track.duration())
+           << static_cast<quint64>(track.fileSize()) << static_cast<qint32>(track.bitrate())
+           << static_cast<qint32>(track.sampleRate()) << static_cast<qint32>(track.channels())
+           << static_cast<qint32>(track.bitDepth()) << track.codec() << track.codecProfile() << track.tool()
+           << track.tagTypes() << track.encoding() << track.serialiseExtraTags() << track.serialiseExtraProperties()
+           << static_cast<quint64>(track.modifiedTime()) << static_cast<qint32>(track.libraryId()) << track.hash()
+           << track.rgTrackGain() << track.rgAlbumGain() << track.rgTrackPeak() << track.rgAlbumPeak();
+}
+
+Fooyin::Track readTrack(QDataStream& stream)
+{
+    qint32 id{-1};
+    QString filepath;
+    qint32 subsong{0};
+    QString title;
+    QString trackNumber;
+    QString trackTotal;
+    QStringList artists;
+    QStringList albumArtists;
+    QString album;
+    QString discNumber;
+    QString discTotal;
+    QString date;
+    QStringList composers;
+    QStringList performers;
+    QStringList genres;
+    QString comment;
+    QString cuePath;
+    quint64 offset{0};
+    quint64 duration{0};
+    quint64 fileSize{0};
+    qint32 bitrate{0};
+    qint32 sampleRate{0};
+    qint32 channels{0};
+    qint32 bitDepth{0};
+    QString codec;
+    QString codecProfile;
+    QString tool;
+    QStringList tagTypes;
+    QString encoding;
+    QByteArray extraTags;
+    QByteArray extraProperties;
+    quint64 modifiedTime{0};
+    qint32 libraryId{-1};
+    QString hash;
+    float rgTrackGain{0};
+    float rgAlbumGain{0};
+    float rgTrackPeak{0};
+    float rgAlbumPeak{0};
+
+    stream >> id >> filepath >> subsong >> title >> trackNumber >> trackTotal >> artists >> albumArtists >> album
+        >> discNumber >> discTotal >> date >> composers >> performers >> genres >> comment >> cuePath >> offset
+        >> duration >> fileSize >> bitrate >> sampleRate >> channels >> bitDepth >> codec >> codecProfile >> tool
+        >> tagTypes >> encoding >> extraTags >> extraProperties >> modifiedTime >> libraryId >> hash >> rgTrackGain
+        >> rgAlbumGain >> rgTrackPeak >> rgAlbumPeak;
+
+    Fooyin::Track track;
+
+    track.setId(id);
+    track.setFilePath(filepath);
+    track.setSubsong(subsong);
+    track.setTitle(title);
+    track.setTrackNumber(trackNumber);
+    track.setTrackTotal(trackTotal);
+    track.setArtists(artists);
+    track.setAlbumArtists(albumArtists);
+    track.setAlbum(album);
+    track.setDiscNumber(discNumber);
+    track.setDiscTotal(discTotal);
+    track.setDate(date);
+    track.setComposers(composers);
+    track.setPerformers(performers);
+    track.setGenres(genres);
+    track.setComment(comment);
+    track.setCuePath(cuePath);
+    track.setOffset(offset);
+    track.setDuration(duration);
+    track.setFileSize(fileSize);
+    track.setBitrate(bitrate);
+    track.setSampleRate(sampleRate);
+    track.setChannels(channels);
+    track.setBitDepth(bitDepth);
+    track.setCodec(codec);
+    track.setCodecProfile(codecProfile);
+    track.setTool(tool);
+    track.setTagTypes(tagTypes);
+    track.setEncoding(encoding);
+    track.storeExtraTags(extraTags);
+    track.storeExtraProperties(extraProperties);
+    track.setModifiedTime(modifiedTime);
+    track.setLibraryId(libraryId);
+    track.setRGTrackGain(rgTrackGain);
+    track.setRGAlbumGain(rgAlbumGain);
+    track.setRGTrackPeak(rgTrackPeak);
+    track.setRGAlbumPeak(rgAlbumPeak);
+    // Set last so the setters above don't regenerate it
+    track.setHash(hash);
+
+    return track;
+}
+} // namespace
+
+namespace Fooyin {
+LibrarySnapshot::LibrarySnapshot(QString filepath)
+    : m_filepath{filepath.isEmpty() ? Utils::cachePath() + "/library.fysnap"_L1 : std::move(filepath)}
+{ }
+
+QString LibrarySnapshot::filepath() const
+{
+    return m_filepath;
+}
+
+bool LibrarySnapshot::isValid(const TrackTableState& state) const
+{
+    QFile file{m_filepath};
+    if(!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    FileHeader header;
+    if(file.read(reinterpret_cast<char*>(&header), sizeof(FileHeader)) != static_cast<qint64>(sizeof(FileHeader))) {
+        return false;
+    }
+
+    return headerMatches(header, state);
+}
+
+bool LibrarySnapshot::load(const TrackTableState& state, TrackList& tracks) const
+{
+    const Timer timer;
+
+    QFile file{m_filepath};
+    if(!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const qint64 fileSize = file.size();
+    if(fileSize < static_cast<qint64>(sizeof(FileHeader))) {
+        return false;
+    }
+
+    uchar* data = file.map(0, fileSize);
+    if(!data) {
+        qCInfo(LIB_SNAPSHOT) << "Failed to map" << m_filepath << ":" << file.errorString();
+        return false;
+    }
+
+    FileHeader header;
+    std::memcpy(&header, data, sizeof(FileHeader));
+
+    if(!headerMatches(header, state)) {
+        qCDebug(LIB_SNAPSHOT) << "Library snapshot is out of date";
+        file.unmap(data);
+        return false;
+    }
+
+    TrackList loadedTracks;
+    loadedTracks.reserve(header.entryCount);
+
+    bool success{true};
+
+    {
+        // Everything read is copied out, so the stream can read straight from the mapping
+        const auto payload = QByteArray::fromRawData(reinterpret_cast<const char*>(data + sizeof(FileHeader)),
+                                                     fileSize - static_cast<qint64>(sizeof(FileHeader)));
+        QDataStream stream{payload};
+        stream.setVersion(StreamVersion);
+
+        for(uint32_t i{0}; i < header.entryCount; ++i) {
+            loadedTracks.push_back(readTrack(stream));
+
+            if(stream.status() != QDataStream::Ok) {
+                success = false;
+                break;
+            }
+        }
+    }
+
+    file.unmap(data);
+
+    if(!success) {
+        qCWarning(LIB_SNAPSHOT) << "Library snapshot is corrupt:" << m_filepath;
+        return false;
+    }
+
+    tracks = std::move(loadedTracks);
+
+    qCDebug(LIB_SNAPSHOT) << "Loaded" << tracks.size() << "tracks from snapshot in" << timer.elapsedFormatted();
+
+    return true;
+}
+
+bool LibrarySnapshot::save(const TrackTableState& state, const TrackList& tracks) const
+{
+    if(std::cmp_not_equal(tracks.size(), state.count)) {
+        qCDebug(LIB_SNAPSHOT) << "Not saving library snapshot (track count mismatch)";
+        return false;
+    }
+
+    const Timer timer;
+
+    QSaveFile file{m_filepath};
+    if(!file.open(QIODevice::WriteOnly)) {
+        qCWarning(LIB_SNAPSHOT) << "Failed to open" << m_filepath << "for writing:" << file.errorString();
+        return false;
+    }
+
+    FileHeader header;
+    header.revision   = state.revision;
+    header.trackCount = state.count;
+    header.maxTrackId = state.maxId;
+    header.entryCount = static_cast<uint32_t>(tracks.size());
+
+    if(file.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader))
+       != static_cast<qint64>(sizeof(FileHeader))) {
+        file.cancelWriting();
+        return false;
+    }
+
+    QDataStream stream{&file};
+    stream.setVersion(StreamVersion);
+
+    for(const Track& track : tracks) {
+        writeTrack(stream, track);
+    }
+
+    if(stream.status() != QDataStream::Ok || !file.commit()) {
+        qCWarning(LIB_SNAPSHOT) << "Failed to write library snapshot:" << file.errorString();
+        return false;
+    }
+
+    qCDebug(LIB_SNAPSHOT) << "Saved" << tracks.size() << "tracks to snapshot in" << timer.elapsedFormatted();
+
+    return true;
+}
+
+bool LibrarySnapshot::remove() const
+{
+    return !QFile::exists(m_filepath) || QFile::remove(m_filepath);
+}
+} // namespace Fooyin
@@ -0,0 +1,55 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "database/trackdatabase.h"
+
+#include <core/track.h>
+
+#include <QString>
+
+namespace Fooyin {
+/*!
+ * Binary snapshot of the library's tracks, used to speed up startup.
+ *
+ * The snapshot stores every column of the Tracks table in a versioned file which is
+ * memory-mapped on load, so tracks can be rebuilt without going through per-row SQL
+ * and QVariant conversions or recomputing hashes. Playback statistics are not included
+ * as they change frequently; they are loaded separately from the database.
+ *
+ * A snapshot is only loaded if the TrackTableState it was saved with matches the current
+ * state of the database.
+ */
+class LibrarySnapshot
+{
+public:
+    explicit LibrarySnapshot(QString filepath = {});
+
+    [[nodiscard]] QString filepath() const;
+
+    [[nodiscard]] bool isValid(const TrackTableState& state) const;
+    [[nodiscard]] bool load(const TrackTableState& state, TrackList& tracks) const;
+    bool save(const TrackTableState& state, const TrackList& tracks) const;
+    bool remove() const;
+
+private:
+    QString m_filepath;
+};
+} // namespace Fooyin
@@ -36,11 +36,13 @@
 using namespace std::chrono_literals;
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
-constexpr auto WriteInterval  = 1s;
-constexpr auto UpdateInterval = 1s;
+constexpr auto WriteInterval    = 1s;
+constexpr auto UpdateInterval   = 1s;
+constexpr auto SnapshotInterval = 30s;
 #else
-constexpr auto WriteInterval  = 1000;
-constexpr auto UpdateInterval = 1000;
+constexpr auto WriteInterval    = 1000;
+constexpr auto UpdateInterval   = 1000;
+constexpr auto SnapshotInterval = 30000;
 #endif
 
 namespace {
@@ -57,7 +59,7 @@ struct LibraryScanRequest
     int id;
     ScanRequest::Type type;
     LibraryInfo library;
-    QStringList dirs;
+    LibraryChanges changes;
     QList<QUrl> files;
     TrackList tracks;
     bool onlyModified{true};
@@ -73,13 +75,13 @@ public:
     void scanLibrary(const LibraryScanRequest& request);
     void scanTracks(const LibraryScanRequest& request);
     void scanFiles(const LibraryScanRequest& request);
-    void scanDirectory(const LibraryScanRequest& request);
+    void scanChanges(const LibraryScanRequest& request);
     void scanPlaylist(const LibraryScanRequest& request);
 
     ScanRequest addLibraryScanRequest(const LibraryInfo& libraryInfo, bool onlyModified);
     ScanRequest addTracksScanRequest(const TrackList& tracks, bool onlyModified);
     ScanRequest addFilesScanRequest(const QList<QUrl>& files);
-    ScanRequest addDirectoryScanRequest(const LibraryInfo& libraryInfo, const QStringList& dirs);
+    ScanRequest addChangesScanRequest(const LibraryInfo& libraryInfo, const LibraryChanges& changes);
     ScanRequest addPlaylistRequest(const QList<QUrl>& files);
 
     [[nodiscard]] std::optional<LibraryScanRequest> currentRequest() const;
@@ -105,6 +107,7 @@ public:
     TrackList m_tracksPendingUpdate;
     QBasicTimer m_playcountTimer;
     TrackList m_tracksPendingPlaycountUpdate;
+    QBasicTimer m_snapshotTimer;
 
     std::deque<LibraryScanRequest> m_scanRequests;
     int m_currentRequestId{-1};
@@ -161,10 +164,10 @@ void LibraryThreadHandlerPrivate::scanFiles(const LibraryScanRequest& request)
                               [this, request]() { m_scanner.scanFiles(m_library->tracks(), request.files); });
 }
 
-void LibraryThreadHandlerPrivate::scanDirectory(const LibraryScanRequest& request)
+void LibraryThreadHandlerPrivate::scanChanges(const LibraryScanRequest& request)
 {
     QMetaObject::invokeMethod(&m_scanner, [this, request]() {
-        m_scanner.scanLibraryDirectoies(request.library, request.dirs, m_library->tracks());
+        m_scanner.scanLibraryChanges(request.library, request.changes, m_library->tracks());
     });
 }
 
@@ -254,9 +257,31 @@ ScanRequest LibraryThreadHandlerPrivate::addFilesScanRequest(const QList<QUrl>&
     return request;
 }
 
-ScanRequest LibraryThreadHandlerPrivate::addDirectoryScanRequest(const LibraryInfo& libraryInfo,
-                                                                 const QStringList& dirs)
+ScanRequest LibraryThreadHandlerPrivate::addChangesScanRequest(const LibraryInfo& libraryInfo,
+                                                               const LibraryChanges& changes)
 {
+    // Changes made while another scan is running are merged into any queued scan of the same library
+    const auto pendingIt = std::ranges::find_if(m_scanRequests, [this, &libraryInfo](const auto& request) {
+        return request.id != m_currentRequestId && request.type == ScanRequest::Library
+            && request.library.id == libraryInfo.id;
+    });
+    if(pendingIt != m_scanRequests.end()) {
+        // A queued full scan will pick up the changes anyway
+        if(!pendingIt->changes.isEmpty()) {
+            LibraryChanges& pending = pendingIt->changes;
+            pending.modified.append(changes.modified);
+            pending.removed.append(changes.removed);
+            pending.moved.insert(pending.moved.end(), changes.moved.cbegin(), changes.moved.cend());
+            pending.dirs.append(changes.dirs);
+        }
+
+        const int id = pendingIt->id;
+        ScanRequest request{.type = ScanRequest::Library, .id = id, .cancel = [this, id]() {
+                                cancelScanRequest(id);
+                            }};
+        return request;
+    }
+
     const int id = nextRequestId();
 
     ScanRequest request{.type = ScanRequest::Library, .id = id, .cancel = [this, id]() {
@@ -267,7 +292,7 @@ ScanRequest LibraryThreadHandlerPrivate::addDirectoryScanRequest(const LibraryIn
     libraryRequest.id      = id;
     libraryRequest.type    = ScanRequest::Library;
     libraryRequest.library = libraryInfo;
-    libraryRequest.dirs    = dirs;
+    libraryRequest.changes = changes;
 
     m_scanRequests.emplace_back(libraryRequest);
 
@@ -335,11 +360,11 @@ void LibraryThreadHandlerPrivate::execNextRequest()
             scanTracks(request);
             break;
         case(ScanRequest::Library):
-            if(request.dirs.isEmpty()) {
+            if(request.changes.isEmpty()) {
                 scanLibrary(request);
             }
             else {
-                scanDirectory(request);
+                scanChanges(request);
             }
             break;
         case(ScanRequest::Playlist):
@@ -368,6 +393,9 @@ void LibraryThreadHandlerPrivate::updateProgress(int current, const QString& fil
 
 void LibraryThreadHandlerPrivate::finishScanRequest()
 {
+    // Rebuild the library snapshot once scanning has settled
+    m_snapshotTimer.start(SnapshotInterval, m_self);
+
     if(const auto request = currentRequest()) {
         std::erase_if(m_scanRequests,
                       [this](const auto& pendingRequest) { return pendingRequest.id == m_currentRequestId; });
@@ -420,9 +448,9 @@ LibraryThreadHandler::LibraryThreadHandler(DbConnectionPoolPtr dbPool, MusicLibr
                      [this](const TrackList& tracks) { emit playlistLoaded(p->m_currentRequestId, tracks); });
     QObject::connect(&p->m_scanner, &LibraryScanner::statusChanged, this, &LibraryThreadHandler::statusChanged);
     QObject::connect(&p->m_scanner, &LibraryScanner::scanUpdate, this, &LibraryThreadHandler::scanUpdate);
-    QObject::connect(&p->m_scanner, &LibraryScanner::directoriesChanged, this,
-                     [this](const LibraryInfo& libraryInfo, const QStringList& dirs) {
-                         p->addDirectoryScanRequest(libraryInfo, dirs);
+    QObject::connect(&p->m_scanner, &LibraryScanner::libraryChanged, this,
+                     [this](const LibraryInfo& libraryInfo, const LibraryChanges& changes) {
+                         p->addChangesScanRequest(libraryInfo, changes);
                      });
 
     QMetaObject::invokeMethod(&p->m_scanner, &Worker::initialiseThread);
@@ -574,6 +602,12 @@ void LibraryThreadHandler::timerEvent(QTimerEvent* event)
         });
         p->m_tracksPendingPlaycountUpdate.clear();
     }
+    else if(event->timerId() == p->m_snapshotTimer.timerId()) {
+        p->m_snapshotTimer.stop();
+        if(p->m_scanRequests.empty()) {
+            QMetaObject::invokeMethod(&p->m_trackDatabaseManager, &TrackDatabaseManager::saveSnapshot);
+        }
+    }
 
     QObject::timerEvent(event);
 }
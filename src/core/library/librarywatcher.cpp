@@ -19,9 +19,17 @@
 
 #include "librarywatcher.h"
 
-#include <QTimer>
+#ifdef Q_OS_LINUX
+#include "inotifywatcher.h"
+#endif
+
+#include <utils/fileutils.h>
+
+#include <QFileSystemWatcher>
 #include <QTimerEvent>
 
+#include <utility>
+
 using namespace std::chrono_literals;
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
@@ -30,26 +38,142 @@ constexpr auto Interval = 1000ms;
 constexpr auto Interval = 1000;
 #endif
 
+namespace {
+bool isUnder(const QString& path, const QString& dir)
+{
+    return path.size() > dir.size() && path.startsWith(dir) && path.at(dir.size()) == u'/';
+}
+} // namespace
+
 namespace Fooyin {
-LibraryWatcher::LibraryWatcher(QObject* parent)
-    : QFileSystemWatcher{parent}
+bool LibraryChanges::isEmpty() const
+{
+    return modified.empty() && removed.empty() && moved.empty() && dirs.empty();
+}
+
+void LibraryChangeCollector::addModified(const QString& path)
+{
+    m_removed.erase(path);
+    m_modified.emplace(path);
+}
+
+void LibraryChangeCollector::addRemoved(const QString& path)
+{
+    m_modified.erase(path);
+    m_removed.emplace(path);
+
+    // Moved and then deleted (or its new directory was), so it's only gone from where it started.
+    // Moves are walked backwards so a chain of renames resolves to the original path.
+    std::set<QString> gone{path};
+    for(size_t i{m_moved.size()}; i-- > 0;) {
+        const auto& [from, to] = m_moved.at(i);
+        if(gone.contains(to) || isUnder(to, path)) {
+            gone.emplace(from);
+            m_removed.emplace(from);
+            m_moved.erase(m_moved.begin() + static_cast<std::ptrdiff_t>(i));
+        }
+    }
+}
+
+void LibraryChangeCollector::addMoved(const QString& from, const QString& to)
+{
+    m_removed.erase(to);
+    m_modified.erase(to);
+
+    if(m_modified.erase(from) > 0) {
+        // Written and then renamed (e.g. a temporary download), so only the final file matters
+        m_modified.emplace(to);
+    }
+    else {
+        // Kept in order, as later moves may depend on earlier ones
+        m_moved.emplace_back(from, to);
+    }
+}
+
+void LibraryChangeCollector::addDir(const QString& path)
+{
+    m_dirs.emplace(path);
+}
+
+LibraryChanges LibraryChangeCollector::takeChanges()
 {
-    QObject::connect(this, &QFileSystemWatcher::directoryChanged, this, [this](const QString& path) {
-        m_dirs.emplace(path);
-        m_timer.start(Interval, this);
+    LibraryChanges changes;
+    changes.modified = {m_modified.cbegin(), m_modified.cend()};
+    changes.removed  = {m_removed.cbegin(), m_removed.cend()};
+    changes.moved    = std::exchange(m_moved, {});
+    changes.dirs     = {m_dirs.cbegin(), m_dirs.cend()};
+
+    m_modified.clear();
+    m_removed.clear();
+    m_dirs.clear();
+
+    return changes;
+}
+
+LibraryWatcher::LibraryWatcher(const QString& path, QObject* parent)
+    : QObject{parent}
+{
+#ifdef Q_OS_LINUX
+    m_inotify = std::make_unique<InotifyWatcher>();
+    if(m_inotify->isValid()) {
+        QObject::connect(m_inotify.get(), &InotifyWatcher::fileChanged, this, &LibraryWatcher::addModified);
+        QObject::connect(m_inotify.get(), &InotifyWatcher::fileRemoved, this, &LibraryWatcher::addRemoved);
+        QObject::connect(m_inotify.get(), &InotifyWatcher::fileMoved, this, &LibraryWatcher::addMoved);
+        QObject::connect(m_inotify.get(), &InotifyWatcher::dirChanged, this, &LibraryWatcher::addDir);
+        m_inotify->addPath(path);
+        return;
+    }
+    m_inotify.reset();
+#endif
+
+    m_dirWatcher = std::make_unique<QFileSystemWatcher>();
+    QObject::connect(m_dirWatcher.get(), &QFileSystemWatcher::directoryChanged, this, [this](const QString& dir) {
+        watchDirs(dir);
+        addDir(dir);
     });
+    watchDirs(path);
 }
 
+LibraryWatcher::~LibraryWatcher() = default;
+
 void LibraryWatcher::timerEvent(QTimerEvent* event)
 {
     if(event->timerId() == m_timer.timerId()) {
         m_timer.stop();
-
-        const QStringList paths{m_dirs.cbegin(), m_dirs.cend()};
-        m_dirs.clear();
-        emit libraryDirsChanged(paths);
+        emit libraryChanged(m_changes.takeChanges());
     }
-    QFileSystemWatcher::timerEvent(event);
+    QObject::timerEvent(event);
+}
+
+void LibraryWatcher::watchDirs(const QString& path)
+{
+    QStringList dirs = Utils::File::getAllSubdirectories(path);
+    dirs.append(path);
+    m_dirWatcher->addPaths(dirs);
+}
+
+void LibraryWatcher::addModified(const QString& path)
+{
+    m_changes.addModified(path);
+    m_timer.start(Interval, this);
+}
+
+void LibraryWatcher::addRemoved(const QString& path)
+{
+    m_changes.addRemoved(path);
+    m_timer.start(Interval, this);
+}
+
+void LibraryWatcher::addMoved(const QString& from, const QString& to)
+{
+    m_changes.addMoved(from, to);
+    m_timer.start(Interval, this);
+}
+
+void LibraryWatcher::addDir(const QString& path)
+{
+    m_changes.addDir(path);
+    m_timer.start(Interval, this);
 }
 } // namespace Fooyin
 
@@ -19,27 +19,89 @@
 
 #pragma once
 
+#include "fycore_export.h"
+
 #include <QBasicTimer>
-#include <QFileSystemWatcher>
+#include <QObject>
+#include <QStringList>
 
+#include <memory>
 #include <set>
+#include <vector>
+
+class QFileSystemWatcher;
 
 namespace Fooyin {
-class LibraryWatcher : public QFileSystemWatcher
+class InotifyWatcher;
+
+struct FYCORE_EXPORT LibraryChanges
+{
+    // Files created or written to
+    QStringList modified;
+    // Files or directories deleted or moved out of the library
+    QStringList removed;
+    // Files or directories moved within the library, as (from, to)
+    std::vector<std::pair<QString, QString>> moved;
+    // Directories to rescan in full
+    QStringList dirs;
+
+    [[nodiscard]] bool isEmpty() const;
+};
+
+/*!
+ * Coalesces file events into the smallest set of changes which brings the library up to date.
+ */
+class FYCORE_EXPORT LibraryChangeCollector
+{
+public:
+    void addModified(const QString& path);
+    void addRemoved(const QString& path);
+    void addMoved(const QString& from, const QString& to);
+    void addDir(const QString& path);
+
+    /** Returns the changes collected so far, and resets the collector. */
+    [[nodiscard]] LibraryChanges takeChanges();
+
+private:
+    std::set<QString> m_modified;
+    std::set<QString> m_removed;
+    std::vector<std::pair<QString, QString>> m_moved;
+    std::set<QString> m_dirs;
+};
+
+/*!
+ * Watches a library directory, reporting changes once they've settled.
+ * On Linux, inotify is used so changes are reported per file. Elsewhere changed
+ * directories are reported from a QFileSystemWatcher.
+ */
+class LibraryWatcher : public QObject
 {
     Q_OBJECT
 
 public:
-    explicit LibraryWatcher(QObject* parent = nullptr);
+    explicit LibraryWatcher(const QString& path, QObject* parent = nullptr);
+    ~LibraryWatcher() override;
 
 signals:
-    void libraryDirsChanged(const QStringList& paths);
+    void libraryChanged(const Fooyin::LibraryChanges& changes);
 
 protected:
     void timerEvent(QTimerEvent* event) override;
 
 private:
+    void watchDirs(const QString& path);
+
+    void addModified(const QString& path);
+    void addRemoved(const QString& path);
+    void addMoved(const QString& from, const QString& to);
+    void addDir(const QString& path);
+
+    std::unique_ptr<QFileSystemWatcher> m_dirWatcher;
+#ifdef Q_OS_LINUX
+    std::unique_ptr<InotifyWatcher> m_inotify;
+#endif
+
     QBasicTimer m_timer;
-    std::set<QString> m_dirs;
+    LibraryChangeCollector m_changes;
 };
 } // namespace Fooyin
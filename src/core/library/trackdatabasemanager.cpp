@@ -55,7 +55,14 @@ void TrackDatabaseManager::getAllTracks()
 {
     setState(Running);
 
-    TrackList tracks = m_trackDatabase.getAllTracks();
+    // Read before the tracks so any concurrent write leaves the snapshot stale rather than wrong
+    const TrackTableState state = m_trackDatabase.tableState();
+
+    TrackList tracks;
+    if(!m_snapshot.load(state, tracks) || !m_trackDatabase.loadTrackStats(tracks)) {
+        tracks = m_trackDatabase.getAllTracks();
+        m_snapshot.save(state, tracks);
+    }
 
     if(m_settings->fileValue(Settings::Core::Internal::MarkUnavailableStartup, false).toBool()) {
         std::ranges::for_each(tracks, [](auto& track) { track.setIsEnabled(track.exists()); });
@@ -66,6 +73,20 @@ void TrackDatabaseManager::getAllTracks()
     setState(Idle);
 }
 
+void TrackDatabaseManager::saveSnapshot()
+{
+    const TrackTableState state = m_trackDatabase.tableState();
+    if(m_snapshot.isValid(state)) {
+        return;
+    }
+
+    setState(Running);
+
+    m_snapshot.save(state, m_trackDatabase.getAllTracks());
+
+    setState(Idle);
+}
+
 void TrackDatabaseManager::updateTracks(const TrackList& tracks, bool write)
 {
     setState(Running);
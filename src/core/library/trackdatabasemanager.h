@@ -20,6 +20,7 @@
 #pragma once
 
 #include "database/trackdatabase.h"
+#include "librarysnapshot.h"
 
 #include <utils/database/dbconnectionhandler.h>
 #include <utils/worker.h>
@@ -48,6 +49,7 @@ signals:
 
 public slots:
     void getAllTracks();
+    void saveSnapshot();
     void updateTracks(const Fooyin::TrackList& tracks, bool write);
     void updateTrackStats(const Fooyin::TrackList& track, bool onlyPlaycount);
     void writeCovers(const Fooyin::TrackCoverData& tracks);
@@ -61,5 +63,6 @@ private:
 
     std::unique_ptr<DbConnectionHandler> m_dbHandler;
     TrackDatabase m_trackDatabase;
+    LibrarySnapshot m_snapshot;
 };
 } // namespace Fooyin
@@ -0,0 +1,150 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <core/library/tracksearchindex.h>
+
+#include <core/constants.h>
+
+#include <algorithm>
+#include <mutex>
+
+namespace Fooyin {
+QString TrackSearchIndex::foldText(const QString& text)
+{
+    if(text.isEmpty()) {
+        return {};
+    }
+
+    const QString decomposed = text.toCaseFolded().normalized(QString::NormalizationForm_D);
+
+    QString folded;
+    folded.reserve(decomposed.size());
+
+    for(const QChar ch : decomposed) {
+        if(ch.category() != QChar::Mark_NonSpacing) {
+            folded.append(ch);
+        }
+    }
+
+    return folded;
+}
+
+QString TrackSearchIndex::searchText(const Track& track)
+{
+    const QLatin1String separator{Constants::UnitSeparator};
+
+    // Same fields as Track::hasMatch
+    const QString text = track.artist() % separator % track.title() % separator % track.album() % separator
+                       % track.albumArtist() % separator % track.performer() % separator % track.composer()
+                       % separator % track.genre() % separator % track.filepath();
+
+    return foldText(text);
+}
+
+QStringList TrackSearchIndex::searchTerms(const QString& search, bool singleTerm)
+{
+    if(search.isEmpty()) {
+        return {};
+    }
+
+    if(singleTerm) {
+        return {foldText(search)};
+    }
+
+    QStringList terms = search.split(u' ', Qt::SkipEmptyParts);
+    for(QString& term : terms) {
+        term = foldText(term);
+    }
+
+    return terms;
+}
+
+bool TrackSearchIndex::textHasMatch(const QString& text, const QStringList& terms)
+{
+    return std::ranges::all_of(terms, [&text](const QString& term) { return text.contains(term); });
+}
+
+void TrackSearchIndex::reset(const TrackList& tracks)
+{
+    std::unordered_map<int, QString> searchText;
+    searchText.reserve(tracks.size());
+
+    for(const Track& track : tracks) {
+        if(track.id() >= 0) {
+            searchText.emplace(track.id(), TrackSearchIndex::searchText(track));
+        }
+    }
+
+    const std::unique_lock lock{m_mutex};
+    m_searchText = std::move(searchText);
+}
+
+void TrackSearchIndex::insertTracks(const TrackList& tracks)
+{
+    std::vector<std::pair<int, QString>> searchText;
+    searchText.reserve(tracks.size());
+
+    for(const Track& track : tracks) {
+        if(track.id() >= 0) {
+            searchText.emplace_back(track.id(), TrackSearchIndex::searchText(track));
+        }
+    }
+
+    const std::unique_lock lock{m_mutex};
+    for(auto& [id, text] : searchText) {
+        m_searchText.insert_or_assign(id, std::move(text));
+    }
+}
+
+void TrackSearchIndex::removeTracks(const TrackList& tracks)
+{
+    const std::unique_lock lock{m_mutex};
+    for(const Track& track : tracks) {
+        m_searchText.erase(track.id());
+    }
+}
+
+void TrackSearchIndex::clear()
+{
+    const std::unique_lock lock{m_mutex};
+    m_searchText.clear();
+}
+
+size_t TrackSearchIndex::size() const
+{
+    const std::shared_lock lock{m_mutex};
+    return m_searchText.size();
+}
+
+bool TrackSearchIndex::hasMatch(const Track& track, const QStringList& terms) const
+{
+    if(terms.empty()) {
+        return true;
+    }
+
+    {
+        const std::shared_lock lock{m_mutex};
+        if(const auto textIt = m_searchText.find(track.id()); textIt != m_searchText.cend()) {
+            return textHasMatch(textIt->second, terms);
+        }
+    }
+
+    return textHasMatch(searchText(track), terms);
+}
+} // namespace Fooyin
@@ -19,13 +19,83 @@
 
 #include <core/library/tracksort.h>
 
+#include <QThread>
+#include <QtConcurrentMap>
+
+#include <algorithm>
+
+namespace {
+// Below this, the cost of starting threads outweighs the gains
+constexpr size_t ParallelThreshold = 20000;
+constexpr size_t MinChunkSize      = 5000;
+
+struct Chunk
+{
+    size_t start;
+    size_t end;
+};
+
+std::vector<Chunk> chunksForSize(size_t count)
+{
+    const auto threadCount = static_cast<size_t>(std::max(QThread::idealThreadCount(), 1));
+    const size_t chunkCount = std::clamp<size_t>(count / MinChunkSize, 1, threadCount);
+    const size_t chunkSize  = (count + chunkCount - 1) / chunkCount;
+
+    std::vector<Chunk> chunks;
+    for(size_t start{0}; start < count; start += chunkSize) {
+        chunks.push_back({start, std::min(start + chunkSize, count)});
+    }
+
+    return chunks;
+}
+
+void parallelSortTracks(Fooyin::TrackList& tracks, Qt::SortOrder order)
+{
+    std::vector<Chunk> chunks = chunksForSize(tracks.size());
+
+    QtConcurrent::blockingMap(chunks, [&tracks, order](const Chunk& chunk) {
+        const Fooyin::StringCollator collator;
+        std::stable_sort(tracks.begin() + chunk.start, tracks.begin() + chunk.end,
+                         [&collator, order](const auto& lhs, const auto& rhs) {
+                             return Fooyin::TrackSorter::lessThan(collator, lhs, rhs, order);
+                         });
+    });
+
+    // Merge adjacent runs pairwise until a single sorted run remains.
+    // Merging keeps elements from the earlier run first, so the sort stays stable.
+    while(chunks.size() > 1) {
+        std::vector<std::pair<Chunk, Chunk>> pairs;
+        std::vector<Chunk> mergedChunks;
+
+        for(size_t i{0}; i + 1 < chunks.size(); i += 2) {
+            pairs.emplace_back(chunks.at(i), chunks.at(i + 1));
+            mergedChunks.push_back({chunks.at(i).start, chunks.at(i + 1).end});
+        }
+        if(chunks.size() % 2 != 0) {
+            mergedChunks.push_back(chunks.back());
+        }
+
+        QtConcurrent::blockingMap(pairs, [&tracks, order](const std::pair<Chunk, Chunk>& pair) {
+            const Fooyin::StringCollator collator;
+            std::inplace_merge(tracks.begin() + pair.first.start, tracks.begin() + pair.second.start,
+                               tracks.begin() + pair.second.end, [&collator, order](const auto& lhs, const auto& rhs) {
+                                   return Fooyin::TrackSorter::lessThan(collator, lhs, rhs, order);
+                               });
+        });
+
+        chunks = std::move(mergedChunks);
+    }
+}
+} // namespace
+
 namespace Fooyin {
 TrackSorter::TrackSorter()
     : TrackSorter{nullptr}
 { }
 
 TrackSorter::TrackSorter(LibraryManager* libraryManager)
-    : m_parser{new ScriptRegistry(libraryManager)}
+    : m_libraryManager{libraryManager}
+    , m_parser{new ScriptRegistry(libraryManager)}
 { }
 
 TrackSorter::~TrackSorter() = default;
@@ -37,22 +107,73 @@ TrackList TrackSorter::calcSortFields(const QString& sort, const TrackList& trac
 
 TrackList TrackSorter::calcSortFields(const ParsedScript& sortScript, const TrackList& tracks)
 {
-    const std::scoped_lock lock{m_parserGuard};
-
     TrackList calcTracks{tracks};
-    for(Track& track : calcTracks) {
-        track.setSort(m_parser.evaluate(sortScript, track));
+
+    if(calcTracks.size() < ParallelThreshold) {
+        const std::scoped_lock lock{m_parserGuard};
+
+        for(Track& track : calcTracks) {
+            track.setSort(m_parser.evaluate(sortScript, track));
+        }
+        return calcTracks;
     }
+
+    // Each chunk gets its own parser, as parsers and their caches aren't thread-safe
+    std::vector<Chunk> chunks = chunksForSize(calcTracks.size());
+
+    QtConcurrent::blockingMap(chunks, [this, &sortScript, &calcTracks](const Chunk& chunk) {
+        ScriptParser parser{new ScriptRegistry(m_libraryManager)};
+        for(size_t i{chunk.start}; i < chunk.end; ++i) {
+            Track& track = calcTracks[i];
+            track.setSort(parser.evaluate(sortScript, track));
+        }
+    });
+
     return calcTracks;
 }
 
 TrackList TrackSorter::sortTracks(const TrackList& tracks, Qt::SortOrder order)
 {
     TrackList sortedTracks{tracks};
-    sortTracks(sortedTracks, std::identity{}, order);
+
+    if(sortedTracks.size() < ParallelThreshold) {
+        sortTracks(sortedTracks, std::identity{}, order);
+    }
+    else {
+        parallelSortTracks(sortedTracks, order);
+    }
+
     return sortedTracks;
 }
 
+TrackList TrackSorter::mergeTracks(const TrackList& first, const TrackList& second, Qt::SortOrder order)
+{
+    TrackList mergedTracks;
+    mergedTracks.reserve(first.size() + second.size());
+
+    const StringCollator collator;
+    std::ranges::merge(first, second, std::back_inserter(mergedTracks),
+                       [&collator, order](const Track& lhs, const Track& rhs) {
+                           return lessThan(collator, lhs, rhs, order);
+                       });
+
+    return mergedTracks;
+}
+
+bool TrackSorter::lessThan(const StringCollator& collator, const Track& lhs, const Track& rhs, Qt::SortOrder order)
+{
+    const auto cmp = collator.compare(lhs.sort(), rhs.sort());
+
+    if(cmp == 0) {
+        return false;
+    }
+
+    if(order == Qt::AscendingOrder) {
+        return cmp < 0;
+    }
+    return cmp > 0;
+}
+
 TrackList TrackSorter::calcSortTracks(const QString& sort, const TrackList& tracks, Qt::SortOrder order)
 {
     return calcSortTracks(parseScript(sort), tracks, order);
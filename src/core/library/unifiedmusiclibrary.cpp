@@ -19,24 +19,40 @@
 
 #include "unifiedmusiclibrary.h"
 
+#include "database/sortcachedatabase.h"
 #include "internalcoresettings.h"
 #include "library/librarymanager.h"
 #include "librarythreadhandler.h"
 
 #include <core/coresettings.h>
 #include <core/library/libraryinfo.h>
+#include <core/library/tracksearchindex.h>
 #include <core/library/tracksort.h>
 #include <utils/async.h>
+#include <utils/database/dbconnectionhandler.h>
 #include <utils/fileutils.h>
 #include <utils/settings/settingsmanager.h>
+#include <utils/stringcollator.h>
+#include <utils/stringpool.h>
 
+#include <QBasicTimer>
 #include <QDateTime>
+#include <QTimerEvent>
 
+#include <algorithm>
 #include <ranges>
+#include <unordered_map>
 #include <unordered_set>
 
 using namespace std::chrono_literals;
 
+// Purging walks the whole pool, so batch it rather than running after every change
+#if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
+constexpr auto PurgeInterval = 10s;
+#else
+constexpr auto PurgeInterval = 10000;
+#endif
+
 namespace Fooyin {
 class UnifiedMusicLibraryPrivate
 {
@@ -46,11 +62,17 @@ public:
                                SettingsManager* settings);
 
     void loadTracks(const TrackList& trackToLoad);
+    TrackList loadSortedTracks(const QString& sort, const TrackList& tracks);
+    void storeSortCache(const QString& sort, const TrackList& sortedTracks);
     QFuture<void> addTracks(const TrackList& newTracks);
+    void setTracks(const TrackList& tracks);
+    [[nodiscard]] const Track* findTrack(int id) const;
     void updateLibraryTracks(const TrackList& updatedTracks);
+    void resortChangedTracks(const TrackList& changedTracks);
     QFuture<void> updateTracksMetadata(const TrackList& tracksToUpdate);
     QFuture<void> updateTracks(const TrackList& tracksToUpdate);
     void removeTracks(const TrackList& tracksToRemove);
+    void schedulePurge();
 
     void handleScanResult(const ScanResult& result);
     void scannedTracks(int id, const TrackList& tracks);
@@ -61,7 +83,6 @@ public:
 
     void changeSort(const QString& sort);
     QFuture<TrackList> recalSortTracks(const QString& sort, const TrackList& tracks);
-    QFuture<TrackList> resortTracks(const TrackList& tracks);
 
     void handleTracksLoaded();
 
@@ -75,6 +96,10 @@ public:
     TrackSorter m_sorter;
 
     TrackList m_tracks;
+    std::unordered_map<int, size_t> m_trackIndexes;
+    std::shared_ptr<TrackSearchIndex> m_searchIndex;
+
+    QBasicTimer m_purgeTimer;
 };
 
 UnifiedMusicLibraryPrivate::UnifiedMusicLibraryPrivate(UnifiedMusicLibrary* self, LibraryManager* libraryManager,
@@ -88,6 +113,7 @@ UnifiedMusicLibraryPrivate::UnifiedMusicLibraryPrivate(UnifiedMusicLibrary* self
     , m_settings{settings}
     , m_threadHandler{m_dbPool, m_self, std::move(playlistLoader), std::move(audioLoader), m_settings}
     , m_sorter{m_libraryManager}
+    , m_searchIndex{std::make_shared<TrackSearchIndex>()}
 {
     m_settings->subscribe<Settings::Core::LibrarySortScript>(m_self, [this](const QString& sort) { changeSort(sort); });
     m_settings->subscribe<Settings::Core::Internal::MonitorLibraries>(
@@ -101,11 +127,55 @@ void UnifiedMusicLibraryPrivate::loadTracks(const TrackList& trackToLoad)
         return;
     }
 
-    auto sortTracks = recalSortTracks(m_settings->value<Settings::Core::LibrarySortScript>(), trackToLoad);
+    const QString sort = m_settings->value<Settings::Core::LibrarySortScript>();
+    auto sortTracks    = Utils::asyncExec([this, sort, trackToLoad]() { return loadSortedTracks(sort, trackToLoad); });
+
+    // Build the search index off the main thread, before the library is usable
+    sortTracks
+        .then([searchIndex = m_searchIndex](const TrackList& sortedTracks) {
+            searchIndex->reset(sortedTracks);
+            return sortedTracks;
+        })
+        .then(m_self, [this](const TrackList& sortedTracks) {
+            setTracks(sortedTracks);
+            emit m_self->tracksLoaded(m_tracks);
+        });
+}
+
+TrackList UnifiedMusicLibraryPrivate::loadSortedTracks(const QString& sort, const TrackList& tracks)
+{
+    const DbConnectionHandler dbHandler{m_dbPool};
+    SortCacheDatabase sortDb;
+    sortDb.initialise(DbConnectionProvider{m_dbPool});
 
-    sortTracks.then(m_self, [this](const TrackList& sortedTracks) {
-        m_tracks = sortedTracks;
-        emit m_self->tracksLoaded(m_tracks);
+    const auto cachedSorts = sortDb.cachedSorts(SortCacheDatabase::scriptHash(sort));
+
+    // Cached tracks keep their previous relative order, so only changed tracks need evaluating and merging in
+    TrackList changedTracks;
+    TrackList sortedTracks = SortCacheDatabase::restoreSorts(cachedSorts, tracks,
+                                                             SortCacheDatabase::usesPlayStats(sort), changedTracks);
+
+    if(changedTracks.empty() && sortedTracks.size() == cachedSorts.size()) {
+        return sortedTracks;
+    }
+
+    if(!changedTracks.empty()) {
+        sortedTracks = TrackSorter::mergeTracks(sortedTracks, m_sorter.calcSortTracks(sort, changedTracks));
+    }
+
+    storeSortCache(sort, sortedTracks);
+
+    return sortedTracks;
+}
+
+void UnifiedMusicLibraryPrivate::storeSortCache(const QString& sort, const TrackList& sortedTracks)
+{
+    Utils::asyncExec([dbPool = m_dbPool, sort, sortedTracks]() {
+        const DbConnectionHandler dbHandler{dbPool};
+        SortCacheDatabase sortDb;
+        sortDb.initialise(DbConnectionProvider{dbPool});
+
+        sortDb.storeSorts(sort, sortedTracks);
     });
 }
 
@@ -117,26 +187,139 @@ QFuture<void> UnifiedMusicLibraryPrivate::addTracks(const TrackList& newTracks)
     auto sortTracks = recalSortTracks(m_settings->value<Settings::Core::LibrarySortScript>(), tracksToAdd);
 
     return sortTracks.then(m_self, [this](const TrackList& sortedTracks) {
-        std::ranges::copy(sortedTracks, std::back_inserter(m_tracks));
-
-        resortTracks(m_tracks).then(m_self, [this, sortedTracks](const TrackList& sortedLibraryTracks) {
-            m_tracks = sortedLibraryTracks;
+        for(const Track& track : sortedTracks) {
+            m_trackIndexes[track.id()] = m_tracks.size();
+            m_tracks.push_back(track);
+        }
+        m_searchIndex->insertTracks(sortedTracks);
+        resortChangedTracks(sortedTracks);
 
-            emit m_self->tracksAdded(sortedTracks);
-        });
+        emit m_self->tracksAdded(sortedTracks);
     });
 }
 
+void UnifiedMusicLibraryPrivate::setTracks(const TrackList& tracks)
+{
+    m_tracks = tracks;
+
+    m_trackIndexes.clear();
+    m_trackIndexes.reserve(m_tracks.size());
+
+    for(size_t i{0}; i < m_tracks.size(); ++i) {
+        m_trackIndexes.emplace(m_tracks.at(i).id(), i);
+    }
+}
+
+const Track* UnifiedMusicLibraryPrivate::findTrack(int id) const
+{
+    if(const auto index = m_trackIndexes.find(id); index != m_trackIndexes.cend() && index->second < m_tracks.size()) {
+        return &m_tracks.at(index->second);
+    }
+    return nullptr;
+}
+
 void UnifiedMusicLibraryPrivate::updateLibraryTracks(const TrackList& updatedTracks)
 {
     for(const auto& track : updatedTracks) {
-        auto trackIt
-            = std::ranges::find_if(m_tracks, [&track](const Track& oldTrack) { return oldTrack.id() == track.id(); });
-        if(trackIt != m_tracks.end()) {
-            *trackIt = track;
-            trackIt->clearWasModified();
+        if(const auto index = m_trackIndexes.find(track.id()); index != m_trackIndexes.cend()) {
+            Track& libraryTrack = m_tracks.at(index->second);
+            libraryTrack        = track;
+            libraryTrack.clearWasModified();
+        }
+    }
+}
+
+void UnifiedMusicLibraryPrivate::resortChangedTracks(const TrackList& changedTracks)
+{
+    std::vector<size_t> changedIndexes;
+    changedIndexes.reserve(changedTracks.size());
+
+    for(const Track& track : changedTracks) {
+        if(const auto index = m_trackIndexes.find(track.id()); index != m_trackIndexes.cend()) {
+            changedIndexes.push_back(index->second);
+        }
+    }
+
+    if(changedIndexes.empty()) {
+        return;
+    }
+
+    std::ranges::sort(changedIndexes);
+    const auto duplicates = std::ranges::unique(changedIndexes);
+    changedIndexes.erase(duplicates.begin(), duplicates.end());
+
+    TrackList movedTracks;
+    movedTracks.reserve(changedIndexes.size());
+    for(const size_t index : changedIndexes) {
+        movedTracks.push_back(m_tracks.at(index));
+    }
+    movedTracks = TrackSorter::sortTracks(movedTracks);
+
+    // First index of the run of consecutive changed indexes each changed index is part of
+    std::vector<size_t> runStarts(changedIndexes.size());
+    for(size_t i{0}; i < changedIndexes.size(); ++i) {
+        const bool continuesRun = i > 0 && changedIndexes.at(i - 1) + 1 == changedIndexes.at(i);
+        runStarts[i]            = continuesRun ? runStarts.at(i - 1) : changedIndexes.at(i);
+    }
+
+    // Returns the closest unchanged track at or before index, if any
+    const auto unchangedTrackAt = [this, &changedIndexes, &runStarts](size_t index) -> const Track* {
+        const auto it = std::ranges::lower_bound(changedIndexes, index);
+        if(it != changedIndexes.cend() && *it == index) {
+            const size_t runStart = runStarts.at(std::distance(changedIndexes.cbegin(), it));
+            if(runStart == 0) {
+                return nullptr;
+            }
+            index = runStart - 1;
+        }
+        return &m_tracks.at(index);
+    };
+
+    const StringCollator collator;
+
+    // Returns the index of the first unchanged track sorted after track
+    const auto insertPosition = [this, &unchangedTrackAt, &collator](const Track& track) {
+        size_t low{0};
+        size_t high{m_tracks.size()};
+
+        while(low < high) {
+            const size_t mid       = low + ((high - low) / 2);
+            const Track* unchanged = unchangedTrackAt(mid);
+            if(!unchanged || collator.compare(track.sort(), unchanged->sort()) >= 0) {
+                low = mid + 1;
+            }
+            else {
+                high = mid;
+            }
+        }
+
+        return low;
+    };
+
+    // The rest of the library is already sorted, and tracks outside of the old and new positions of the
+    // changed tracks keep their indexes, so only that span needs to be merged and re-indexed
+    const size_t spanStart = std::min(changedIndexes.front(), insertPosition(movedTracks.front()));
+    const size_t spanEnd   = std::max(changedIndexes.back() + 1, insertPosition(movedTracks.back()));
+
+    TrackList unchangedTracks;
+    unchangedTracks.reserve(spanEnd - spanStart - changedIndexes.size());
+
+    auto changedIt = changedIndexes.cbegin();
+    for(size_t i{spanStart}; i < spanEnd; ++i) {
+        if(changedIt != changedIndexes.cend() && *changedIt == i) {
+            ++changedIt;
+        }
+        else {
+            unchangedTracks.push_back(m_tracks.at(i));
         }
     }
+
+    const TrackList spanTracks = TrackSorter::mergeTracks(unchangedTracks, movedTracks);
+    std::ranges::copy(spanTracks, m_tracks.begin() + static_cast<std::ptrdiff_t>(spanStart));
+
+    for(size_t i{spanStart}; i < spanEnd; ++i) {
+        m_trackIndexes[m_tracks.at(i).id()] = i;
+    }
 }
 
 QFuture<void> UnifiedMusicLibraryPrivate::updateTracksMetadata(const TrackList& tracksToUpdate)
@@ -145,11 +328,11 @@ QFuture<void> UnifiedMusicLibraryPrivate::updateTracksMetadata(const TrackList&
 
     return sortTracks.then(m_self, [this](const TrackList& sortedTracks) {
         updateLibraryTracks(sortedTracks);
+        m_searchIndex->insertTracks(sortedTracks);
+        resortChangedTracks(sortedTracks);
 
-        resortTracks(m_tracks).then(m_self, [this, sortedTracks](const TrackList& sortedLibraryTracks) {
-            m_tracks = sortedLibraryTracks;
-            emit m_self->tracksMetadataChanged(sortedTracks);
-        });
+        emit m_self->tracksMetadataChanged(sortedTracks);
+        schedulePurge();
     });
 }
 
@@ -159,11 +342,9 @@ QFuture<void> UnifiedMusicLibraryPrivate::updateTracks(const TrackList& tracksTo
 
     return sortTracks.then(m_self, [this](const TrackList& sortedTracks) {
         updateLibraryTracks(sortedTracks);
+        resortChangedTracks(sortedTracks);
 
-        resortTracks(m_tracks).then(m_self, [this, sortedTracks](const TrackList& sortedLibraryTracks) {
-            m_tracks = sortedLibraryTracks;
-            emit m_self->tracksUpdated(sortedTracks);
-        });
+        emit m_self->tracksUpdated(sortedTracks);
     });
 }
 
@@ -180,9 +361,20 @@ void UnifiedMusicLibraryPrivate::removeTracks(const TrackList& tracksToRemove)
         }
     }
 
-    m_tracks = std::move(remainingTracks);
+    setTracks(remainingTracks);
+    m_searchIndex->removeTracks(tracksToRemove);
 
     emit m_self->tracksDeleted(tracksToRemove);
+
+    schedulePurge();
+}
+
+void UnifiedMusicLibraryPrivate::schedulePurge()
+{
+    // Don't restart an active timer, so a steady stream of changes can't postpone the purge indefinitely
+    if(!m_purgeTimer.isActive()) {
+        m_purgeTimer.start(PurgeInterval, m_self);
+    }
 }
 
 void UnifiedMusicLibraryPrivate::handleScanResult(const ScanResult& result)
@@ -232,15 +424,17 @@ void UnifiedMusicLibraryPrivate::removeLibrary(const LibraryInfo& library, const
             }
             track.setLibraryId(-1);
             updatedTracks.push_back(track);
-            newTracks.push_back(track);
         }
         newTracks.push_back(track);
     }
 
-    m_tracks = newTracks;
+    setTracks(newTracks);
+    m_searchIndex->removeTracks(removedTracks);
 
     emit m_self->tracksDeleted(removedTracks);
     emit m_self->tracksMetadataChanged(updatedTracks);
+
+    schedulePurge();
 }
 
 void UnifiedMusicLibraryPrivate::libraryStatusChanged(const LibraryInfo& library) const
@@ -250,8 +444,9 @@ void UnifiedMusicLibraryPrivate::libraryStatusChanged(const LibraryInfo& library
 
 void UnifiedMusicLibraryPrivate::changeSort(const QString& sort)
 {
-    recalSortTracks(sort, m_tracks).then(m_self, [this](const TrackList& sortedTracks) {
-        m_tracks = sortedTracks;
+    recalSortTracks(sort, m_tracks).then(m_self, [this, sort](const TrackList& sortedTracks) {
+        setTracks(sortedTracks);
+        storeSortCache(sort, m_tracks);
         emit m_self->tracksSorted(m_tracks);
     });
 }
@@ -261,11 +456,6 @@ QFuture<TrackList> UnifiedMusicLibraryPrivate::recalSortTracks(const QString& so
     return Utils::asyncExec([this, sort, tracks]() { return m_sorter.calcSortTracks(sort, tracks); });
 }
 
-QFuture<TrackList> UnifiedMusicLibraryPrivate::resortTracks(const TrackList& tracks)
-{
-    return Utils::asyncExec([tracks]() { return TrackSorter::sortTracks(tracks); });
-}
-
 void UnifiedMusicLibraryPrivate::handleTracksLoaded()
 {
     m_threadHandler.setupWatchers(m_libraryManager->allLibraries(),
@@ -401,9 +591,8 @@ TrackList UnifiedMusicLibrary::tracks() const
 
 Track UnifiedMusicLibrary::trackForId(int id) const
 {
-    auto trackIt = std::ranges::find_if(p->m_tracks, [id](const Track& track) { return track.id() == id; });
-    if(trackIt != p->m_tracks.cend()) {
-        return *trackIt;
+    if(const Track* track = p->findTrack(id)) {
+        return *track;
     }
     return {};
 }
@@ -414,15 +603,19 @@ TrackList UnifiedMusicLibrary::tracksForIds(const TrackIds& ids) const
     tracks.reserve(ids.size());
 
     for(const int id : ids) {
-        auto trackIt = std::ranges::find_if(p->m_tracks, [id](const Track& track) { return track.id() == id; });
-        if(trackIt != p->m_tracks.cend()) {
-            tracks.push_back(*trackIt);
+        if(const Track* track = p->findTrack(id)) {
+            tracks.push_back(*track);
         }
     }
 
     return tracks;
 }
 
+std::shared_ptr<const TrackSearchIndex> UnifiedMusicLibrary::searchIndex() const
+{
+    return p->m_searchIndex;
+}
+
 void UnifiedMusicLibrary::updateTrack(const Track& track)
 {
     updateTracks({track});
@@ -488,6 +681,16 @@ WriteRequest UnifiedMusicLibrary::removeUnavailbleTracks()
 {
     return p->m_threadHandler.removeUnavailbleTracks(p->m_tracks);
 }
+
+void UnifiedMusicLibrary::timerEvent(QTimerEvent* event)
+{
+    if(event->timerId() == p->m_purgeTimer.timerId()) {
+        p->m_purgeTimer.stop();
+        StringPool::global().purge();
+    }
+
+    MusicLibrary::timerEvent(event);
+}
 } // namespace Fooyin
 
 #include "moc_unifiedmusiclibrary.cpp"
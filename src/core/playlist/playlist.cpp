@@ -19,6 +19,8 @@
 
 #include <core/playlist/playlist.h>
 
+#include "scripting/scriptcache.h"
+
 #include <core/coresettings.h>
 #include <core/library/tracksort.h>
 #include <core/scripting/scriptparser.h>
@@ -29,11 +31,60 @@
 #include <random>
 #include <ranges>
 #include <set>
+#include <unordered_set>
 
 using namespace Qt::StringLiterals;
 
 namespace {
 using AlbumTracks = std::vector<int>;
+
+// Beyond this, saving the whole playlist is likely cheaper than replaying every edit
+constexpr size_t MaxTrackEdits = 50;
+
+bool sameStoredTrack(const Fooyin::Track& lhs, const Fooyin::Track& rhs)
+{
+    return lhs.id() == rhs.id();
+}
+
+/*!
+ * Returns the offset k (> 0) if newTracks[start, start + count) is oldTracks[start, start + count)
+ * rotated left by k, else 0.
+ */
+int rotationOffset(const Fooyin::TrackList& oldTracks, const Fooyin::TrackList& newTracks, int start, int count)
+{
+    for(int offset{1}; offset < count; ++offset) {
+        if(!sameStoredTrack(oldTracks.at(start + offset), newTracks.at(start))) {
+            continue;
+        }
+
+        bool rotated{true};
+        for(int i{0}; i < count && rotated; ++i) {
+            rotated = sameStoredTrack(newTracks.at(start + i), oldTracks.at(start + ((offset + i) % count)));
+        }
+
+        if(rotated) {
+            return offset;
+        }
+    }
+
+    return 0;
+}
+
+bool containsExpression(const Fooyin::ExpressionList& expressions, const auto& predicate)
+{
+    return std::ranges::any_of(expressions, [&predicate](const Fooyin::Expression& expr) {
+        if(predicate(expr)) {
+            return true;
+        }
+        if(const auto* args = std::get_if<Fooyin::ExpressionList>(&expr.value)) {
+            return containsExpression(*args, predicate);
+        }
+        if(const auto* func = std::get_if<Fooyin::FuncValue>(&expr.value)) {
+            return containsExpression(func->args, predicate);
+        }
+        return false;
+    });
+}
 } // namespace
 
 namespace Fooyin {
@@ -134,6 +185,11 @@ public:
     int getNextIndex(int delta, Playlist::PlayModes mode, bool onlyCheck);
     [[nodiscard]] std::optional<Track> getTrack(int index) const;
 
+    void recordTrackChanges(const TrackList& oldTracks, const TrackList& newTracks);
+    void addTrackEdit(PlaylistTrackEdit edit);
+
+    void parseQuery();
+
     UId m_id;
     int m_dbId{-1};
     QString m_name;
@@ -156,9 +212,12 @@ public:
     bool m_isTemporary{false};
     bool m_modified{false};
     bool m_tracksModified{false};
+    std::vector<PlaylistTrackEdit> m_trackEdits;
 
     bool m_isAutoPlaylist{false};
     QString m_query;
+    ParsedScript m_queryScript;
+    bool m_canPatch{false};
 };
 
 PlaylistPrivate::PlaylistPrivate(int dbId, QString name, int index, SettingsManager* settings)
@@ -488,6 +547,81 @@ std::optional<Track> PlaylistPrivate::getTrack(int index) const
     return m_tracks.at(index);
 }
 
+void PlaylistPrivate::recordTrackChanges(const TrackList& oldTracks, const TrackList& newTracks)
+{
+    const auto oldSize = static_cast<int>(oldTracks.size());
+    const auto newSize = static_cast<int>(newTracks.size());
+
+    int prefix{0};
+    while(prefix < oldSize && prefix < newSize && sameStoredTrack(oldTracks.at(prefix), newTracks.at(prefix))) {
+        ++prefix;
+    }
+
+    int suffix{0};
+    while(suffix < oldSize - prefix && suffix < newSize - prefix
+          && sameStoredTrack(oldTracks.at(oldSize - suffix - 1), newTracks.at(newSize - suffix - 1))) {
+        ++suffix;
+    }
+
+    const int removed  = oldSize - prefix - suffix;
+    const int inserted = newSize - prefix - suffix;
+
+    if(removed == inserted && removed > 0) {
+        if(const int offset = rotationOffset(oldTracks, newTracks, prefix, removed); offset > 0) {
+            addTrackEdit({.type        = PlaylistTrackEdit::Type::Move,
+                          .index       = prefix,
+                          .count       = offset,
+                          .destination = prefix + removed - offset});
+            return;
+        }
+    }
+
+    if(removed > 0) {
+        addTrackEdit({.type = PlaylistTrackEdit::Type::Remove, .index = prefix, .count = removed});
+    }
+    if(inserted > 0) {
+        addTrackEdit({.type   = PlaylistTrackEdit::Type::Insert,
+                      .index  = prefix,
+                      .count  = inserted,
+                      .tracks = {newTracks.cbegin() + prefix, newTracks.cbegin() + prefix + inserted}});
+    }
+}
+
+void PlaylistPrivate::addTrackEdit(PlaylistTrackEdit edit)
+{
+    if(!m_trackEdits.empty() && m_trackEdits.front().type == PlaylistTrackEdit::Type::Reset) {
+        return;
+    }
+
+    if(edit.type == PlaylistTrackEdit::Type::Reset || m_trackEdits.size() >= MaxTrackEdits) {
+        m_trackEdits.assign(1, {.type = PlaylistTrackEdit::Type::Reset});
+        return;
+    }
+
+    if(!m_trackEdits.empty()) {
+        auto& lastEdit = m_trackEdits.back();
+        // Merge removals of neighbouring tracks (removed from back to front)
+        if(edit.type == PlaylistTrackEdit::Type::Remove && lastEdit.type == PlaylistTrackEdit::Type::Remove
+           && lastEdit.index == edit.index + edit.count) {
+            lastEdit.index = edit.index;
+            lastEdit.count += edit.count;
+            return;
+        }
+    }
+
+    m_trackEdits.push_back(std::move(edit));
+}
+
+void PlaylistPrivate::parseQuery()
+{
+    m_queryScript = m_parser.parseQuery(m_query);
+
+    // A limit depends on every track before a match, and relative dates on the time of evaluation
+    m_canPatch = m_queryScript.isValid() && !containsExpression(m_queryScript.expressions, [](const Expression& expr) {
+        return expr.type == Expr::Limit || expr.type == Expr::During;
+    });
+}
+
 Playlist::Playlist(PrivateKey /*key*/, int dbId, QString name, int index, SettingsManager* settings)
     : p{std::make_unique<PlaylistPrivate>(dbId, std::move(name), index, settings)}
 { }
@@ -592,6 +726,7 @@ bool Playlist::regenerateTracks(const TrackList& tracks)
     }
 
     // In case current date in previous query is cached
+    ScriptCache::shared().remove(p->m_query);
     p->m_parser.clearCache();
     const TrackList filteredTracks = p->m_parser.filter(p->m_query, tracks);
 
@@ -603,6 +738,57 @@ bool Playlist::regenerateTracks(const TrackList& tracks)
     return false;
 }
 
+bool Playlist::canPatchTracks() const
+{
+    return isAutoPlaylist() && p->m_canPatch;
+}
+
+bool Playlist::patchTracks(const TrackList& changedTracks, const TrackList& removedTracks)
+{
+    if(!isAutoPlaylist() || (changedTracks.empty() && removedTracks.empty())) {
+        return false;
+    }
+
+    const ParsedScript& script = p->m_queryScript;
+
+    std::unordered_set<int> changedIds;
+    for(const Track& track : changedTracks) {
+        changedIds.emplace(track.id());
+    }
+    for(const Track& track : removedTracks) {
+        changedIds.emplace(track.id());
+    }
+
+    TrackList keptTracks;
+    keptTracks.reserve(p->m_tracks.size());
+    std::ranges::copy_if(p->m_tracks, std::back_inserter(keptTracks),
+                         [&changedIds](const Track& track) { return !changedIds.contains(track.id()); });
+
+    // Matches are sorted by the query's sort (if any), otherwise they keep the sort fields of the library.
+    // Kept tracks share those fields, as autoplaylists are regenerated whenever the library is resorted.
+    TrackList matchedTracks = p->m_parser.filter(script, changedTracks);
+    Qt::SortOrder order{Qt::AscendingOrder};
+
+    const auto sortExpr = std::ranges::find_if(script.expressions, [](const Expression& expr) {
+        return expr.type == Expr::SortAscending || expr.type == Expr::SortDescending;
+    });
+    if(sortExpr != script.expressions.cend()) {
+        order = sortExpr->type == Expr::SortAscending ? Qt::AscendingOrder : Qt::DescendingOrder;
+    }
+    else {
+        matchedTracks = TrackSorter::sortTracks(matchedTracks);
+    }
+
+    const TrackList patchedTracks = TrackSorter::mergeTracks(keptTracks, matchedTracks, order);
+
+    if(patchedTracks != p->m_tracks) {
+        replaceTracks(patchedTracks);
+        return true;
+    }
+
+    return false;
+}
+
 int Playlist::nextIndex(int delta, PlayModes mode)
 {
     return p->getNextIndex(delta, mode, true);
@@ -652,6 +838,7 @@ void Playlist::resetFlags()
 {
     p->m_modified       = false;
     p->m_tracksModified = false;
+    p->m_trackEdits.clear();
 }
 
 QStringList Playlist::supportedPlaylistExtensions()
@@ -699,6 +886,7 @@ void Playlist::setQuery(const QString& query)
 {
     if(std::exchange(p->m_query, query) != query) {
         p->m_modified = true;
+        p->parseQuery();
     }
 }
 
@@ -710,11 +898,25 @@ void Playlist::setModified(bool modified)
 void Playlist::setTracksModified(bool modified)
 {
     p->m_tracksModified = modified;
+
+    if(modified) {
+        p->addTrackEdit({.type = PlaylistTrackEdit::Type::Reset});
+    }
+    else {
+        p->m_trackEdits.clear();
+    }
+}
+
+const std::vector<PlaylistTrackEdit>& Playlist::trackEdits() const
+{
+    return p->m_trackEdits;
 }
 
 void Playlist::replaceTracks(const TrackList& tracks)
 {
-    if(std::exchange(p->m_tracks, tracks) != tracks) {
+    if(p->m_tracks != tracks) {
+        p->recordTrackChanges(p->m_tracks, tracks);
+        p->m_tracks         = tracks;
         p->m_tracksModified = true;
         p->m_trackShuffleOrder.clear();
         p->m_albumShuffleOrder.clear();
@@ -727,6 +929,11 @@ void Playlist::appendTracks(const TrackList& tracks)
         return;
     }
 
+    p->addTrackEdit({.type   = PlaylistTrackEdit::Type::Insert,
+                     .index  = static_cast<int>(p->m_tracks.size()),
+                     .count  = static_cast<int>(tracks.size()),
+                     .tracks = tracks});
+
     std::ranges::copy(tracks, std::back_inserter(p->m_tracks));
     p->m_tracksModified = true;
     p->m_trackShuffleOrder.clear();
@@ -740,6 +947,10 @@ void Playlist::updateTrackAtIndex(int index, const Track& track)
     }
 
     if(p->m_tracks.at(index).uniqueFilepath() == track.uniqueFilepath()) {
+        if(!sameStoredTrack(p->m_tracks.at(index), track)) {
+            p->addTrackEdit({.type = PlaylistTrackEdit::Type::Remove, .index = index, .count = 1});
+            p->addTrackEdit({.type = PlaylistTrackEdit::Type::Insert, .index = index, .count = 1, .tracks = {track}});
+        }
         p->m_tracks[index] = track;
     }
 }
@@ -802,6 +1013,7 @@ std::vector<int> Playlist::removeTracks(const std::vector<int>& indexes)
 
         p->m_tracks.erase(p->m_tracks.begin() + index);
         removedIndexes.emplace_back(index);
+        p->addTrackEdit({.type = PlaylistTrackEdit::Type::Remove, .index = index, .count = 1});
 
         std::erase_if(p->m_trackShuffleOrder, [index](int num) { return num == index; });
         for(auto& num : p->m_trackShuffleOrder) {
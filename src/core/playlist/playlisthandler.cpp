@@ -35,6 +35,7 @@
 #include <QFileInfo>
 #include <QLoggingCategory>
 
+#include <optional>
 #include <ranges>
 #include <utility>
 
@@ -54,7 +55,8 @@ public:
 
     void reloadPlaylists();
     void populatePlaylists();
-    void regenerateAutoPlaylists();
+    void updateAutoPlaylists(const TrackList& changedTracks, const TrackList& removedTracks);
+    void regenerateAutoPlaylists(const TrackList& tracks);
     bool noConcretePlaylists();
 
     void handleTracksChanged(const TrackList& tracks);
@@ -137,8 +139,11 @@ void PlaylistHandlerPrivate::populatePlaylists()
             playlist->regenerateTracks(tracks);
         }
         else {
-            const TrackList playlistTracks = m_playlistConnector.getPlaylistTracks(*playlist, idTracks);
+            bool indexesValid{false};
+            const TrackList playlistTracks = m_playlistConnector.getPlaylistTracks(*playlist, idTracks, indexesValid);
             playlist->replaceTracks(playlistTracks);
+            // Only later edits need saving, unless the stored indexes need rewriting
+            playlist->setTracksModified(!indexesValid);
         }
     }
 
@@ -147,11 +152,36 @@ void PlaylistHandlerPrivate::populatePlaylists()
     emit m_self->playlistsPopulated();
 }
 
-void PlaylistHandlerPrivate::regenerateAutoPlaylists()
+void PlaylistHandlerPrivate::updateAutoPlaylists(const TrackList& changedTracks, const TrackList& removedTracks)
+{
+    std::optional<TrackList> libraryTracks;
+
+    for(auto& playlist : m_playlists) {
+        if(!playlist->isAutoPlaylist()) {
+            continue;
+        }
+
+        bool changed{false};
+        if(playlist->canPatchTracks()) {
+            changed = playlist->patchTracks(changedTracks, removedTracks);
+        }
+        else {
+            if(!libraryTracks) {
+                libraryTracks = m_library->tracks();
+            }
+            changed = playlist->regenerateTracks(libraryTracks.value());
+        }
+
+        if(changed) {
+            emit m_self->tracksChanged(playlist.get(), {});
+        }
+    }
+}
+
+void PlaylistHandlerPrivate::regenerateAutoPlaylists(const TrackList& tracks)
 {
-    const TrackList tracks = m_library->tracks();
     for(auto& playlist : m_playlists) {
-        if(playlist->regenerateTracks(tracks)) {
+        if(playlist->isAutoPlaylist() && playlist->regenerateTracks(tracks)) {
             emit m_self->tracksChanged(playlist.get(), {});
         }
     }
@@ -443,16 +473,21 @@ PlaylistHandler::PlaylistHandler(DbConnectionPoolPtr dbPool, std::shared_ptr<Aud
     }
 
     QObject::connect(p->m_library, &MusicLibrary::tracksLoaded, this, [this]() { p->populatePlaylists(); });
-    QObject::connect(p->m_library, &MusicLibrary::tracksAdded, this, [this]() { p->regenerateAutoPlaylists(); });
-    QObject::connect(p->m_library, &MusicLibrary::tracksDeleted, this, [this]() { p->regenerateAutoPlaylists(); });
+    QObject::connect(p->m_library, &MusicLibrary::tracksAdded, this,
+                     [this](const TrackList& tracks) { p->updateAutoPlaylists(tracks, {}); });
+    QObject::connect(p->m_library, &MusicLibrary::tracksDeleted, this,
+                     [this](const TrackList& tracks) { p->updateAutoPlaylists({}, tracks); });
     QObject::connect(p->m_library, &MusicLibrary::tracksMetadataChanged, this, [this](const TrackList& tracks) {
         p->handleTracksChanged(tracks);
-        p->regenerateAutoPlaylists();
+        p->updateAutoPlaylists(tracks, {});
     });
     QObject::connect(p->m_library, &MusicLibrary::tracksUpdated, this, [this](const TrackList& tracks) {
         p->handleTracksUpdated(tracks);
-        p->regenerateAutoPlaylists();
+        p->updateAutoPlaylists(tracks, {});
     });
+    // Patching autoplaylists relies on their tracks having the library's current sort fields
+    QObject::connect(p->m_library, &MusicLibrary::tracksSorted, this,
+                     [this](const TrackList& tracks) { p->regenerateAutoPlaylists(tracks); });
 
     p->m_settings->subscribe<Settings::Core::ShuffleAlbumsGroupScript>(this, [this]() { p->resetShuffleOrder(); });
     p->m_settings->subscribe<Settings::Core::ShuffleAlbumsSortScript>(this, [this]() { p->resetShuffleOrder(); });
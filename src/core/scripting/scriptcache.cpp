@@ -19,79 +19,130 @@
 
 #include "scriptcache.h"
 
-constexpr auto DefaultLimit = 20;
+constexpr auto DefaultLimit = 256;
 
 namespace Fooyin {
 ScriptCache::ScriptCache()
-    : m_cacheLimit{DefaultLimit}
+    : m_limit{DefaultLimit}
+    , m_hits{0}
+    , m_misses{0}
 { }
 
-ParsedScript& ScriptCache::operator[](const QString& key)
+ScriptCache& ScriptCache::shared()
 {
-    auto it = m_parsedScripts.find(key);
-    if(it != m_parsedScripts.end()) {
-        auto orderIt = std::ranges::find(m_order, key);
-        if(orderIt != m_order.cend()) {
-            m_order.erase(orderIt);
-        }
-        m_order.push_back(key);
-        return it->second;
+    static ScriptCache cache;
+    return cache;
+}
+
+std::optional<ParsedScript> ScriptCache::get(const QString& input, Type type)
+{
+    const Key key{.input = input, .type = type};
+    auto& cacheShard = shard(key);
+
+    const std::scoped_lock lock{cacheShard.mutex};
+
+    const auto it = cacheShard.index.find(key);
+    if(it == cacheShard.index.end()) {
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        return {};
     }
 
-    insert(key, {});
-    return m_parsedScripts.at(key);
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+    cacheShard.entries.splice(cacheShard.entries.begin(), cacheShard.entries, it->second);
+
+    return it->second->script;
 }
 
-bool ScriptCache::contains(const QString& key) const
+void ScriptCache::insert(const QString& input, Type type, const ParsedScript& script)
 {
-    return m_parsedScripts.contains(key);
+    Key key{.input = input, .type = type};
+    auto& cacheShard = shard(key);
+
+    const std::scoped_lock lock{cacheShard.mutex};
+
+    if(const auto it = cacheShard.index.find(key); it != cacheShard.index.end()) {
+        it->second->script = script;
+        cacheShard.entries.splice(cacheShard.entries.begin(), cacheShard.entries, it->second);
+        return;
+    }
+
+    cacheShard.entries.push_front({.key = key, .script = script});
+    cacheShard.index.emplace(std::move(key), cacheShard.entries.begin());
+
+    trim(cacheShard, shardLimit());
 }
 
-ParsedScript ScriptCache::get(const QString& key) const
+void ScriptCache::remove(const QString& input)
 {
-    if(m_parsedScripts.contains(key)) {
-        return m_parsedScripts.at(key);
+    for(const Type type : {Type::Format, Type::Query}) {
+        const Key key{.input = input, .type = type};
+        auto& cacheShard = shard(key);
+
+        const std::scoped_lock lock{cacheShard.mutex};
+
+        if(const auto it = cacheShard.index.find(key); it != cacheShard.index.end()) {
+            cacheShard.entries.erase(it->second);
+            cacheShard.index.erase(it);
+        }
     }
-    return {};
 }
 
-void ScriptCache::insert(const QString& key, const ParsedScript& script)
+int ScriptCache::limit() const
 {
-    auto it = m_parsedScripts.find(key);
-    if(it != m_parsedScripts.end()) {
-        it->second = script;
+    return m_limit.load(std::memory_order_relaxed);
+}
 
-        auto orderIt = std::ranges::find(m_order, key);
-        if(orderIt != m_order.cend()) {
-            m_order.erase(orderIt);
-        }
-        m_order.push_back(key);
+void ScriptCache::setLimit(int limit)
+{
+    m_limit.store(std::max(limit, 1), std::memory_order_relaxed);
+
+    const size_t perShard = shardLimit();
+    for(auto& cacheShard : m_shards) {
+        const std::scoped_lock lock{cacheShard.mutex};
+        trim(cacheShard, perShard);
     }
-    else {
-        m_order.push_back(key);
-        m_parsedScripts[key] = script;
+}
+
+void ScriptCache::clear()
+{
+    for(auto& cacheShard : m_shards) {
+        const std::scoped_lock lock{cacheShard.mutex};
+        cacheShard.index.clear();
+        cacheShard.entries.clear();
     }
+}
+
+ScriptCacheStats ScriptCache::stats() const
+{
+    ScriptCacheStats stats;
+    stats.hits   = m_hits.load(std::memory_order_relaxed);
+    stats.misses = m_misses.load(std::memory_order_relaxed);
+    stats.limit  = limit();
 
-    if(std::cmp_greater(m_parsedScripts.size(), m_cacheLimit)) {
-        const QString& oldestKey = m_order.front();
-        m_order.erase(m_order.begin());
-        m_parsedScripts.erase(oldestKey);
+    for(const auto& cacheShard : m_shards) {
+        const std::scoped_lock lock{cacheShard.mutex};
+        stats.size += static_cast<int>(cacheShard.index.size());
     }
+
+    return stats;
 }
 
-int ScriptCache::limit() const
+ScriptCache::Shard& ScriptCache::shard(const Key& key)
 {
-    return m_cacheLimit;
+    return m_shards.at(KeyHash{}(key) % ShardCount);
 }
 
-void ScriptCache::setLimit(int limit)
+size_t ScriptCache::shardLimit() const
 {
-    m_cacheLimit = limit;
+    // Round up so the total capacity is never below the requested limit
+    return (static_cast<size_t>(limit()) + ShardCount - 1) / ShardCount;
 }
 
-void ScriptCache::clear()
+void ScriptCache::trim(Shard& shard, size_t limit)
 {
-    m_parsedScripts.clear();
-    m_order.clear();
+    while(shard.entries.size() > limit) {
+        shard.index.erase(shard.entries.back().key);
+        shard.entries.pop_back();
+    }
 }
 } // namespace Fooyin
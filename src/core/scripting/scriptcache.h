@@ -21,25 +21,81 @@
 
 #include <core/scripting/scriptparser.h>
 
+#include <array>
+#include <atomic>
+#include <list>
+#include <mutex>
+
 namespace Fooyin {
+/*!
+ * Least-recently-used cache of parsed scripts.
+ * The cache is split into independently locked shards so parsers on different threads can share it.
+ * Lookups and inserts are O(1).
+ */
 class ScriptCache
 {
 public:
+    enum class Type : uint8_t
+    {
+        Format = 0,
+        Query,
+    };
+
     ScriptCache();
 
-    ParsedScript& operator[](const QString& key);
+    /** Returns the cache shared by all ScriptParser instances. */
+    static ScriptCache& shared();
 
-    bool contains(const QString& key) const;
-    ParsedScript get(const QString& key) const;
-    void insert(const QString& key, const ParsedScript& script);
+    [[nodiscard]] std::optional<ParsedScript> get(const QString& input, Type type);
+    void insert(const QString& input, Type type, const ParsedScript& script);
+    /** Removes any parsed script for @p input, of either type. */
+    void remove(const QString& input);
 
     [[nodiscard]] int limit() const;
     void setLimit(int limit);
     void clear();
 
+    [[nodiscard]] ScriptCacheStats stats() const;
+
 private:
-    std::unordered_map<QString, ParsedScript> m_parsedScripts;
-    std::vector<QString> m_order;
-    int m_cacheLimit;
+    static constexpr size_t ShardCount = 8;
+
+    struct Key
+    {
+        QString input;
+        Type type;
+
+        bool operator==(const Key& other) const = default;
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const noexcept
+        {
+            return qHash(key.input, static_cast<size_t>(key.type));
+        }
+    };
+
+    struct Entry
+    {
+        Key key;
+        ParsedScript script;
+    };
+
+    struct Shard
+    {
+        mutable std::mutex mutex;
+        std::list<Entry> entries;
+        std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+    };
+
+    Shard& shard(const Key& key);
+    [[nodiscard]] size_t shardLimit() const;
+    static void trim(Shard& shard, size_t limit);
+
+    std::array<Shard, ShardCount> m_shards;
+    std::atomic<int> m_limit;
+    std::atomic<uint64_t> m_hits;
+    std::atomic<uint64_t> m_misses;
 };
 } // namespace Fooyin
@@ -20,8 +20,10 @@
 #include <core/scripting/scriptparser.h>
 
 #include "scriptcache.h"
+#include "scriptprogram.h"
 
 #include <core/constants.h>
+#include <core/library/tracksearchindex.h>
 #include <core/library/tracksort.h>
 #include <core/scripting/scriptscanner.h>
 #include <core/track.h>
@@ -35,6 +37,8 @@ using namespace Qt::StringLiterals;
 
 using TokenType = Fooyin::ScriptScanner::TokenType;
 
+constexpr auto MaxPrograms = 100;
+
 namespace {
 QDateTime evalDate(const Fooyin::Expression& expr)
 {
@@ -112,7 +116,7 @@ QStringList evalStringList(const Fooyin::ScriptResult& evalExpr, const QStringLi
     return listResult;
 }
 
-bool matchSearch(const Fooyin::Track& track, const QString& search, bool singleString)
+bool matchTrack(const Fooyin::Track& track, const QString& search, bool singleString)
 {
     if(search.isEmpty()) {
         return true;
@@ -220,12 +224,14 @@ public:
     ScriptResult evalEquals(const Expression& exp, const auto& tracks);
     ScriptResult evalContains(const Expression& exp, const auto& tracks);
     ScriptResult evalContains(const Expression& exp, const Track& track);
+    [[nodiscard]] bool matchSearch(const Track& track, const QString& search, bool singleString) const;
     ScriptResult evalLimit(const Expression& exp);
     ScriptResult evalSort(const Expression& exp);
 
     ParsedScript parse(const QString& input);
     ParsedScript parseQuery(const QString& input);
     QString evaluate(const ParsedScript& input, const auto& tracks);
+    const ScriptProgram* program(const ParsedScript& input);
 
     template <typename TrackListType>
     TrackListType evaluateQuery(const ParsedScript& input, const TrackListType& tracks);
@@ -241,6 +247,7 @@ public:
 
     ScriptScanner m_scanner;
     std::unique_ptr<ScriptRegistry> m_registry;
+    std::shared_ptr<const TrackSearchIndex> m_searchIndex;
 
     ScriptScanner::Token m_current;
     ScriptScanner::Token m_previous;
@@ -248,9 +255,13 @@ public:
     bool m_isQuery{false};
     QString m_currentInput;
     ParsedScript m_currentScript;
-    ScriptCache m_cache;
     QStringList m_currentResult;
 
+    bool m_compileScripts{true};
+    std::unordered_map<QString, std::optional<ScriptProgram>> m_programs;
+    QString m_lastProgramInput;
+    const ScriptProgram* m_lastProgram{nullptr};
+
     QString m_sortScript;
     Qt::SortOrder m_sortOrder{Qt::AscendingOrder};
     int m_limit{0};
@@ -1203,6 +1214,15 @@ ScriptResult ScriptParserPrivate::evalContains(const Expression& exp, const Trac
     return result;
 }
 
+bool ScriptParserPrivate::matchSearch(const Track& track, const QString& search, bool singleString) const
+{
+    if(m_searchIndex) {
+        return m_searchIndex->hasMatch(track, TrackSearchIndex::searchTerms(search, singleString));
+    }
+
+    return matchTrack(track, search, singleString);
+}
+
 ScriptResult ScriptParserPrivate::evalLimit(const Expression& exp)
 {
     ScriptResult result;
@@ -1243,8 +1263,8 @@ ParsedScript ScriptParserPrivate::parse(const QString& input)
     m_scanner.setSkipWhitespace(false);
     m_currentScript = {};
 
-    if(m_cache.contains(input)) {
-        return m_cache.get(input);
+    if(auto cached = ScriptCache::shared().get(input, ScriptCache::Type::Format)) {
+        return cached.value();
     }
 
     m_currentInput        = input;
@@ -1262,7 +1282,7 @@ ParsedScript ScriptParserPrivate::parse(const QString& input)
     }
 
     consume(TokenType::TokEos, QObject::tr("Expected end of script"));
-    m_cache.insert(input, m_currentScript);
+    ScriptCache::shared().insert(input, ScriptCache::Type::Format, m_currentScript);
 
     return m_currentScript;
 }
@@ -1277,8 +1297,8 @@ ParsedScript ScriptParserPrivate::parseQuery(const QString& input)
     m_scanner.setSkipWhitespace(true);
     m_currentScript = {};
 
-    if(m_cache.contains(input)) {
-        return m_cache.get(input);
+    if(auto cached = ScriptCache::shared().get(input, ScriptCache::Type::Query)) {
+        return cached.value();
     }
 
     m_currentInput        = input;
@@ -1301,7 +1321,7 @@ ParsedScript ScriptParserPrivate::parseQuery(const QString& input)
     }
 
     consume(TokenType::TokEos, QObject::tr("Expected end of script"));
-    m_cache.insert(input, m_currentScript);
+    ScriptCache::shared().insert(input, ScriptCache::Type::Query, m_currentScript);
 
     return m_currentScript;
 }
@@ -1352,6 +1372,31 @@ QString ScriptParserPrivate::evaluate(const ParsedScript& input, const auto& tra
     return {};
 }
 
+const ScriptProgram* ScriptParserPrivate::program(const ParsedScript& input)
+{
+    if(m_lastProgram && input.input == m_lastProgramInput) {
+        return m_lastProgram;
+    }
+
+    auto it = m_programs.find(input.input);
+    if(it == m_programs.end()) {
+        if(std::cmp_greater_equal(m_programs.size(), MaxPrograms)) {
+            m_programs.clear();
+            m_lastProgram = nullptr;
+        }
+        it = m_programs.emplace(input.input, ScriptProgram::compile(input, m_registry.get())).first;
+    }
+
+    if(!it->second) {
+        return nullptr;
+    }
+
+    m_lastProgramInput = input.input;
+    m_lastProgram      = &it->second.value();
+
+    return m_lastProgram;
+}
+
 template <typename TrackListType>
 TrackListType ScriptParserPrivate::evaluateQuery(const ParsedScript& input, const TrackListType& tracks)
 {
@@ -1367,12 +1412,26 @@ TrackListType ScriptParserPrivate::evaluateQuery(const ParsedScript& input, cons
         if(firstExpr.type == Expr::Literal || firstExpr.type == Expr::QuotedLiteral) {
             // Simple search query - just match all terms in metadata/filepath
             const QString search = std::get<QString>(firstExpr.value);
-            return Utils::filter(tracks, [&search, &firstExpr](const auto& track) {
+            const bool singleTerm = firstExpr.type == Expr::QuotedLiteral;
+
+            if(m_searchIndex) {
+                const QStringList terms = TrackSearchIndex::searchTerms(search, singleTerm);
+                return Utils::filter(tracks, [this, &terms](const auto& track) {
+                    if constexpr(std::is_same_v<TrackListType, PlaylistTrackList>) {
+                        return m_searchIndex->hasMatch(track.track, terms);
+                    }
+                    else {
+                        return m_searchIndex->hasMatch(track, terms);
+                    }
+                });
+            }
+
+            return Utils::filter(tracks, [&search, singleTerm](const auto& track) {
                 if constexpr(std::is_same_v<TrackListType, PlaylistTrackList>) {
-                    return matchSearch(track.track, search, firstExpr.type == Expr::QuotedLiteral);
+                    return matchTrack(track.track, search, singleTerm);
                 }
                 else {
-                    return matchSearch(track, search, firstExpr.type == Expr::QuotedLiteral);
+                    return matchTrack(track, search, singleTerm);
                 }
             });
         }
@@ -1581,6 +1640,11 @@ ScriptRegistry* ScriptParser::registry() const
 
 ScriptParser::~ScriptParser() = default;
 
+void ScriptParser::setSearchIndex(std::shared_ptr<const TrackSearchIndex> index)
+{
+    p->m_searchIndex = std::move(index);
+}
+
 ParsedScript ScriptParser::parse(const QString& input)
 {
     if(input.isEmpty()) {
@@ -1631,6 +1695,12 @@ QString ScriptParser::evaluate(const ParsedScript& input, const Track& track)
 
     p->m_isQuery = false;
 
+    if(p->m_compileScripts) {
+        if(const auto* program = p->program(input)) {
+            return program->evaluate(track);
+        }
+    }
+
     return p->evaluate(input, track);
 }
 
@@ -1718,18 +1788,30 @@ PlaylistTrackList ScriptParser::filter(const ParsedScript& input, const Playlist
     return p->evaluateQuery(input, tracks);
 }
 
-int ScriptParser::cacheLimit() const
+int ScriptParser::cacheLimit()
 {
-    return p->m_cache.limit();
+    return ScriptCache::shared().limit();
 }
 
 void ScriptParser::setCacheLimit(int limit)
 {
-    p->m_cache.setLimit(limit);
+    ScriptCache::shared().setLimit(limit);
+}
+
+ScriptCacheStats ScriptParser::cacheStats()
+{
+    return ScriptCache::shared().stats();
+}
+
+void ScriptParser::setCompileScripts(bool enabled)
+{
+    p->m_compileScripts = enabled;
 }
 
 void ScriptParser::clearCache()
 {
-    p->m_cache.clear();
+    p->m_programs.clear();
+    p->m_lastProgramInput.clear();
+    p->m_lastProgram = nullptr;
 }
 } // namespace Fooyin
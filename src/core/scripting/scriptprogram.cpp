@@ -0,0 +1,334 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "scriptprogram.h"
+
+#include <core/constants.h>
+#include <core/track.h>
+
+using namespace Qt::StringLiterals;
+
+namespace {
+QStringList evalStringList(const Fooyin::ScriptResult& evalExpr, const QStringList& result)
+{
+    QStringList listResult;
+    const QStringList values = evalExpr.value.split(QLatin1String{Fooyin::Constants::UnitSeparator});
+    const bool isEmpty       = result.empty();
+
+    for(const QString& value : values) {
+        if(isEmpty) {
+            listResult.append(value);
+        }
+        else {
+            std::ranges::transform(result, std::back_inserter(listResult),
+                                   [&](const QString& retValue) -> QString { return retValue + value; });
+        }
+    }
+    return listResult;
+}
+
+void appendResult(const Fooyin::ScriptResult& evalExpr, QStringList& result)
+{
+    if(evalExpr.value.contains(QLatin1String{Fooyin::Constants::UnitSeparator})) {
+        const QStringList evalList = evalStringList(evalExpr, result);
+        if(!evalList.empty()) {
+            result = evalList;
+        }
+    }
+    else {
+        if(result.empty()) {
+            result.append(evalExpr.value);
+        }
+        else {
+            std::ranges::transform(result, result.begin(),
+                                   [&](const QString& retValue) -> QString { return retValue + evalExpr.value; });
+        }
+    }
+}
+
+QString joinResult(const QStringList& result)
+{
+    if(result.size() == 1) {
+        // Calling join on a QStringList with a single empty string will return a null QString, so return the first
+        // result.
+        return result.constFirst();
+    }
+
+    if(result.size() > 1) {
+        return result.join(QLatin1String{Fooyin::Constants::UnitSeparator});
+    }
+
+    return {};
+}
+} // namespace
+
+namespace Fooyin {
+std::optional<ScriptProgram> ScriptProgram::compile(const ParsedScript& script, const ScriptRegistry* registry)
+{
+    if(!script.isValid() || !registry) {
+        return {};
+    }
+
+    ScriptProgram program;
+    program.m_rootCount = static_cast<uint32_t>(script.expressions.size());
+    program.m_instructions.resize(program.m_rootCount);
+
+    for(uint32_t i{0}; i < program.m_rootCount; ++i) {
+        if(!program.compileExpression(script.expressions.at(i), i, registry)) {
+            return {};
+        }
+    }
+
+    program.m_instructions.shrink_to_fit();
+
+    return program;
+}
+
+QString ScriptProgram::evaluate(const Track& track) const
+{
+    QStringList result;
+
+    for(uint32_t i{0}; i < m_rootCount; ++i) {
+        const ScriptResult evalExpr = run(i, track);
+        if(evalExpr.value.isNull()) {
+            continue;
+        }
+        appendResult(evalExpr, result);
+    }
+
+    return joinResult(result);
+}
+
+size_t ScriptProgram::size() const
+{
+    return m_instructions.size();
+}
+
+bool ScriptProgram::compileExpression(const Expression& expr, uint32_t index, const ScriptRegistry* registry)
+{
+    m_instructions[index].type = expr.type;
+
+    switch(expr.type) {
+        case(Expr::Literal):
+        case(Expr::QuotedLiteral): {
+            auto& instr      = m_instructions[index];
+            instr.isConstant = true;
+            instr.result     = {.value = std::get<QString>(expr.value), .cond = true};
+            return true;
+        }
+        case(Expr::Variable):
+        case(Expr::VariableList): {
+            auto& instr    = m_instructions[index];
+            instr.name     = std::get<QString>(expr.value).toLower();
+            instr.variable = registry->variableResolver(instr.name);
+            return true;
+        }
+        case(Expr::VariableRaw):
+            m_instructions[index].name = std::get<QString>(expr.value);
+            return true;
+        case(Expr::Function): {
+            const auto& func = std::get<FuncValue>(expr.value);
+            {
+                auto& instr    = m_instructions[index];
+                instr.name     = func.name;
+                instr.function = registry->functionResolver(func.name);
+            }
+            if(!compileArgs(func.args, index, registry)) {
+                return false;
+            }
+            if(m_instructions[index].isConstant && !registry->isConstantFunction(func.name)) {
+                m_instructions[index].isConstant = false;
+            }
+            break;
+        }
+        case(Expr::FunctionArg):
+        case(Expr::Conditional):
+            if(!compileArgs(std::get<ExpressionList>(expr.value), index, registry)) {
+                return false;
+            }
+            break;
+        case(Expr::Null): {
+            auto& instr      = m_instructions[index];
+            instr.isConstant = true;
+            instr.result     = {};
+            return true;
+        }
+        default:
+            return false;
+    }
+
+    // All arguments are constant, so evaluate once now rather than for every track
+    if(m_instructions[index].isConstant) {
+        m_instructions[index].isConstant = false;
+        const ScriptResult result        = run(index, Track{});
+        m_instructions[index].result     = result;
+        m_instructions[index].isConstant = true;
+    }
+
+    return true;
+}
+
+bool ScriptProgram::compileArgs(const ExpressionList& args, uint32_t index, const ScriptRegistry* registry)
+{
+    const auto firstArg = static_cast<uint32_t>(m_instructions.size());
+    const auto argCount = static_cast<uint32_t>(args.size());
+
+    m_instructions.resize(m_instructions.size() + args.size());
+    m_instructions[index].firstArg = firstArg;
+    m_instructions[index].argCount = argCount;
+
+    bool allConstant{true};
+    for(uint32_t i{0}; i < argCount; ++i) {
+        if(!compileExpression(args.at(i), firstArg + i, registry)) {
+            return false;
+        }
+        allConstant = allConstant && m_instructions[firstArg + i].isConstant;
+    }
+
+    m_instructions[index].isConstant = allConstant;
+
+    return true;
+}
+
+ScriptResult ScriptProgram::run(uint32_t index, const Track& track) const
+{
+    const Instruction& instr = m_instructions[index];
+
+    if(instr.isConstant) {
+        return instr.result;
+    }
+
+    switch(instr.type) {
+        case(Expr::Variable):
+            return runVariable(instr, track);
+        case(Expr::VariableList):
+            return instr.variable(track);
+        case(Expr::VariableRaw):
+            return runVariableRaw(instr, track);
+        case(Expr::Function):
+            return runFunction(instr, track);
+        case(Expr::FunctionArg):
+            return runFunctionArg(instr, track);
+        case(Expr::Conditional):
+            return runConditional(instr, track);
+        default:
+            return instr.result;
+    }
+}
+
+ScriptResult ScriptProgram::runVariable(const Instruction& instr, const Track& track) const
+{
+    ScriptResult result = instr.variable(track);
+
+    if(!result.cond) {
+        return {};
+    }
+
+    if(result.value.contains(QLatin1String{Constants::UnitSeparator})) {
+        result.value = result.value.replace(QLatin1String{Constants::UnitSeparator}, u", "_s);
+    }
+
+    return result;
+}
+
+ScriptResult ScriptProgram::runVariableRaw(const Instruction& instr, const Track& track) const
+{
+    ScriptResult result;
+    result.value = track.metaValue(instr.name);
+    result.cond  = !result.value.isEmpty();
+
+    if(!result.cond) {
+        return {};
+    }
+
+    if(result.value.contains(QLatin1String{Constants::UnitSeparator})) {
+        result.value = result.value.replace(QLatin1String{Constants::UnitSeparator}, u", "_s);
+    }
+
+    return result;
+}
+
+ScriptResult ScriptProgram::runFunction(const Instruction& instr, const Track& track) const
+{
+    ScriptValueList args;
+    args.reserve(instr.argCount);
+
+    for(uint32_t i{0}; i < instr.argCount; ++i) {
+        args.push_back(run(instr.firstArg + i, track));
+    }
+
+    return instr.function(args, track);
+}
+
+ScriptResult ScriptProgram::runFunctionArg(const Instruction& instr, const Track& track) const
+{
+    ScriptResult result;
+    bool allPassed{true};
+
+    for(uint32_t i{0}; i < instr.argCount; ++i) {
+        const auto subExpr = run(instr.firstArg + i, track);
+        if(!subExpr.cond) {
+            allPassed = false;
+        }
+        if(subExpr.value.contains(QLatin1String{Constants::UnitSeparator})) {
+            QStringList newResult;
+            const auto values = subExpr.value.split(QLatin1String{Constants::UnitSeparator});
+            std::ranges::transform(values, std::back_inserter(newResult),
+                                   [&](const auto& value) { return result.value + value; });
+            result.value = newResult.join(QLatin1String{Constants::UnitSeparator});
+        }
+        else {
+            result.value = result.value + subExpr.value;
+        }
+    }
+    result.cond = allPassed;
+    return result;
+}
+
+ScriptResult ScriptProgram::runConditional(const Instruction& instr, const Track& track) const
+{
+    ScriptResult result;
+    QStringList exprResult;
+    result.cond = true;
+
+    for(uint32_t i{0}; i < instr.argCount; ++i) {
+        const uint32_t argIndex = instr.firstArg + i;
+        const auto subExpr      = run(argIndex, track);
+
+        // Literals return false
+        const Expr::Type argType = m_instructions[argIndex].type;
+        if(argType != Expr::Literal && argType != Expr::QuotedLiteral) {
+            if(!subExpr.cond || subExpr.value.isEmpty()) {
+                // No need to evaluate rest
+                result.value.clear();
+                result.cond = false;
+                return result;
+            }
+        }
+        appendResult(subExpr, exprResult);
+    }
+    if(exprResult.size() == 1) {
+        result.value = exprResult.constFirst();
+    }
+    else if(exprResult.size() > 1) {
+        result.value = exprResult.join(QLatin1String{Constants::UnitSeparator});
+    }
+    return result;
+}
+} // namespace Fooyin
@@ -0,0 +1,67 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <core/scripting/scriptparser.h>
+
+namespace Fooyin {
+/*!
+ * A ParsedScript flattened into a single array of instructions for repeated evaluation against tracks.
+ * Variable and function lookups are resolved once at compile time, and sub-expressions which don't depend
+ * on the track are folded into constants.
+ * Only format scripts are supported; queries and list variables are left to ScriptParser.
+ */
+class ScriptProgram
+{
+public:
+    /** Returns a program for @p script, or std::nullopt if it contains unsupported expressions. */
+    static std::optional<ScriptProgram> compile(const ParsedScript& script, const ScriptRegistry* registry);
+
+    [[nodiscard]] QString evaluate(const Track& track) const;
+
+    [[nodiscard]] size_t size() const;
+
+private:
+    struct Instruction
+    {
+        Expr::Type type{Expr::Null};
+        bool isConstant{false};
+        ScriptResult result;
+        QString name;
+        ScriptRegistry::VariableFunc variable;
+        ScriptRegistry::FunctionFunc function;
+        uint32_t firstArg{0};
+        uint32_t argCount{0};
+    };
+
+    bool compileExpression(const Expression& expr, uint32_t index, const ScriptRegistry* registry);
+    bool compileArgs(const ExpressionList& args, uint32_t index, const ScriptRegistry* registry);
+
+    [[nodiscard]] ScriptResult run(uint32_t index, const Track& track) const;
+    [[nodiscard]] ScriptResult runVariable(const Instruction& instr, const Track& track) const;
+    [[nodiscard]] ScriptResult runVariableRaw(const Instruction& instr, const Track& track) const;
+    [[nodiscard]] ScriptResult runFunction(const Instruction& instr, const Track& track) const;
+    [[nodiscard]] ScriptResult runFunctionArg(const Instruction& instr, const Track& track) const;
+    [[nodiscard]] ScriptResult runConditional(const Instruction& instr, const Track& track) const;
+
+    std::vector<Instruction> m_instructions;
+    uint32_t m_rootCount{0};
+};
+} // namespace Fooyin
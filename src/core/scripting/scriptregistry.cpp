@@ -106,6 +106,34 @@ QString formatPeak(const float peak)
     return u"%1 dB"_s.arg(dbPeak, 0, 'f', 2).prepend(dbPeak > 0 ? "+"_L1 : ""_L1);
 }
 
+Fooyin::ScriptResult callFunc(const Func& scriptFunc, const Fooyin::ScriptValueList& args, const Fooyin::Track& track)
+{
+    const auto toStringList = [&args]() {
+        return QStringList{args.cbegin(), args.cend()};
+    };
+
+    if(std::holds_alternative<NativeFunc>(scriptFunc)) {
+        const QString value = std::get<NativeFunc>(scriptFunc)(toStringList());
+        return {.value = value, .cond = !value.isEmpty()};
+    }
+    if(std::holds_alternative<NativeVoidFunc>(scriptFunc)) {
+        const QString value = std::get<NativeVoidFunc>(scriptFunc)();
+        return {.value = value, .cond = !value.isEmpty()};
+    }
+    if(std::holds_alternative<NativeTrackFunc>(scriptFunc)) {
+        const QString value = std::get<NativeTrackFunc>(scriptFunc)(track, toStringList());
+        return {.value = value, .cond = !value.isEmpty()};
+    }
+    if(std::holds_alternative<NativeBoolFunc>(scriptFunc)) {
+        return std::get<NativeBoolFunc>(scriptFunc)(toStringList());
+    }
+    if(std::holds_alternative<NativeCondFunc>(scriptFunc)) {
+        return std::get<NativeCondFunc>(scriptFunc)(args);
+    }
+
+    return {};
+}
+
 QString formatDateTime(const uint64_t ms)
 {
     if(ms == 0) {
@@ -551,27 +579,7 @@ ScriptResult ScriptRegistry::function(const QString& func, const ScriptValueList
         return {};
     }
 
-    const auto scriptFunc = p->m_funcs.at(func);
-    if(std::holds_alternative<NativeFunc>(scriptFunc)) {
-        const QString value = std::get<NativeFunc>(scriptFunc)(containerCast<QStringList>(args));
-        return {.value = value, .cond = !value.isEmpty()};
-    }
-    if(std::holds_alternative<NativeVoidFunc>(scriptFunc)) {
-        const QString value = std::get<NativeVoidFunc>(scriptFunc)();
-        return {.value = value, .cond = !value.isEmpty()};
-    }
-    if(std::holds_alternative<NativeTrackFunc>(scriptFunc)) {
-        const QString value = std::get<NativeTrackFunc>(scriptFunc)(track, containerCast<QStringList>(args));
-        return {.value = value, .cond = !value.isEmpty()};
-    }
-    if(std::holds_alternative<NativeBoolFunc>(scriptFunc)) {
-        return std::get<NativeBoolFunc>(scriptFunc)(containerCast<QStringList>(args));
-    }
-    if(std::holds_alternative<NativeCondFunc>(scriptFunc)) {
-        return std::get<NativeCondFunc>(scriptFunc)(args);
-    }
-
-    return {};
+    return callFunc(p->m_funcs.at(func), args, track);
 }
 
 ScriptResult ScriptRegistry::function(const QString& func, const ScriptValueList& args, const TrackList& tracks) const
@@ -600,6 +608,67 @@ ScriptResult ScriptRegistry::function(const QString& func, const ScriptValueList
     return function(func, args, playlist.currentTrack());
 }
 
+ScriptRegistry::VariableFunc ScriptRegistry::variableResolver(const QString& var) const
+{
+    if(var.isEmpty()) {
+        return [](const Track& /*track*/) {
+            return ScriptResult{};
+        };
+    }
+
+    const QString variable = var.toUpper();
+
+    if(p->m_metadata.contains(variable)) {
+        return [this, func = p->m_metadata.at(variable)](const Track& track) {
+            return calculateResult(func(track));
+        };
+    }
+    if(p->m_playbackVars.contains(variable)) {
+        return [this, func = p->m_playbackVars.at(variable)](const Track& /*track*/) {
+            return calculateResult(func());
+        };
+    }
+    if(p->m_libraryVars.contains(variable)) {
+        return [this, func = p->m_libraryVars.at(variable)](const Track& track) {
+            return calculateResult(func(track));
+        };
+    }
+    if(p->m_listProperties.contains(variable)) {
+        return [result = ScriptResult{.value = u"%%1%"_s.arg(var), .cond = true}](const Track& /*track*/) {
+            return result;
+        };
+    }
+
+    return [this, variable](const Track& track) {
+        if(!track.hasExtraTag(variable)) {
+            return ScriptResult{};
+        }
+        return calculateResult(track.extraTag(variable));
+    };
+}
+
+ScriptRegistry::FunctionFunc ScriptRegistry::functionResolver(const QString& func) const
+{
+    if(func.isEmpty() || !p->m_funcs.contains(func)) {
+        return [](const ScriptValueList& /*args*/, const Track& /*track*/) {
+            return ScriptResult{};
+        };
+    }
+
+    return [scriptFunc = p->m_funcs.at(func)](const ScriptValueList& args, const Track& track) {
+        return callFunc(scriptFunc, args, track);
+    };
+}
+
+bool ScriptRegistry::isConstantFunction(const QString& func) const
+{
+    if(func == "rand"_L1 || !p->m_funcs.contains(func)) {
+        return false;
+    }
+
+    return !std::holds_alternative<NativeTrackFunc>(p->m_funcs.at(func));
+}
+
 void ScriptRegistry::setValue(const QString& var, const FuncRet& value, Track& track)
 {
     if(var.isEmpty()) {
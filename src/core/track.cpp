@@ -21,6 +21,7 @@
 #include <core/track.h>
 
 #include <utils/crypto.h>
+#include <utils/stringpool.h>
 #include <utils/utils.h>
 
 #include <QDir>
@@ -39,6 +40,17 @@ constexpr auto YearMonthRegex = R"lit(\b(\d{4})-(\d{2})\b)lit";
 constexpr auto FullDateRegex  = R"lit(\b(\d{4})-(\d{2})-(\d{2})\b)lit";
 
 namespace {
+// Values which commonly repeat across a library share their data through the string pool
+QString intern(const QString& str)
+{
+    return Fooyin::StringPool::global().intern(str);
+}
+
+QStringList intern(const QStringList& list)
+{
+    return Fooyin::StringPool::global().intern(list);
+}
+
 QString validNum(auto num)
 {
     if(num > 0) {
@@ -166,10 +178,10 @@ void TrackPrivate::splitArchiveUrl()
 
     const QFileInfo info{filepathWithinArchive};
     filename  = info.completeBaseName();
-    extension = info.suffix().toLower();
-    directory = info.dir().dirName();
+    extension = intern(info.suffix().toLower());
+    directory = intern(info.dir().dirName());
     if(directory == "."_L1) {
-        directory = QFileInfo{archivePath}.fileName();
+        directory = intern(QFileInfo{archivePath}.fileName());
     }
 }
 
@@ -900,8 +912,8 @@ void Track::setFilePath(const QString& path)
         p->isInArchive = false;
         const QFileInfo info{p->filepath};
         p->filename  = info.completeBaseName();
-        p->extension = info.suffix().toLower();
-        p->directory = info.dir().dirName();
+        p->extension = intern(info.suffix().toLower());
+        p->directory = intern(info.dir().dirName());
     }
 }
 
@@ -920,7 +932,7 @@ void Track::setArtists(const QStringList& artists)
         p->artists.clear();
     }
     else {
-        p->artists = artists;
+        p->artists = intern(artists);
     }
 
     if(!p->hash.isEmpty()) {
@@ -930,7 +942,7 @@ void Track::setArtists(const QStringList& artists)
 
 void Track::setAlbum(const QString& title)
 {
-    p->album = title;
+    p->album = intern(title);
 
     if(!p->hash.isEmpty()) {
         generateHash();
@@ -943,7 +955,7 @@ void Track::setAlbumArtists(const QStringList& artists)
         p->albumArtists.clear();
     }
     else {
-        p->albumArtists = artists;
+        p->albumArtists = intern(artists);
     }
 }
 
@@ -1003,18 +1015,18 @@ void Track::setGenres(const QStringList& genres)
         p->genres.clear();
     }
     else {
-        p->genres = genres;
+        p->genres = intern(genres);
     }
 }
 
 void Track::setComposers(const QStringList& composers)
 {
-    p->composers = composers;
+    p->composers = intern(composers);
 }
 
 void Track::setPerformers(const QStringList& performers)
 {
-    p->performers = performers;
+    p->performers = intern(performers);
 }
 
 void Track::setComment(const QString& comment)
@@ -1366,27 +1378,27 @@ void Track::setBitDepth(int depth)
 
 void Track::setCodec(const QString& codec)
 {
-    p->codec = codec;
+    p->codec = intern(codec);
 }
 
 void Track::setCodecProfile(const QString& profile)
 {
-    p->codecProfile = profile;
+    p->codecProfile = intern(profile);
 }
 
 void Track::setTool(const QString& tool)
 {
-    p->tool = tool;
+    p->tool = intern(tool);
 }
 
 void Track::setTagTypes(const QStringList& tagTypes)
 {
-    p->tagTypes = tagTypes;
+    p->tagTypes = intern(tagTypes);
 }
 
 void Track::setEncoding(const QString& encoding)
 {
-    p->encoding = encoding;
+    p->encoding = intern(encoding);
 }
 
 void Track::setPlayCount(int count)
@@ -177,5 +177,6 @@ GuiSettings::GuiSettings(SettingsManager* settingsManager)
     m_settings->createSetting<Internal::ImageAllocationLimit>(QImageReader::allocationLimit(),
                                                               u"Interface/ImageAllocationLimit"_s);
     m_settings->createSetting<Internal::PlaylistTrackPreloadCount>(2000, u"Playlist/TrackPreloadCount"_s);
+    m_settings->createSetting<Internal::PlaylistDeferThreshold>(10000, u"Playlist/DeferThreshold"_s);
 }
 } // namespace Fooyin
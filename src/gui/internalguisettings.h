@@ -170,6 +170,7 @@ enum GuiInternalSettings : uint32_t
     ArtworkDownloadThumbSize  = 67 | Type::Int,
     ImageAllocationLimit      = 68 | Type::Int,
     PlaylistTrackPreloadCount = 69 | Type::Int,
+    PlaylistDeferThreshold    = 70 | Type::Int,
 };
 Q_ENUM_NS(GuiInternalSettings)
 } // namespace Settings::Gui::Internal
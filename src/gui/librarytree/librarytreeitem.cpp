@@ -127,6 +127,11 @@ void LibraryTreeItem::addTracks(const TrackList& tracks)
     std::ranges::copy(tracks, std::back_inserter(m_tracks));
 }
 
+void LibraryTreeItem::setTracks(const TrackList& tracks)
+{
+    m_tracks = tracks;
+}
+
 void LibraryTreeItem::removeTrack(const Track& track)
 {
     if(m_tracks.empty()) {
@@ -126,7 +126,10 @@ public:
     void updateSummary();
 
     void removeTracks(const TrackList& tracks);
+    void removeTracksFromNodes(const std::vector<std::pair<Track, std::vector<Md5Hash>>>& trackNodes);
+    void applyUpdatedTracks(PendingTreeData& data);
     void mergeTrackParents(const TrackIdNodeMap& parents);
+    void sortPendingNodes();
 
     void batchFinished(PendingTreeData data);
 
@@ -155,9 +158,11 @@ public:
     ItemKeyMap m_nodes;
     TrackIdNodeMap m_trackParents;
     std::unordered_set<Md5Hash> m_addedNodes;
+    std::unordered_set<Md5Hash> m_nodesToSort;
     bool m_addingTracks{false};
 
-    TrackList m_tracksPendingRemoval;
+    // Updated tracks not yet seen in a populated batch
+    std::unordered_map<int, Track> m_pendingUpdates;
 
     Player::PlayState m_playingState;
     QString m_parentNode;
@@ -189,17 +194,29 @@ void LibraryTreeModelPrivate::updateSummary()
 
 void LibraryTreeModelPrivate::removeTracks(const TrackList& tracks)
 {
-    std::set<LibraryTreeItem*, cmpItems> items;
-    std::set<LibraryTreeItem*> pendingItems;
+    std::vector<std::pair<Track, std::vector<Md5Hash>>> trackNodes;
 
     for(const Track& track : tracks) {
-        const int id = track.id();
-        if(!m_trackParents.contains(id)) {
+        const auto parentIt = m_trackParents.find(track.id());
+        if(parentIt == m_trackParents.end()) {
             continue;
         }
 
-        const auto trackNodes = m_trackParents[id];
-        for(const auto& node : trackNodes) {
+        trackNodes.emplace_back(track, std::move(parentIt->second));
+        m_trackParents.erase(parentIt);
+    }
+
+    removeTracksFromNodes(trackNodes);
+}
+
+void LibraryTreeModelPrivate::removeTracksFromNodes(
+    const std::vector<std::pair<Track, std::vector<Md5Hash>>>& trackNodes)
+{
+    std::set<LibraryTreeItem*, cmpItems> items;
+    std::set<LibraryTreeItem*> pendingItems;
+
+    for(const auto& [track, nodes] : trackNodes) {
+        for(const auto& node : nodes) {
             if(m_nodes.contains(node)) {
                 LibraryTreeItem* item = &m_nodes[node];
                 item->removeTrack(track);
@@ -211,7 +228,6 @@ void LibraryTreeModelPrivate::removeTracks(const TrackList& tracks)
                 }
             }
         }
-        m_trackParents.erase(id);
     }
 
     for(const LibraryTreeItem* item : pendingItems) {
@@ -236,6 +252,58 @@ void LibraryTreeModelPrivate::removeTracks(const TrackList& tracks)
     updateSummary();
 }
 
+void LibraryTreeModelPrivate::applyUpdatedTracks(PendingTreeData& data)
+{
+    // Diff the nodes of each updated track against its previous ones, so nodes which still
+    // contain the track are updated in place rather than removed and re-inserted
+    std::vector<std::pair<Track, std::vector<Md5Hash>>> removedNodes;
+
+    for(auto& [id, newKeys] : data.trackParents) {
+        const auto pendingIt = m_pendingUpdates.find(id);
+        if(pendingIt == m_pendingUpdates.end()) {
+            continue;
+        }
+
+        const Track track = pendingIt->second;
+        m_pendingUpdates.erase(pendingIt);
+
+        const auto parentIt = m_trackParents.find(id);
+        if(parentIt == m_trackParents.end()) {
+            continue;
+        }
+
+        std::vector<Md5Hash> keptKeys;
+        std::vector<Md5Hash> removedKeys;
+
+        for(const Md5Hash& key : parentIt->second) {
+            if(std::ranges::find(newKeys, key) == newKeys.cend() || !m_nodes.contains(key)) {
+                removedKeys.push_back(key);
+                continue;
+            }
+
+            LibraryTreeItem& node = m_nodes.at(key);
+            node.replaceTrack(track);
+            m_nodesToSort.emplace(key);
+
+            if(data.items.contains(key)) {
+                data.items.at(key).removeTrack(track);
+            }
+            std::erase(newKeys, key);
+            keptKeys.push_back(key);
+        }
+
+        parentIt->second = std::move(keptKeys);
+
+        if(!removedKeys.empty()) {
+            removedNodes.emplace_back(track, std::move(removedKeys));
+        }
+    }
+
+    if(!removedNodes.empty()) {
+        removeTracksFromNodes(removedNodes);
+    }
+}
+
 void LibraryTreeModelPrivate::mergeTrackParents(const TrackIdNodeMap& parents)
 {
     for(const auto& pair : parents) {
@@ -262,8 +330,8 @@ void LibraryTreeModelPrivate::batchFinished(PendingTreeData data)
         beginReset();
     }
 
-    if(!m_tracksPendingRemoval.empty()) {
-        removeTracks(m_tracksPendingRemoval);
+    if(!m_pendingUpdates.empty()) {
+        applyUpdatedTracks(data);
     }
 
     populateModel(data);
@@ -357,9 +425,10 @@ void LibraryTreeModelPrivate::populateModel(PendingTreeData& data)
 {
     for(const auto& [key, item] : data.items) {
         if(m_nodes.contains(key)) {
-            auto& node = m_nodes.at(key);
-            node.addTracks(item.tracks());
-            node.sortTracks();
+            if(item.trackCount() > 0) {
+                m_nodes.at(key).addTracks(item.tracks());
+                m_nodesToSort.emplace(key);
+            }
         }
         else {
             m_nodes[key] = item;
@@ -389,12 +458,25 @@ void LibraryTreeModelPrivate::populateModel(PendingTreeData& data)
     updateSummary();
 }
 
+void LibraryTreeModelPrivate::sortPendingNodes()
+{
+    for(const Md5Hash& key : m_nodesToSort) {
+        if(m_nodes.contains(key)) {
+            m_nodes.at(key).sortTracks();
+        }
+    }
+    m_nodesToSort.clear();
+}
+
 void LibraryTreeModelPrivate::beginReset()
 {
     m_self->resetRoot();
     m_nodes.clear();
     m_pendingNodes.clear();
     m_addedNodes.clear();
+    m_nodesToSort.clear();
+    m_trackParents.clear();
+    m_pendingUpdates.clear();
 
     m_summaryNode = LibraryTreeItem{u"All Music"_s, m_self->rootItem(), -1};
     m_self->rootItem()->appendChild(&m_summaryNode);
@@ -410,6 +492,17 @@ LibraryTreeModel::LibraryTreeModel(LibraryManager* libraryManager, const std::sh
                      [this](const PendingTreeData& data) { p->batchFinished(data); });
 
     QObject::connect(&p->m_populator, &Worker::finished, this, [this]() {
+        // Nodes are only sorted once per run, rather than after every batch merged into them
+        p->sortPendingNodes();
+
+        if(!p->m_pendingUpdates.empty()) {
+            // Updated tracks which no longer belong to any node
+            TrackList removedTracks;
+            std::ranges::copy(p->m_pendingUpdates | std::views::values, std::back_inserter(removedTracks));
+            p->m_pendingUpdates.clear();
+            p->removeTracks(removedTracks);
+        }
+
         p->updateSummary();
         p->m_populator.stopThread();
         p->m_populatorThread.quit();
@@ -705,8 +798,10 @@ void LibraryTreeModel::updateTracks(const TrackList& tracks)
         return;
     }
 
-    p->m_tracksPendingRemoval = tracksToUpdate;
-    p->m_addingTracks         = false;
+    for(const Track& track : tracksToUpdate) {
+        p->m_pendingUpdates.insert_or_assign(track.id(), track);
+    }
+    p->m_addingTracks = false;
     p->m_populatorThread.start();
 
     QMetaObject::invokeMethod(&p->m_populator, [this, tracksToUpdate] {
@@ -738,6 +833,34 @@ void LibraryTreeModel::removeTracks(const TrackList& tracks)
     p->removeTracks(tracks);
 }
 
+bool LibraryTreeModel::sortTracks(const TrackList& tracks)
+{
+    if(p->m_populatorThread.isRunning()) {
+        return false;
+    }
+
+    // Node keys don't depend on the sort order, so only the track lists need rebuilding
+    std::unordered_map<Md5Hash, TrackList> nodeTracks;
+
+    for(const Track& track : tracks) {
+        const auto parentIt = p->m_trackParents.find(track.id());
+        if(parentIt == p->m_trackParents.cend()) {
+            continue;
+        }
+        for(const Md5Hash& key : parentIt->second) {
+            nodeTracks[key].push_back(track);
+        }
+    }
+
+    for(auto& [key, sortedTracks] : nodeTracks) {
+        if(p->m_nodes.contains(key)) {
+            p->m_nodes.at(key).setTracks(sortedTracks);
+        }
+    }
+
+    return true;
+}
+
 void LibraryTreeModel::changeGrouping(const LibraryTreeGrouping& grouping)
 {
     p->m_grouping = grouping.script;
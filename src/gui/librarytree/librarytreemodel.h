@@ -80,6 +80,8 @@ public:
     void updateTracks(const TrackList& tracks);
     void refreshTracks(const TrackList& tracks);
     void removeTracks(const TrackList& tracks);
+    /** Reorders the tracks of each node to match @p tracks. Returns @c false if the model is still populating. */
+    bool sortTracks(const TrackList& tracks);
 
     void changeGrouping(const LibraryTreeGrouping& grouping);
     void reset(const TrackList& tracks);
@@ -27,8 +27,8 @@
 
 using namespace Qt::StringLiterals;
 
-constexpr int InitialBatchSize = 3000;
-constexpr int BatchSize        = 4000;
+constexpr size_t InitialBatchSize = 3000;
+constexpr size_t BatchSize        = 4000;
 
 namespace Fooyin {
 class LibraryTreePopulatorPrivate
@@ -43,7 +43,7 @@ public:
     LibraryTreeItem* getOrInsertItem(const Md5Hash& key, const LibraryTreeItem* parent, const QString& title,
                                      int level);
     void iterateTrack(const Track& track);
-    bool runBatch(int size);
+    bool runBatches(const TrackList& tracks);
 
     LibraryTreePopulator* m_self;
 
@@ -54,7 +54,6 @@ public:
 
     LibraryTreeItem m_root;
     PendingTreeData m_data;
-    TrackList m_pendingTracks;
 };
 
 LibraryTreeItem* LibraryTreePopulatorPrivate::getOrInsertItem(const Md5Hash& key, const LibraryTreeItem* parent,
@@ -91,7 +90,7 @@ void LibraryTreePopulatorPrivate::iterateTrack(const Track& track)
 
         for(int level{0}; const QString& item : items) {
             const QString title = item.trimmed();
-            const auto key      = Utils::generateMd5Hash(parent->key(), title);
+            const auto key      = Utils::generateNodeKey(parent->key(), title);
 
             auto* node = getOrInsertItem(key, parent, title, level);
 
@@ -104,39 +103,39 @@ void LibraryTreePopulatorPrivate::iterateTrack(const Track& track)
     }
 }
 
-bool LibraryTreePopulatorPrivate::runBatch(int size)
+bool LibraryTreePopulatorPrivate::runBatches(const TrackList& tracks)
 {
-    if(size <= 0) {
-        return true;
-    }
-
-    auto tracksBatch = std::ranges::views::take(m_pendingTracks, size);
+    const size_t total = tracks.size();
+    size_t batchStart{0};
+    size_t batchSize{InitialBatchSize};
+
+    // Walk the list once, emitting the tree built so far after each batch
+    do {
+        const size_t batchEnd = std::min(total, batchStart + batchSize);
+
+        for(size_t i{batchStart}; i < batchEnd; ++i) {
+            if(!m_self->mayRun()) {
+                return false;
+            }
+
+            const Track& track = tracks[i];
+            if(track.isInLibrary()) {
+                iterateTrack(track);
+            }
+        }
 
-    for(const Track& track : tracksBatch) {
         if(!m_self->mayRun()) {
             return false;
         }
 
-        if(track.isInLibrary()) {
-            iterateTrack(track);
-        }
-    }
-
-    if(!m_self->mayRun()) {
-        return false;
-    }
-
-    emit m_self->populated(m_data);
-
-    auto tracksToKeep = std::ranges::views::drop(m_pendingTracks, size);
-    TrackList tempTracks;
-    std::ranges::copy(tracksToKeep, std::back_inserter(tempTracks));
-    m_pendingTracks = std::move(tempTracks);
+        emit m_self->populated(m_data);
+        m_data.clear();
 
-    m_data.clear();
+        batchStart = batchEnd;
+        batchSize  = BatchSize;
+    } while(batchStart < total);
 
-    const auto remaining = static_cast<int>(m_pendingTracks.size());
-    return runBatch(std::min(remaining, BatchSize));
+    return true;
 }
 
 LibraryTreePopulator::LibraryTreePopulator(LibraryManager* libraryManager, QObject* parent)
@@ -160,8 +159,7 @@ void LibraryTreePopulator::run(const QString& grouping, const TrackList& tracks,
         p->m_script = p->m_parser.parse(p->m_currentGrouping);
     }
 
-    p->m_pendingTracks = tracks;
-    const bool success = p->runBatch(InitialBatchSize);
+    const bool success = p->runBatches(tracks);
 
     setState(Idle);
 
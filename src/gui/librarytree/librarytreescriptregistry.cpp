@@ -20,6 +20,7 @@
 #include "librarytreescriptregistry.h"
 
 #include <core/constants.h>
+#include <core/track.h>
 
 using namespace Qt::StringLiterals;
 
@@ -51,4 +52,14 @@ ScriptResult LibraryTreeScriptRegistry::value(const QString& var, const Track& t
     }
     return ScriptRegistry::value(var, track);
 }
+
+ScriptRegistry::VariableFunc LibraryTreeScriptRegistry::variableResolver(const QString& var) const
+{
+    if(var == "frontcover"_L1 || var == "backcover"_L1 || var == "artistpicture"_L1) {
+        return [result = value(var, Track{})](const Track& /*track*/) {
+            return result;
+        };
+    }
+    return ScriptRegistry::variableResolver(var);
+}
 } // namespace Fooyin
@@ -35,6 +35,7 @@
 #include <core/player/playerdefs.h>
 #include <core/playlist/playlisthandler.h>
 #include <core/plugins/coreplugincontext.h>
+#include <core/scripting/incrementalfilter.h>
 #include <gui/guiconstants.h>
 #include <gui/guisettings.h>
 #include <gui/trackselectioncontroller.h>
@@ -233,6 +234,7 @@ public:
 
     QString m_currentSearch;
     TrackList m_filteredTracks;
+    std::shared_ptr<IncrementalFilter<TrackList>> m_searchFilter;
 
     bool m_updating{false};
     QByteArray m_pendingState;
@@ -265,7 +267,10 @@ LibraryTreeWidgetPrivate::LibraryTreeWidgetPrivate(LibraryTreeWidget* self, Acti
     , m_playAction{new QAction(LibraryTreeWidget::tr("&Play"), m_self)}
     , m_doubleClickAction{static_cast<TrackAction>(m_settings->value<LibTreeDoubleClick>())}
     , m_middleClickAction{static_cast<TrackAction>(m_settings->value<LibTreeMiddleClick>())}
+    , m_searchFilter{std::make_shared<IncrementalFilter<TrackList>>()}
 {
+    m_searchFilter->setSearchIndex(m_library->searchIndex());
+
     m_layout->setContentsMargins(0, 0, 0, 0);
     m_layout->addWidget(m_libraryTree);
 
@@ -350,7 +355,19 @@ void LibraryTreeWidgetPrivate::setupConnections()
     QObject::connect(m_library, &MusicLibrary::tracksUpdated, m_self,
                      [this](const TrackList& tracks) { m_model->refreshTracks(tracks); });
     QObject::connect(m_library, &MusicLibrary::tracksDeleted, m_model, &LibraryTreeModel::removeTracks);
-    QObject::connect(m_library, &MusicLibrary::tracksSorted, m_self, [this]() { reset(); });
+    QObject::connect(m_library, &MusicLibrary::tracksSorted, m_self, [this](const TrackList& tracks) {
+        if(!m_model->sortTracks(tracks)) {
+            reset();
+        }
+    });
+
+    const auto invalidateSearch = [this]() { m_searchFilter->invalidate(); };
+    QObject::connect(m_library, &MusicLibrary::tracksLoaded, m_self, invalidateSearch);
+    QObject::connect(m_library, &MusicLibrary::tracksAdded, m_self, invalidateSearch);
+    QObject::connect(m_library, &MusicLibrary::tracksMetadataChanged, m_self, invalidateSearch);
+    QObject::connect(m_library, &MusicLibrary::tracksUpdated, m_self, invalidateSearch);
+    QObject::connect(m_library, &MusicLibrary::tracksDeleted, m_self, invalidateSearch);
+    QObject::connect(m_library, &MusicLibrary::tracksSorted, m_self, invalidateSearch);
 
     QObject::connect(m_playerController, &PlayerController::playStateChanged, m_self,
                      [this](Player::PlayState state) { m_model->setPlayState(state); });
@@ -587,9 +604,9 @@ void LibraryTreeWidgetPrivate::searchChanged(const QString& search)
         return;
     }
 
-    Utils::asyncExec([search, tracks = m_library->tracks()]() {
-        ScriptParser parser;
-        return parser.filter(search, tracks);
+    Utils::asyncExec([search, tracks = m_library->tracks(), searchFilter = m_searchFilter,
+                      generation = m_searchFilter->generation()]() {
+        return searchFilter->filter(search, tracks, generation);
     }).then(m_self, [this](const TrackList& filteredTracks) {
         m_filteredTracks = filteredTracks;
         m_model->reset(m_filteredTracks);
@@ -726,8 +743,9 @@ void LibraryTreeWidgetPrivate::handleTracksAdded(const TrackList& tracks) const
     }
 
     if(!m_currentSearch.isEmpty()) {
-        Utils::asyncExec([search = m_currentSearch, tracks]() {
+        Utils::asyncExec([search = m_currentSearch, tracks, searchIndex = m_library->searchIndex()]() {
             ScriptParser parser;
+            parser.setSearchIndex(searchIndex);
             return parser.filter(search, tracks);
         }).then(m_self, [this](const TrackList& filteredTracks) { m_model->addTracks(filteredTracks); });
     }
@@ -254,6 +254,11 @@ QSize PlaylistTrackItem::size(int column) const
     return m_sizes.at(column);
 }
 
+bool PlaylistTrackItem::isDeferred() const
+{
+    return m_deferred;
+}
+
 void PlaylistTrackItem::setColumns(const std::vector<RichScript>& columns)
 {
     m_columns = columns;
@@ -285,6 +290,11 @@ void PlaylistTrackItem::setDepth(int depth)
     m_depth = depth;
 }
 
+void PlaylistTrackItem::setDeferred(bool deferred)
+{
+    m_deferred = deferred;
+}
+
 void PlaylistTrackItem::removeColumn(int column)
 {
     if(column < 0 || std::cmp_greater_equal(column, m_columns.size())) {
@@ -87,6 +87,8 @@ public:
     [[nodiscard]] int rowHeight() const;
     [[nodiscard]] int depth() const;
     [[nodiscard]] QSize size(int column = 0) const;
+    /** Returns true if the column or left/right text hasn't been evaluated yet. */
+    [[nodiscard]] bool isDeferred() const;
 
     void setColumns(const std::vector<RichScript>& columns);
     void setLeftRight(const RichScript& left, const RichScript& right);
@@ -95,6 +97,7 @@ public:
 
     void setRowHeight(int height);
     void setDepth(int depth);
+    void setDeferred(bool deferred);
     void removeColumn(int column);
 
     void calculateSize();
@@ -108,5 +111,6 @@ private:
     std::vector<QSize> m_sizes;
     int m_rowHeight;
     int m_depth;
+    bool m_deferred{false};
 };
 } // namespace Fooyin
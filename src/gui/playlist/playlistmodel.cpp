@@ -491,6 +491,7 @@ PlaylistModel::PlaylistModel(PlaylistInteractor* playlistInteractor, CoverProvid
     , m_playingColour{QApplication::palette().highlight().color()}
     , m_disabledColour{Qt::red}
     , m_populator{playlistInteractor->playerController()}
+    , m_rowCache{playlistInteractor->playerController()}
     , m_playlistLoaded{false}
     , m_pixmapPadding{settings->value<Settings::Gui::Internal::PlaylistImagePadding>()}
     , m_pixmapPaddingTop{settings->value<Settings::Gui::Internal::PlaylistImagePaddingTop>()}
@@ -503,6 +504,7 @@ PlaylistModel::PlaylistModel(PlaylistInteractor* playlistInteractor, CoverProvid
 
     m_populator.setUseVarious(m_settings->value<Settings::Core::UseVariousForCompilations>());
     m_populator.setPreloadCount(m_settings->value<Settings::Gui::Internal::PlaylistTrackPreloadCount>());
+    m_populator.setDeferThreshold(m_settings->value<Settings::Gui::Internal::PlaylistDeferThreshold>());
     m_populator.moveToThread(&m_populatorThread);
     m_populatorThread.start();
 
@@ -884,6 +886,7 @@ void PlaylistModel::resetColumnAlignments()
 void PlaylistModel::setFont(const QFont& font)
 {
     QMetaObject::invokeMethod(&m_populator, [this, font]() { m_populator.setFont(font); });
+    m_rowCache.setFont(font);
 }
 
 void PlaylistModel::setPixmapColumnSize(int column, int size)
@@ -906,9 +909,14 @@ void PlaylistModel::reset(const PlaylistTrackList& tracks)
     m_playlistLoaded = false;
     m_resetting      = true;
 
+    m_rowCache.clear();
+    m_rowCache.setUseVarious(m_settings->value<Settings::Core::UseVariousForCompilations>());
+    m_rowCache.setup(m_currentPlaylist, m_currentPreset, m_columns);
+
     QMetaObject::invokeMethod(&m_populator, [this, tracks] {
         m_populator.setUseVarious(m_settings->value<Settings::Core::UseVariousForCompilations>());
         m_populator.setPreloadCount(m_settings->value<Settings::Gui::Internal::PlaylistTrackPreloadCount>());
+        m_populator.setDeferThreshold(m_settings->value<Settings::Gui::Internal::PlaylistDeferThreshold>());
         m_populator.run(m_currentPlaylist, m_currentPreset, m_columns, tracks);
     });
 }
@@ -1158,6 +1166,9 @@ bool PlaylistModel::removeColumn(int column)
         node.removeColumn(column);
     }
 
+    m_rowCache.clear();
+    m_rowCache.setup(m_currentPlaylist, m_currentPreset, m_columns);
+
     endRemoveColumns();
 
     return true;
@@ -1346,7 +1357,12 @@ void PlaylistModel::updateTracks(const ItemList& tracks, const std::set<int>& co
         return;
     }
 
+    // Deferred rows are re-evaluated from the updated track (and current queue) when next shown
+    m_rowCache.setup(m_currentPlaylist, m_currentPreset, m_columns);
+
     for(const PlaylistItem& item : tracks) {
+        m_rowCache.invalidate(item.key());
+
         if(m_nodes.contains(item.key())) {
             auto* node = &m_nodes.at(item.key());
             node->setData(item.data());
@@ -1380,9 +1396,29 @@ void PlaylistModel::mergeTrackParents(const TrackIdNodeMap& parents)
 
 QVariant PlaylistModel::trackData(PlaylistItem* item, const QModelIndex& index, int role) const
 {
-    const int column     = index.column();
-    const auto trackItem = std::get<PlaylistTrackItem>(item->data());
-    const Track& track   = trackItem.track().track;
+    const int column = index.column();
+
+    PlaylistTrackItem trackItem = std::get<PlaylistTrackItem>(item->data());
+    if(trackItem.isDeferred()) {
+        switch(role) {
+            case(Qt::ToolTipRole):
+            case(PlaylistItem::Role::Column):
+            case(PlaylistItem::Role::Left):
+            case(PlaylistItem::Role::Right):
+                trackItem = m_rowCache.row(item->key(), trackItem);
+                break;
+            case(Qt::SizeHintRole):
+                // Row height doesn't depend on the text, so only use the evaluated width if it's already known
+                if(m_rowCache.contains(item->key())) {
+                    trackItem = m_rowCache.row(item->key(), trackItem);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    const Track& track = trackItem.track().track;
 
     const bool singleColumnMode = m_columns.empty();
     const bool isPlaying        = trackIsPlaying(track, item->index());
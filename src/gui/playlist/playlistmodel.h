@@ -23,6 +23,7 @@
 #include "playlistitem.h"
 #include "playlistpopulator.h"
 #include "playlistpreset.h"
+#include "playlistrowcache.h"
 
 #include <core/player/playerdefs.h>
 #include <core/playlist/playlist.h>
@@ -251,6 +252,7 @@ private:
 
     QThread m_populatorThread;
     PlaylistPopulator m_populator;
+    mutable PlaylistRowCache m_rowCache;
 
     bool m_playlistLoaded;
     ItemKeyMap m_nodes;
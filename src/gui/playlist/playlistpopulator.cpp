@@ -66,6 +66,8 @@ public:
     ScriptFormatter m_formatter;
 
     int m_preloadCount{2000};
+    int m_deferThreshold{0};
+    bool m_deferRows{false};
     int m_trackDepth{0};
     Md5Hash m_prevBaseHeaderKey;
     UId m_prevHeaderKey;
@@ -136,7 +138,7 @@ void PlaylistPopulatorPrivate::iterateHeader(const Track& track, PlaylistItem*&
     };
 
     auto generateHeaderKey = [&row, &evaluateBlocks]() {
-        return Utils::generateMd5Hash(evaluateBlocks(row.title), evaluateBlocks(row.subtitle),
+        return Utils::generateNodeKey(evaluateBlocks(row.title), evaluateBlocks(row.subtitle),
                                       evaluateBlocks(row.sideText), evaluateBlocks(row.info));
     };
 
@@ -210,7 +212,7 @@ void PlaylistPopulatorPrivate::iterateSubheaders(const Track& track, PlaylistIte
             continue;
         }
 
-        const auto baseKey = Utils::generateMd5Hash(parent->baseKey(), subheaderKey);
+        const auto baseKey = Utils::generateNodeKey(parent->baseKey(), subheaderKey);
         UId key{UId::create()};
         if(static_cast<int>(m_prevSubheaderKey.size()) > i && m_prevBaseSubheaderKey.at(i) == baseKey
            && index == m_prevIndex + 1) {
@@ -262,7 +264,19 @@ PlaylistItem* PlaylistPopulatorPrivate::iterateTrack(const PlaylistTrack& track,
     TrackRow trackRow{m_currentPreset.track};
     PlaylistTrackItem playlistTrack;
 
-    if(!m_columns.empty()) {
+    if(m_deferRows) {
+        if(!m_columns.empty()) {
+            for(const auto& column : m_columns) {
+                trackRow.columns.emplace_back(column.field);
+            }
+            playlistTrack = {trackRow.columns, track};
+        }
+        else {
+            playlistTrack = {trackRow.leftText, trackRow.rightText, track};
+        }
+        playlistTrack.setDeferred(true);
+    }
+    else if(!m_columns.empty()) {
         for(const auto& column : m_columns) {
             const auto evalScript = m_parser.evaluate(column.field, track.track);
             trackRow.columns.emplace_back(column.field, m_formatter.evaluate(evalScript));
@@ -280,8 +294,7 @@ PlaylistItem* PlaylistPopulatorPrivate::iterateTrack(const PlaylistTrack& track,
     playlistTrack.setDepth(m_trackDepth);
     playlistTrack.calculateSize();
 
-    const auto baseKey
-        = Utils::generateMd5Hash(parent->key().toString(UId::Id128), track.track.hash(), QString::number(index));
+    const auto baseKey = Utils::generateNodeKey(parent->key(), track.track.hash(), index);
     const UId key{UId::create()};
 
     auto* trackItem = getOrInsertItem(key, PlaylistItem::Track, playlistTrack, parent, baseKey);
@@ -377,6 +390,11 @@ void PlaylistPopulator::setPreloadCount(int count)
     p->m_preloadCount = count;
 }
 
+void PlaylistPopulator::setDeferThreshold(int count)
+{
+    p->m_deferThreshold = count;
+}
+
 void PlaylistPopulator::run(Playlist* playlist, const PlaylistPreset& preset, const PlaylistColumnList& columns,
                             const PlaylistTrackList& tracks)
 {
@@ -390,6 +408,7 @@ void PlaylistPopulator::run(Playlist* playlist, const PlaylistPreset& preset, co
     p->m_currentPreset = preset;
     p->m_columns       = columns;
     p->m_pendingTracks = tracks;
+    p->m_deferRows     = p->m_deferThreshold > 0 && std::cmp_greater_equal(tracks.size(), p->m_deferThreshold);
     p->m_registry->setup(playlist, p->m_playerController->playbackQueue());
 
     const int preloadCount = p->m_preloadCount > 0 ? p->m_preloadCount : static_cast<int>(tracks.size());
@@ -434,6 +453,13 @@ void PlaylistPopulator::updateTracks(Playlist* playlist, const PlaylistPreset& p
         PlaylistTrackItem& trackData = std::get<0>(item.data());
 
         trackData.setTrack(track);
+
+        if(trackData.isDeferred()) {
+            // Evaluated by the model the next time the row is shown
+            updatedTracks.push_back(item);
+            continue;
+        }
+
         p->m_registry->setTrackProperties(trackData.track().indexInPlaylist, trackData.depth());
 
         if(!columnsToUpdate.empty()) {
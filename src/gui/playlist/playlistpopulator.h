@@ -75,6 +75,12 @@ public:
     void setFont(const QFont& font);
     void setUseVarious(bool enabled);
     void setPreloadCount(int count);
+    /*!
+     * Playlists with at least @p count tracks only have their headers and subheaders evaluated up front.
+     * Track rows are marked as deferred and evaluated by the model when first shown.
+     * A count of 0 disables deferring.
+     */
+    void setDeferThreshold(int count);
 
     void run(Playlist* playlist, const PlaylistPreset& preset, const PlaylistColumnList& columns,
              const PlaylistTrackList& tracks);
@@ -0,0 +1,138 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "playlistrowcache.h"
+
+#include "playlistscriptregistry.h"
+
+#include <core/player/playercontroller.h>
+
+// Enough for several screens of rows so scrolling back doesn't re-evaluate
+constexpr auto RowCacheLimit = 2000;
+
+namespace Fooyin {
+PlaylistRowCache::PlaylistRowCache(PlayerController* playerController)
+    : m_playerController{playerController}
+    , m_registry{new PlaylistScriptRegistry()}
+    , m_parser{m_registry}
+{ }
+
+void PlaylistRowCache::setFont(const QFont& font)
+{
+    m_formatter.setBaseFont(font);
+    clear();
+}
+
+void PlaylistRowCache::setUseVarious(bool enabled)
+{
+    m_registry->setUseVariousArtists(enabled);
+}
+
+void PlaylistRowCache::setup(Playlist* playlist, const PlaylistPreset& preset, const PlaylistColumnList& columns)
+{
+    m_preset  = preset;
+    m_columns = columns;
+    m_registry->setup(playlist, m_playerController->playbackQueue());
+}
+
+bool PlaylistRowCache::contains(const UId& key) const
+{
+    return m_index.contains(key);
+}
+
+PlaylistTrackItem PlaylistRowCache::row(const UId& key, const PlaylistTrackItem& item)
+{
+    if(const auto it = m_index.find(key); it != m_index.end()) {
+        const PlaylistTrackItem& cached = it->second->item;
+        // Index and depth based variables (e.g. %list_index%) change when rows are moved
+        if(cached.index() == item.index() && cached.depth() == item.depth()) {
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+            return cached;
+        }
+        m_entries.erase(it->second);
+        m_index.erase(it);
+    }
+
+    m_entries.push_front({.key = key, .item = evaluate(item)});
+    m_index.emplace(key, m_entries.begin());
+
+    while(m_entries.size() > RowCacheLimit) {
+        m_index.erase(m_entries.back().key);
+        m_entries.pop_back();
+    }
+
+    return m_entries.front().item;
+}
+
+void PlaylistRowCache::invalidate(const UId& key)
+{
+    if(const auto it = m_index.find(key); it != m_index.end()) {
+        m_entries.erase(it->second);
+        m_index.erase(it);
+    }
+}
+
+void PlaylistRowCache::clear()
+{
+    m_index.clear();
+    m_entries.clear();
+}
+
+PlaylistTrackItem PlaylistRowCache::evaluate(const PlaylistTrackItem& item)
+{
+    const PlaylistTrack track = item.track();
+
+    m_registry->setTrackProperties(track.indexInPlaylist, item.depth());
+
+    PlaylistTrackItem playlistTrack;
+
+    if(!m_columns.empty()) {
+        std::vector<RichScript> columns;
+        for(const auto& column : m_columns) {
+            const auto evalScript = m_parser.evaluate(column.field, track.track);
+            columns.emplace_back(column.field, m_formatter.evaluate(evalScript));
+        }
+        playlistTrack = {columns, track};
+    }
+    else {
+        RichScript left{m_preset.track.leftText};
+        RichScript right{m_preset.track.rightText};
+
+        evaluateScript(left, track.track);
+        evaluateScript(right, track.track);
+
+        playlistTrack = {left, right, track};
+    }
+
+    playlistTrack.setRowHeight(item.rowHeight());
+    playlistTrack.setDepth(item.depth());
+    playlistTrack.calculateSize();
+
+    return playlistTrack;
+}
+
+void PlaylistRowCache::evaluateScript(RichScript& script, const Track& track)
+{
+    script.text.clear();
+    const auto evalScript = m_parser.evaluate(script.script, track);
+    if(!evalScript.isEmpty()) {
+        script.text = m_formatter.evaluate(evalScript);
+    }
+}
+} // namespace Fooyin
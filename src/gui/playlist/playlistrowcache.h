@@ -0,0 +1,79 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "playlistcolumn.h"
+#include "playlistitemmodels.h"
+#include "playlistpreset.h"
+
+#include <core/scripting/scriptparser.h>
+#include <gui/scripting/scriptformatter.h>
+#include <utils/id.h>
+
+#include <list>
+
+namespace Fooyin {
+class PlayerController;
+class PlaylistScriptRegistry;
+
+/*!
+ * Evaluates deferred playlist rows on demand and keeps the most recently shown ones.
+ * Used for large playlists where only the header and subheader grouping is evaluated up front.
+ */
+class PlaylistRowCache
+{
+public:
+    explicit PlaylistRowCache(PlayerController* playerController);
+
+    void setFont(const QFont& font);
+    void setUseVarious(bool enabled);
+    void setup(Playlist* playlist, const PlaylistPreset& preset, const PlaylistColumnList& columns);
+
+    [[nodiscard]] bool contains(const UId& key) const;
+    /** Returns @p item with its text evaluated, evaluating and caching it if needed. */
+    PlaylistTrackItem row(const UId& key, const PlaylistTrackItem& item);
+
+    void invalidate(const UId& key);
+    void clear();
+
+private:
+    PlaylistTrackItem evaluate(const PlaylistTrackItem& item);
+    void evaluateScript(RichScript& script, const Track& track);
+
+    struct Entry
+    {
+        UId key;
+        PlaylistTrackItem item;
+    };
+    using EntryList = std::list<Entry>;
+
+    PlayerController* m_playerController;
+
+    PlaylistPreset m_preset;
+    PlaylistColumnList m_columns;
+
+    PlaylistScriptRegistry* m_registry;
+    ScriptParser m_parser;
+    ScriptFormatter m_formatter;
+
+    EntryList m_entries;
+    std::unordered_map<UId, EntryList::iterator, UId::UIdHash> m_index;
+};
+} // namespace Fooyin
@@ -169,6 +169,26 @@ ScriptResult PlaylistScriptRegistry::value(const QString& var, const Track& trac
     return ScriptRegistry::value(var, track);
 }
 
+ScriptRegistry::VariableFunc PlaylistScriptRegistry::variableResolver(const QString& var) const
+{
+    if(isListVariable(var)) {
+        return [](const Track& /*track*/) {
+            return ScriptResult{.value = u"|Loading|"_s, .cond = true};
+        };
+    }
+
+    if(p->m_vars.contains(var)) {
+        return [func = p->m_vars.at(var)](const Track& /*track*/) {
+            ScriptResult result;
+            result.value = func();
+            result.cond  = !result.value.isEmpty();
+            return result;
+        };
+    }
+
+    return ScriptRegistry::variableResolver(var);
+}
+
 ScriptResult PlaylistScriptRegistry::calculateResult(FuncRet funcRet) const
 {
     ScriptResult result = ScriptRegistry::calculateResult(funcRet);
@@ -1808,8 +1808,9 @@ void PlaylistWidget::searchEvent(const QString& search)
     };
 
     auto filterAndHandleTracks = [this, handleFilteredTracks](const PlaylistTrackList& tracks) {
-        Utils::asyncExec([search = p->m_search, tracks]() {
+        Utils::asyncExec([search = p->m_search, tracks, searchIndex = p->m_library->searchIndex()]() {
             ScriptParser parser;
+            parser.setSearchIndex(searchIndex);
             return parser.filter(search, tracks);
         }).then(this, handleFilteredTracks);
     };
@@ -453,8 +453,11 @@ void SearchWidget::searchChanged(bool enterKey)
 
     const auto mode = m_forceMode ? std::exchange(m_forceMode, {}).value() : m_mode; // NOLINT
 
-    Utils::asyncExec([search = m_searchBox->text(), tracks = getTracksToSearch(mode)]() {
+    const auto searchIndex = m_library->searchIndex();
+
+    Utils::asyncExec([search = m_searchBox->text(), tracks = getTracksToSearch(mode), searchIndex]() {
         ScriptParser parser;
+        parser.setSearchIndex(searchIndex);
         return parser.filter(search, tracks);
     }).then(this, [this, mode, enterKey](const PlaylistTrackList& filteredTracks) {
         if(handleFilteredTracks(mode, filteredTracks) && enterKey) {
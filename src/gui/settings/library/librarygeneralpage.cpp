@@ -35,11 +35,14 @@
 #include <QFileInfo>
 #include <QGridLayout>
 #include <QGroupBox>
+#include <QHBoxLayout>
 #include <QHeaderView>
 #include <QInputDialog>
 #include <QLabel>
 #include <QMenu>
 #include <QPushButton>
+#include <QSpinBox>
+#include <QThread>
 
 using namespace Qt::StringLiterals;
 
@@ -105,8 +108,10 @@ private:
 
     QLineEdit* m_restrictTypes;
     QLineEdit* m_excludeTypes;
+    QSpinBox* m_scanThreads;
 
     QCheckBox* m_autoRefresh;
+    QCheckBox* m_skipUnchanged;
     QCheckBox* m_monitorLibraries;
     QCheckBox* m_markUnavailable;
     QCheckBox* m_markUnavailableStart;
@@ -124,7 +129,9 @@ LibraryGeneralPageWidget::LibraryGeneralPageWidget(ActionManager* actionManager,
     , m_model{new LibraryModel(m_libraryManager, this)}
     , m_restrictTypes{new QLineEdit(this)}
     , m_excludeTypes{new QLineEdit(this)}
+    , m_scanThreads{new QSpinBox(this)}
     , m_autoRefresh{new QCheckBox(tr("Auto refresh on startup"), this)}
+    , m_skipUnchanged{new QCheckBox(tr("Skip unchanged directories when refreshing"), this)}
     , m_monitorLibraries{new QCheckBox(tr("Monitor libraries"), this)}
     , m_markUnavailable{new QCheckBox(tr("Mark unavailable tracks on playback"), this)}
     , m_markUnavailableStart{new QCheckBox(tr("Mark unavailable tracks on startup"), this)}
@@ -142,6 +149,9 @@ LibraryGeneralPageWidget::LibraryGeneralPageWidget(ActionManager* actionManager,
     m_libraryView->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
 
     m_autoRefresh->setToolTip(tr("Scan libraries for changes on startup"));
+    m_skipUnchanged->setToolTip(tr("Only read directories which have had files added, removed or renamed since the "
+                                   "last scan. Files edited in place by other applications are found when monitoring "
+                                   "libraries or by a full rescan."));
     m_monitorLibraries->setToolTip(tr("Monitor libraries for external changes"));
 
     auto* fileTypesGroup  = new QGroupBox(tr("File Types"), this);
@@ -155,12 +165,22 @@ LibraryGeneralPageWidget::LibraryGeneralPageWidget(ActionManager* actionManager,
     fileTypesLayout->addWidget(new QLabel(u"🛈 e.g. \"mp3;m4a\""_s, this), row++, 1);
     fileTypesLayout->setColumnStretch(1, 1);
 
+    m_scanThreads->setRange(1, 64);
+    m_scanThreads->setToolTip(tr("Number of files to read tags from at the same time when scanning"));
+
+    auto* scanThreadsLayout = new QHBoxLayout();
+    scanThreadsLayout->addWidget(new QLabel(tr("Tag reader threads") + ":"_L1, this));
+    scanThreadsLayout->addWidget(m_scanThreads);
+    scanThreadsLayout->addStretch();
+
     auto* mainLayout = new QGridLayout(this);
 
     row = 0;
     mainLayout->addWidget(m_libraryView, row++, 0, 1, 2);
     mainLayout->addWidget(fileTypesGroup, row++, 0, 1, 2);
+    mainLayout->addLayout(scanThreadsLayout, row++, 0, 1, 2);
     mainLayout->addWidget(m_autoRefresh, row++, 0, 1, 2);
+    mainLayout->addWidget(m_skipUnchanged, row++, 0, 1, 2);
     mainLayout->addWidget(m_monitorLibraries, row++, 0, 1, 2);
     mainLayout->addWidget(m_markUnavailable, row++, 0, 1, 2);
     mainLayout->addWidget(m_markUnavailableStart, row++, 0, 1, 2);
@@ -185,8 +205,11 @@ void LibraryGeneralPageWidget::load()
 
     m_restrictTypes->setText(restrictExtensions.join(u';'));
     m_excludeTypes->setText(excludeExtensions.join(u';'));
+    m_scanThreads->setValue(
+        m_settings->fileValue(Settings::Core::Internal::LibraryScanThreads, QThread::idealThreadCount()).toInt());
 
     m_autoRefresh->setChecked(m_settings->value<Settings::Core::AutoRefresh>());
+    m_skipUnchanged->setChecked(m_settings->fileValue(Settings::Core::Internal::LibrarySkipUnchanged, false).toBool());
     m_monitorLibraries->setChecked(m_settings->value<Settings::Core::Internal::MonitorLibraries>());
     m_markUnavailable->setChecked(m_settings->fileValue(Settings::Core::Internal::MarkUnavailable, false).toBool());
     m_markUnavailableStart->setChecked(
@@ -204,8 +227,10 @@ void LibraryGeneralPageWidget::apply()
                         m_restrictTypes->text().split(u';', Qt::SkipEmptyParts));
     m_settings->fileSet(Settings::Core::Internal::LibraryExcludeTypes,
                         m_excludeTypes->text().split(u';', Qt::SkipEmptyParts));
+    m_settings->fileSet(Settings::Core::Internal::LibraryScanThreads, m_scanThreads->value());
 
     m_settings->set<Settings::Core::AutoRefresh>(m_autoRefresh->isChecked());
+    m_settings->fileSet(Settings::Core::Internal::LibrarySkipUnchanged, m_skipUnchanged->isChecked());
     m_settings->set<Settings::Core::Internal::MonitorLibraries>(m_monitorLibraries->isChecked());
     m_settings->fileSet(Settings::Core::Internal::MarkUnavailable, m_markUnavailable->isChecked());
     m_settings->fileSet(Settings::Core::Internal::MarkUnavailableStartup, m_markUnavailableStart->isChecked());
@@ -218,8 +243,10 @@ void LibraryGeneralPageWidget::reset()
 {
     m_settings->fileRemove(Settings::Core::Internal::LibraryRestrictTypes);
     m_settings->fileRemove(Settings::Core::Internal::LibraryExcludeTypes);
+    m_settings->fileRemove(Settings::Core::Internal::LibraryScanThreads);
 
     m_settings->reset<Settings::Core::AutoRefresh>();
+    m_settings->fileRemove(Settings::Core::Internal::LibrarySkipUnchanged);
     m_settings->reset<Settings::Core::Internal::MonitorLibraries>();
     m_settings->fileRemove(Settings::Core::Internal::MarkUnavailable);
     m_settings->fileRemove(Settings::Core::Internal::MarkUnavailableStartup);
@@ -79,6 +79,7 @@ private:
     DecoderModel* m_readerModel;
 
     QCheckBox* m_ffmpegAllExts;
+    QCheckBox* m_ffmpegSeekIndex;
 };
 
 DecoderPageWidget::DecoderPageWidget(AudioLoader* audioLoader, SettingsManager* settings)
@@ -89,6 +90,7 @@ DecoderPageWidget::DecoderPageWidget(AudioLoader* audioLoader, SettingsManager*
     , m_readerList{new QListView(this)}
     , m_readerModel{new DecoderModel(this)}
     , m_ffmpegAllExts{new QCheckBox(tr("Enable all supported extensions"), this)}
+    , m_ffmpegSeekIndex{new QCheckBox(tr("Build seek index for VBR MP3 and AAC streams"), this)}
 {
     auto setupModel = [](QAbstractItemView* view) {
         view->setDragDropMode(QAbstractItemView::InternalMove);
@@ -107,7 +109,10 @@ DecoderPageWidget::DecoderPageWidget(AudioLoader* audioLoader, SettingsManager*
     auto* ffmpegGroup       = new QGroupBox(u"FFmpeg"_s, this);
     auto* ffmpegGroupLayout = new QGridLayout(ffmpegGroup);
 
+    m_ffmpegSeekIndex->setToolTip(tr("Record packet positions during playback to allow fast, accurate seeking"));
+
     ffmpegGroupLayout->addWidget(m_ffmpegAllExts);
+    ffmpegGroupLayout->addWidget(m_ffmpegSeekIndex);
 
     auto* layout = new QGridLayout(this);
     layout->addWidget(new QLabel(tr("Decoders") + ":"_L1, this), 0, 0);
@@ -126,6 +131,7 @@ void DecoderPageWidget::load()
     m_decoderModel->setup(m_audioLoader->decoders());
     m_readerModel->setup(m_audioLoader->readers());
     m_ffmpegAllExts->setChecked(m_settings->fileValue(Settings::Core::Internal::FFmpegAllExtensions).toBool());
+    m_ffmpegSeekIndex->setChecked(m_settings->fileValue(Settings::Core::Internal::FFmpegSeekIndex, true).toBool());
 }
 
 void DecoderPageWidget::apply()
@@ -144,6 +150,7 @@ void DecoderPageWidget::apply()
         m_audioLoader->reloadDecoderExtensions(u"FFmpeg"_s);
         m_audioLoader->reloadReaderExtensions(u"FFmpeg"_s);
     }
+    m_settings->fileSet(Settings::Core::Internal::FFmpegSeekIndex, m_ffmpegSeekIndex->isChecked());
 
     load();
 }
@@ -152,6 +159,7 @@ void DecoderPageWidget::reset()
 {
     m_audioLoader->reset();
     m_settings->fileRemove(Settings::Core::Internal::FFmpegAllExtensions);
+    m_settings->fileRemove(Settings::Core::Internal::FFmpegSeekIndex);
 }
 
 DecoderPage::DecoderPage(AudioLoader* audioLoader, SettingsManager* settings, QObject* parent)
@@ -61,6 +61,7 @@ private:
     SettingsManager* m_settings;
 
     QSpinBox* m_preloadCount;
+    QSpinBox* m_deferThreshold;
 
     QComboBox* m_middleClick;
 
@@ -90,6 +91,7 @@ PlaylistGeneralPageWidget::PlaylistGeneralPageWidget(const QStringList& playlist
     : m_playlistExtensions{playlistExtensions}
     , m_settings{settings}
     , m_preloadCount{new QSpinBox(this)}
+    , m_deferThreshold{new QSpinBox(this)}
     , m_middleClick{new QComboBox(this)}
     , m_scrollBars{new QCheckBox(tr("Show scrollbar"), this)}
     , m_header{new QCheckBox(tr("Show header"), this)}
@@ -121,10 +123,25 @@ PlaylistGeneralPageWidget::PlaylistGeneralPageWidget(const QStringList& playlist
     m_preloadCount->setMaximum(10000);
     m_preloadCount->setSuffix(tr(" tracks"));
 
+    auto* deferThresholdLabel = new QLabel(tr("Evaluate rows on demand from") + ":"_L1, this);
+    const auto deferTooltip
+        = tr("Playlists with at least this many tracks only evaluate columns for rows as they are shown");
+    deferThresholdLabel->setToolTip(deferTooltip);
+    m_deferThreshold->setToolTip(deferTooltip);
+
+    m_deferThreshold->setMinimum(0);
+    m_deferThreshold->setMaximum(1000000);
+    m_deferThreshold->setSingleStep(1000);
+    m_deferThreshold->setSuffix(tr(" tracks"));
+
     int row{0};
     behaviourLayout->addWidget(preloadCountLabel, row, 0);
     behaviourLayout->addWidget(m_preloadCount, row++, 1);
     behaviourLayout->addWidget(new QLabel(u"🛈 "_s + tr("Set to '0' to disable preloading."), this), row++, 0, 1, 2);
+    behaviourLayout->addWidget(deferThresholdLabel, row, 0);
+    behaviourLayout->addWidget(m_deferThreshold, row++, 1);
+    behaviourLayout->addWidget(new QLabel(u"🛈 "_s + tr("Set to '0' to always evaluate every row."), this), row++, 0,
+                               1, 2);
     behaviourLayout->setColumnStretch(behaviourLayout->columnCount(), 1);
 
     auto* clickBehaviour       = new QGroupBox(tr("Click Behaviour"), this);
@@ -234,6 +251,7 @@ PlaylistGeneralPageWidget::PlaylistGeneralPageWidget(const QStringList& playlist
 void PlaylistGeneralPageWidget::load()
 {
     m_preloadCount->setValue(m_settings->value<Settings::Gui::Internal::PlaylistTrackPreloadCount>());
+    m_deferThreshold->setValue(m_settings->value<Settings::Gui::Internal::PlaylistDeferThreshold>());
 
     using ActionIndexMap = std::map<int, int>;
     ActionIndexMap middleActions;
@@ -287,6 +305,7 @@ void PlaylistGeneralPageWidget::load()
 void PlaylistGeneralPageWidget::apply()
 {
     m_settings->set<Settings::Gui::Internal::PlaylistTrackPreloadCount>(m_preloadCount->value());
+    m_settings->set<Settings::Gui::Internal::PlaylistDeferThreshold>(m_deferThreshold->value());
 
     m_settings->set<Settings::Gui::Internal::PlaylistMiddleClick>(m_middleClick->currentData().toInt());
 
@@ -316,6 +335,7 @@ void PlaylistGeneralPageWidget::apply()
 void PlaylistGeneralPageWidget::reset()
 {
     m_settings->reset<Settings::Gui::Internal::PlaylistTrackPreloadCount>();
+    m_settings->reset<Settings::Gui::Internal::PlaylistDeferThreshold>();
 
     m_settings->reset<Settings::Gui::Internal::PlaylistMiddleClick>();
 
@@ -32,6 +32,15 @@ ScriptResult FileOpsRegistry::value(const QString& var, const Track& track) cons
     return result;
 }
 
+ScriptRegistry::VariableFunc FileOpsRegistry::variableResolver(const QString& var) const
+{
+    return [resolver = ScriptRegistry::variableResolver(var)](const Track& track) {
+        ScriptResult result = resolver(track);
+        result.value        = replaceSeparators(result.value);
+        return result;
+    };
+}
+
 QString FileOpsRegistry::replaceSeparators(const QString& input)
 {
     static const QRegularExpression regex{uR"([/\\])"_s};
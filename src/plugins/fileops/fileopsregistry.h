@@ -27,6 +27,7 @@ class FileOpsRegistry : public ScriptRegistry
 public:
     using ScriptRegistry::value;
     [[nodiscard]] ScriptResult value(const QString& var, const Track& track) const override;
+    [[nodiscard]] VariableFunc variableResolver(const QString& var) const override;
 
     static QString replaceSeparators(const QString& input);
 };
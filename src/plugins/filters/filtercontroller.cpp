@@ -23,11 +23,13 @@
 #include "filtermanager.h"
 #include "filterwidget.h"
 #include "settings/filtersettings.h"
+#include "trackidbitmap.h"
 
 #include <core/coresettings.h>
 #include <core/library/musiclibrary.h>
 #include <core/library/tracksort.h>
 #include <core/plugins/coreplugincontext.h>
+#include <core/scripting/incrementalfilter.h>
 #include <core/scripting/scriptparser.h>
 #include <gui/coverprovider.h>
 #include <gui/editablelayout.h>
@@ -44,20 +46,7 @@
 namespace {
 Fooyin::TrackList trackIntersection(const Fooyin::TrackList& v1, const Fooyin::TrackList& v2)
 {
-    Fooyin::TrackList result;
-    std::unordered_set<int> ids;
-
-    for(const auto& track : v1) {
-        ids.emplace(track.id());
-    }
-
-    for(const auto& track : v2) {
-        if(ids.contains(track.id())) {
-            result.push_back(track);
-        }
-    }
-
-    return result;
+    return Fooyin::Filters::TrackIdBitmap::fromTracks(v1).filter(v2);
 }
 } // namespace
 
@@ -93,7 +82,8 @@ public:
     void removeLibraryTracks(int libraryId);
     void handleTracksAddedUpdated(const TrackList& tracks, bool updated = false);
     void refreshFilters(const Id& groupId);
-    void searchChanged(FilterWidget* filter, const QString& search) const;
+    void invalidateSearches() const;
+    void searchChanged(FilterWidget* filter, const QString& search);
 
     FilterController* m_self;
 
@@ -111,6 +101,7 @@ public:
     Id m_defaultId{"Default"};
     FilterGroups m_groups;
     std::unordered_map<Id, FilterWidget*, Id::IdHash> m_ungrouped;
+    std::unordered_map<FilterWidget*, std::shared_ptr<IncrementalFilter<TrackList>>> m_searchFilters;
 
     TrackAction m_doubleClickAction;
     TrackAction m_middleClickAction;
@@ -311,14 +302,23 @@ void FilterControllerPrivate::getFilteredTracks(const Id& groupId)
 
     auto activeFilters = group.filters | std::views::filter([](FilterWidget* widget) { return widget->isActive(); });
 
+    // Intersect the selections of all active filters, then resolve the ids against the first one
+    TrackList firstTracks;
+    TrackIdBitmap selectedIds;
+
     for(auto& filter : activeFilters) {
-        if(group.filteredTracks.empty()) {
-            std::ranges::copy(filter->filteredTracks(), std::back_inserter(group.filteredTracks));
+        if(firstTracks.empty()) {
+            firstTracks = filter->filteredTracks();
+            selectedIds = filter->filteredIds();
         }
         else {
-            group.filteredTracks = trackIntersection(filter->filteredTracks(), group.filteredTracks);
+            selectedIds &= filter->filteredIds();
         }
     }
+
+    if(!firstTracks.empty()) {
+        group.filteredTracks = selectedIds.filter(firstTracks);
+    }
 }
 
 void FilterControllerPrivate::clearActiveFilters(const Id& group, int index)
@@ -422,8 +422,10 @@ void FilterControllerPrivate::handleTracksAddedUpdated(const TrackList& tracks,
             }
 
             if(!filterWidget->searchFilter().isEmpty()) {
-                Utils::asyncExec([search = filterWidget->searchFilter(), tracks]() {
+                const auto searchIndex = m_library->searchIndex();
+                Utils::asyncExec([search = filterWidget->searchFilter(), tracks, searchIndex]() {
                     ScriptParser parser;
+                    parser.setSearchIndex(searchIndex);
                     return parser.filter(search, tracks);
                 }).then(m_self, [filterWidget, updated](const TrackList& filteredTracks) {
                     if(updated) {
@@ -486,7 +488,14 @@ void FilterControllerPrivate::refreshFilters(const Id& groupId)
     }
 }
 
-void FilterControllerPrivate::searchChanged(FilterWidget* filter, const QString& search) const
+void FilterControllerPrivate::invalidateSearches() const
+{
+    for(const auto& searchFilter : m_searchFilters | std::views::values) {
+        searchFilter->invalidate();
+    }
+}
+
+void FilterControllerPrivate::searchChanged(FilterWidget* filter, const QString& search)
 {
     const Id groupId = filter->group();
 
@@ -499,10 +508,15 @@ void FilterControllerPrivate::searchChanged(FilterWidget* filter, const QString&
         return;
     }
 
+    auto& searchFilter = m_searchFilters[filter];
+    if(!searchFilter) {
+        searchFilter = std::make_shared<IncrementalFilter<TrackList>>();
+        searchFilter->setSearchIndex(m_library->searchIndex());
+    }
+
     const TrackList tracksToFilter = m_library->tracks();
-    Utils::asyncExec([search, tracksToFilter]() {
-        ScriptParser parser;
-        return parser.filter(search, tracksToFilter);
+    Utils::asyncExec([search, tracksToFilter, searchFilter, generation = searchFilter->generation()]() {
+        return searchFilter->filter(search, tracksToFilter, generation);
     }).then(m_self, [filter](const TrackList& filteredTracks) { filter->reset(filteredTracks); });
 }
 
@@ -511,6 +525,11 @@ FilterController::FilterController(const CorePluginContext& core, TrackSelection
     : QObject{parent}
     , p{std::make_unique<FilterControllerPrivate>(this, core, trackSelection, editableLayout, settings)}
 {
+    // Must run before the filters are repopulated with the changed tracks
+    QObject::connect(p->m_library, &MusicLibrary::tracksLoaded, this, &FilterController::tracksInvalidated);
+    QObject::connect(p->m_library, &MusicLibrary::tracksMetadataChanged, this, &FilterController::tracksInvalidated);
+    QObject::connect(p->m_library, &MusicLibrary::tracksUpdated, this, &FilterController::tracksInvalidated);
+
     QObject::connect(p->m_library, &MusicLibrary::tracksAdded, this,
                      [this](const TrackList& tracks) { p->handleTracksAddedUpdated(tracks); });
     QObject::connect(p->m_library, &MusicLibrary::tracksScanned, this,
@@ -521,6 +540,14 @@ FilterController::FilterController(const CorePluginContext& core, TrackSelection
     QObject::connect(p->m_library, &MusicLibrary::tracksDeleted, this, &FilterController::tracksRemoved);
     QObject::connect(p->m_library, &MusicLibrary::tracksLoaded, this, [this]() { p->resetAll(); });
     QObject::connect(p->m_library, &MusicLibrary::tracksSorted, this, [this]() { p->resetAll(); });
+
+    const auto invalidateSearches = [this]() { p->invalidateSearches(); };
+    QObject::connect(p->m_library, &MusicLibrary::tracksLoaded, this, invalidateSearches);
+    QObject::connect(p->m_library, &MusicLibrary::tracksAdded, this, invalidateSearches);
+    QObject::connect(p->m_library, &MusicLibrary::tracksMetadataChanged, this, invalidateSearches);
+    QObject::connect(p->m_library, &MusicLibrary::tracksUpdated, this, invalidateSearches);
+    QObject::connect(p->m_library, &MusicLibrary::tracksDeleted, this, invalidateSearches);
+    QObject::connect(p->m_library, &MusicLibrary::tracksSorted, this, invalidateSearches);
 }
 
 FilterController::~FilterController() = default;
@@ -559,6 +586,7 @@ FilterWidget* FilterController::createFilter()
     QObject::connect(this, &FilterController::tracksChanged, widget, &FilterWidget::tracksChanged);
     QObject::connect(this, &FilterController::tracksUpdated, widget, &FilterWidget::tracksUpdated);
     QObject::connect(this, &FilterController::tracksRemoved, widget, &FilterWidget::tracksRemoved);
+    QObject::connect(this, &FilterController::tracksInvalidated, widget, &FilterWidget::tracksInvalidated);
 
     widget->reset(p->tracks(p->m_defaultId));
     p->updateFilterPlaylistActions(widget);
@@ -612,6 +640,8 @@ void FilterController::addFilterToGroup(FilterWidget* widget, const Id& groupId)
 
 bool FilterController::removeFilter(FilterWidget* widget)
 {
+    p->m_searchFilters.erase(widget);
+
     const Id groupId = widget->group();
 
     if(!groupId.isValid() && p->m_ungrouped.contains(widget->id())) {
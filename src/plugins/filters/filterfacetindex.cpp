@@ -0,0 +1,77 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "filterfacetindex.h"
+
+#include <algorithm>
+
+namespace Fooyin::Filters {
+const std::vector<Md5Hash>* FilterFacetIndex::trackFacets(int trackId) const
+{
+    const auto it = m_trackFacets.find(trackId);
+    return it != m_trackFacets.cend() ? &it->second : nullptr;
+}
+
+const FilterFacet* FilterFacetIndex::facet(const Md5Hash& key) const
+{
+    const auto it = m_facets.find(key);
+    return it != m_facets.cend() ? &it->second : nullptr;
+}
+
+void FilterFacetIndex::insert(int trackId, const Md5Hash& key, const QStringList& columns)
+{
+    auto& keys = m_trackFacets[trackId];
+    if(std::ranges::find(keys, key) != keys.cend()) {
+        return;
+    }
+
+    auto [it, inserted] = m_facets.try_emplace(key);
+    if(inserted) {
+        it->second.columns = columns;
+    }
+    ++it->second.trackCount;
+    keys.push_back(key);
+}
+
+void FilterFacetIndex::remove(int trackId)
+{
+    const auto trackIt = m_trackFacets.find(trackId);
+    if(trackIt == m_trackFacets.end()) {
+        return;
+    }
+
+    for(const Md5Hash& key : trackIt->second) {
+        const auto facetIt = m_facets.find(key);
+        if(facetIt == m_facets.end()) {
+            continue;
+        }
+        if(--facetIt->second.trackCount <= 0) {
+            m_facets.erase(facetIt);
+        }
+    }
+
+    m_trackFacets.erase(trackIt);
+}
+
+void FilterFacetIndex::clear()
+{
+    m_facets.clear();
+    m_trackFacets.clear();
+}
+} // namespace Fooyin::Filters
@@ -0,0 +1,57 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <utils/crypto.h>
+
+#include <QStringList>
+
+#include <map>
+#include <unordered_map>
+
+namespace Fooyin::Filters {
+struct FilterFacet
+{
+    QStringList columns;
+    int trackCount{0};
+};
+
+/*!
+ * Maps each value produced by a filter's column script to the ids of the tracks which produce it.
+ *
+ * Once a track has been evaluated, repopulating a filter with it (e.g. after a selection in
+ * an upstream filter) is a lookup instead of a script evaluation. Tracks must be removed
+ * from the index when their metadata changes.
+ */
+class FilterFacetIndex
+{
+public:
+    [[nodiscard]] const std::vector<Md5Hash>* trackFacets(int trackId) const;
+    [[nodiscard]] const FilterFacet* facet(const Md5Hash& key) const;
+
+    void insert(int trackId, const Md5Hash& key, const QStringList& columns);
+    void remove(int trackId);
+    void clear();
+
+private:
+    std::map<Md5Hash, FilterFacet> m_facets;
+    std::unordered_map<int, std::vector<Md5Hash>> m_trackFacets;
+};
+} // namespace Fooyin::Filters
@@ -626,6 +626,8 @@ void FilterModel::refreshTracks(const TrackList& tracks)
 
 void FilterModel::removeTracks(const TrackList& tracks)
 {
+    p->m_populator.invalidateTracks(tracks);
+
     std::set<FilterItem*> items;
 
     for(const Track& track : tracks) {
@@ -658,6 +660,11 @@ void FilterModel::removeTracks(const TrackList& tracks)
     p->updateSummary();
 }
 
+void FilterModel::invalidateTracks(const TrackList& tracks)
+{
+    p->m_populator.invalidateTracks(tracks);
+}
+
 bool FilterModel::removeColumn(int column)
 {
     if(column < 0 || std::cmp_greater_equal(column, p->m_columns.size())) {
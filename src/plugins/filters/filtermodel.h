@@ -90,6 +90,7 @@ public:
     void updateTracks(const TrackList& tracks);
     void refreshTracks(const TrackList& tracks);
     void removeTracks(const TrackList& tracks);
+    void invalidateTracks(const TrackList& tracks);
     bool removeColumn(int column);
 
     void reset(const FilterColumnList& columns, const TrackList& tracks);
@@ -42,12 +42,18 @@ void FilterPopulator::run(const QStringList& columns, const TrackList& tracks, b
     if(auto* registry = m_parser.registry()) {
         registry->setUseVariousArtists(useVarious);
     }
+    if(std::exchange(m_useVarious, useVarious) != useVarious) {
+        m_index.clear();
+    }
 
     const QString newColumns = columns.join("\036"_L1);
     if(std::exchange(m_currentColumns, newColumns) != newColumns) {
         m_script = m_parser.parse(m_currentColumns);
+        m_index.clear();
     }
 
+    applyInvalidations();
+
     const bool success = runBatch(tracks);
 
     setState(Idle);
@@ -57,15 +63,42 @@ void FilterPopulator::run(const QStringList& columns, const TrackList& tracks, b
     }
 }
 
-FilterItem* FilterPopulator::getOrInsertItem(const QStringList& columns)
+void FilterPopulator::invalidateTracks(const TrackList& tracks)
+{
+    const std::scoped_lock lock{m_invalidatedGuard};
+    std::ranges::transform(tracks, std::back_inserter(m_invalidated), &Track::id);
+}
+
+void FilterPopulator::applyInvalidations()
+{
+    std::vector<int> invalidated;
+    {
+        const std::scoped_lock lock{m_invalidatedGuard};
+        invalidated.swap(m_invalidated);
+    }
+
+    for(const int id : invalidated) {
+        m_index.remove(id);
+    }
+}
+
+FilterItem* FilterPopulator::getOrInsertItem(const Md5Hash& key, const QStringList& columns)
 {
-    const auto key = Utils::generateMd5Hash(columns.join(QString{}));
     if(!m_data.items.contains(key)) {
         m_data.items.emplace(key, FilterItem{key, columns, &m_root});
     }
     return &m_data.items.at(key);
 }
 
+FilterItem* FilterPopulator::getOrInsertItem(const QStringList& columns)
+{
+    Utils::KeyHasher hash;
+    for(const QString& column : columns) {
+        hash.addData(column);
+    }
+    return getOrInsertItem(hash.result(), columns);
+}
+
 std::vector<FilterItem*> FilterPopulator::getOrInsertItems(const QList<QStringList>& columnSet)
 {
     std::vector<FilterItem*> items;
@@ -84,6 +117,16 @@ void FilterPopulator::addTrackToNode(const Track& track, FilterItem* node)
 
 void FilterPopulator::iterateTrack(const Track& track)
 {
+    // Tracks seen in an earlier run only need their facets looked up
+    if(const auto* keys = m_index.trackFacets(track.id())) {
+        for(const Md5Hash& key : *keys) {
+            if(const auto* facet = m_index.facet(key)) {
+                addTrackToNode(track, getOrInsertItem(key, facet->columns));
+            }
+        }
+        return;
+    }
+
     const QString columns = m_parser.evaluate(m_script, track);
 
     if(columns.contains(QLatin1String{Constants::UnitSeparator})) {
@@ -94,11 +137,13 @@ void FilterPopulator::iterateTrack(const Track& track)
         const auto nodes = getOrInsertItems(colValues);
         for(FilterItem* node : nodes) {
             addTrackToNode(track, node);
+            m_index.insert(track.id(), node->key(), node->columns());
         }
     }
     else {
         FilterItem* node = getOrInsertItem(columns.split(QLatin1String{Constants::RecordSeparator}));
         addTrackToNode(track, node);
+        m_index.insert(track.id(), node->key(), node->columns());
     }
 }
 
@@ -19,12 +19,15 @@
 
 #pragma once
 
+#include "filterfacetindex.h"
 #include "filteritem.h"
 
 #include <core/scripting/scriptparser.h>
 #include <core/track.h>
 #include <utils/worker.h>
 
+#include <mutex>
+
 namespace Fooyin::Filters {
 using ItemKeyMap     = std::map<Md5Hash, FilterItem>;
 using TrackIdNodeMap = std::unordered_map<int, std::vector<Md5Hash>>;
@@ -50,10 +53,15 @@ public:
 
     void run(const QStringList& columns, const TrackList& tracks, bool useVarious);
 
+    /** Marks @p tracks to be re-evaluated the next time they're populated. Thread-safe. */
+    void invalidateTracks(const TrackList& tracks);
+
 signals:
     void populated(Fooyin::Filters::PendingTreeData data);
 
 private:
+    void applyInvalidations();
+    FilterItem* getOrInsertItem(const Md5Hash& key, const QStringList& columns);
     FilterItem* getOrInsertItem(const QStringList& columns);
     std::vector<FilterItem*> getOrInsertItems(const QList<QStringList>& columnSet);
     void addTrackToNode(const Track& track, FilterItem* node);
@@ -63,7 +71,12 @@ private:
     ScriptParser m_parser;
 
     QString m_currentColumns;
+    bool m_useVarious{false};
     ParsedScript m_script;
+    FilterFacetIndex m_index;
+
+    std::mutex m_invalidatedGuard;
+    std::vector<int> m_invalidated;
 
     FilterItem m_root;
     PendingTreeData m_data;
@@ -26,6 +26,7 @@
 #include "filteritem.h"
 #include "filtermodel.h"
 #include "settings/filtersettings.h"
+#include "trackidbitmap.h"
 
 #include <core/track.h>
 #include <gui/widgets/autoheaderview.h>
@@ -46,14 +47,11 @@
 #include <QJsonObject>
 #include <QMenu>
 
-#include <set>
-
 using namespace Qt::StringLiterals;
 
 namespace {
-Fooyin::TrackList fetchAllTracks(QAbstractItemView* view)
+Fooyin::TrackList fetchAllTracks(QAbstractItemView* view, Fooyin::Filters::TrackIdBitmap& ids)
 {
-    std::set<int> ids;
     Fooyin::TrackList tracks;
 
     const QModelIndex parent;
@@ -65,9 +63,7 @@ Fooyin::TrackList fetchAllTracks(QAbstractItemView* view)
             const auto indexTracks = index.data(Fooyin::Filters::FilterItem::Tracks).value<Fooyin::TrackList>();
 
             for(const Fooyin::Track& track : indexTracks) {
-                const int id = track.id();
-                if(!ids.contains(id)) {
-                    ids.emplace(id);
+                if(ids.add(track.id())) {
                     tracks.push_back(track);
                 }
             }
@@ -179,6 +175,11 @@ TrackList FilterWidget::filteredTracks() const
     return m_filteredTracks;
 }
 
+const TrackIdBitmap& FilterWidget::filteredIds() const
+{
+    return m_filteredIds;
+}
+
 QString FilterWidget::searchFilter() const
 {
     return m_searchStr;
@@ -207,11 +208,13 @@ void FilterWidget::refetchFilteredTracks()
 void FilterWidget::setFilteredTracks(const TrackList& tracks)
 {
     m_filteredTracks = tracks;
+    m_filteredIds    = TrackIdBitmap::fromTracks(tracks);
 }
 
 void FilterWidget::clearFilteredTracks()
 {
     m_filteredTracks.clear();
+    m_filteredIds.clear();
 }
 
 void FilterWidget::reset(const TrackList& tracks)
@@ -387,6 +390,7 @@ void FilterWidget::finalise()
 void FilterWidget::searchEvent(const QString& search)
 {
     m_filteredTracks.clear();
+    m_filteredIds.clear();
     emit requestSearch(search);
     m_searchStr = search;
 }
@@ -451,6 +455,11 @@ void FilterWidget::tracksRemoved(const TrackList& tracks)
     m_model->removeTracks(tracks);
 }
 
+void FilterWidget::tracksInvalidated(const TrackList& tracks)
+{
+    m_model->invalidateTracks(tracks);
+}
+
 void FilterWidget::addFilterHeaderMenu(QMenu* menu, const QPoint& pos)
 {
     auto* columnsMenu = new QMenu(FilterWidget::tr("Columns"), menu);
@@ -585,6 +594,7 @@ void FilterWidget::setupConnections()
 void FilterWidget::refreshFilteredTracks()
 {
     m_filteredTracks.clear();
+    m_filteredIds.clear();
 
     const QModelIndexList selected = m_view->selectionModel()->selectedRows();
 
@@ -593,17 +603,22 @@ void FilterWidget::refreshFilteredTracks()
     }
 
     TrackList selectedTracks;
+    // Tracks with multiple values (e.g. artists) can be in several selected items
+    TrackIdBitmap selectedIds;
 
     for(const auto& selectedIndex : selected) {
         if(selectedIndex.data(FilterItem::IsSummary).toBool()) {
-            selectedTracks = fetchAllTracks(m_view);
+            selectedIds.clear();
+            selectedTracks = fetchAllTracks(m_view, selectedIds);
             break;
         }
         const auto newTracks = selectedIndex.data(FilterItem::Tracks).value<TrackList>();
-        std::ranges::copy(newTracks, std::back_inserter(selectedTracks));
+        std::ranges::copy_if(newTracks, std::back_inserter(selectedTracks),
+                             [&selectedIds](const Track& track) { return selectedIds.add(track.id()); });
     }
 
     m_filteredTracks = selectedTracks;
+    m_filteredIds    = std::move(selectedIds);
 }
 
 void FilterWidget::handleSelectionChanged(const QItemSelection& selected, const QItemSelection& deselected)
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "filterfwd.h"
+#include "trackidbitmap.h"
 
 #include <core/track.h>
 #include <gui/fywidget.h>
@@ -54,6 +55,8 @@ public:
     [[nodiscard]] bool isActive() const;
     [[nodiscard]] TrackList tracks() const;
     [[nodiscard]] TrackList filteredTracks() const;
+    /** Returns the ids of filteredTracks, kept in sync with the selection. */
+    [[nodiscard]] const TrackIdBitmap& filteredIds() const;
     [[nodiscard]] QString searchFilter() const;
     [[nodiscard]] WidgetContext* widgetContext() const;
 
@@ -78,6 +81,7 @@ public:
     void tracksChanged(const TrackList& tracks);
     void tracksUpdated(const TrackList& tracks);
     void tracksRemoved(const TrackList& tracks);
+    void tracksInvalidated(const TrackList& tracks);
 
     void addFilterHeaderMenu(QMenu* menu, const QPoint& pos);
 
@@ -129,6 +133,7 @@ private:
     bool m_multipleColumns{false};
     TrackList m_tracks;
     TrackList m_filteredTracks;
+    TrackIdBitmap m_filteredIds;
 
     WidgetContext* m_widgetContext;
 
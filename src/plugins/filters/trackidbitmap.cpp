@@ -0,0 +1,286 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "trackidbitmap.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace {
+// Above this many values a chunk is smaller as a bitset (8KiB) than as an array
+constexpr uint32_t ArrayLimit = 4096;
+constexpr size_t WordCount    = 65536 / 64;
+
+uint16_t highBits(int id)
+{
+    return static_cast<uint16_t>(static_cast<uint32_t>(id) >> 16);
+}
+
+uint16_t lowBits(int id)
+{
+    return static_cast<uint16_t>(static_cast<uint32_t>(id) & 0xFFFF);
+}
+} // namespace
+
+namespace Fooyin::Filters {
+bool TrackIdBitmap::Container::isBitset() const
+{
+    return !words.empty();
+}
+
+bool TrackIdBitmap::Container::contains(uint16_t low) const
+{
+    if(isBitset()) {
+        return (words[low >> 6] >> (low & 63)) & 1;
+    }
+    return std::ranges::binary_search(values, low);
+}
+
+bool TrackIdBitmap::Container::add(uint16_t low)
+{
+    if(isBitset()) {
+        const uint64_t mask = uint64_t{1} << (low & 63);
+        if(words[low >> 6] & mask) {
+            return false;
+        }
+        words[low >> 6] |= mask;
+        ++count;
+        return true;
+    }
+
+    const auto it = std::ranges::lower_bound(values, low);
+    if(it != values.end() && *it == low) {
+        return false;
+    }
+    values.insert(it, low);
+    ++count;
+
+    if(count > ArrayLimit) {
+        toBitset();
+    }
+    return true;
+}
+
+bool TrackIdBitmap::Container::remove(uint16_t low)
+{
+    if(isBitset()) {
+        const uint64_t mask = uint64_t{1} << (low & 63);
+        if(!(words[low >> 6] & mask)) {
+            return false;
+        }
+        words[low >> 6] &= ~mask;
+        --count;
+
+        if(count <= ArrayLimit) {
+            toArray();
+        }
+        return true;
+    }
+
+    const auto it = std::ranges::lower_bound(values, low);
+    if(it == values.end() || *it != low) {
+        return false;
+    }
+    values.erase(it);
+    --count;
+    return true;
+}
+
+void TrackIdBitmap::Container::intersect(const Container& other)
+{
+    if(isBitset() && other.isBitset()) {
+        count = 0;
+        for(size_t i{0}; i < WordCount; ++i) {
+            words[i] &= other.words[i];
+            count += static_cast<uint32_t>(std::popcount(words[i]));
+        }
+        if(count <= ArrayLimit) {
+            toArray();
+        }
+        return;
+    }
+
+    if(isBitset()) {
+        // Result can't be larger than the other array
+        std::vector<uint16_t> result;
+        result.reserve(other.values.size());
+        std::ranges::copy_if(other.values, std::back_inserter(result), [this](uint16_t low) { return contains(low); });
+        words.clear();
+        values = std::move(result);
+    }
+    else if(other.isBitset()) {
+        std::erase_if(values, [&other](uint16_t low) { return !other.contains(low); });
+    }
+    else {
+        std::vector<uint16_t> result;
+        result.reserve(std::min(values.size(), other.values.size()));
+        std::ranges::set_intersection(values, other.values, std::back_inserter(result));
+        values = std::move(result);
+    }
+
+    count = static_cast<uint32_t>(values.size());
+}
+
+void TrackIdBitmap::Container::toBitset()
+{
+    words.assign(WordCount, 0);
+    for(const uint16_t low : values) {
+        words[low >> 6] |= uint64_t{1} << (low & 63);
+    }
+    values.clear();
+    values.shrink_to_fit();
+}
+
+void TrackIdBitmap::Container::toArray()
+{
+    values.clear();
+    values.reserve(count);
+    for(size_t i{0}; i < WordCount; ++i) {
+        uint64_t word = words[i];
+        while(word != 0) {
+            values.push_back(static_cast<uint16_t>((i << 6) + static_cast<size_t>(std::countr_zero(word))));
+            word &= word - 1;
+        }
+    }
+    words.clear();
+    words.shrink_to_fit();
+}
+
+TrackIdBitmap TrackIdBitmap::fromTracks(const TrackList& tracks)
+{
+    TrackIdBitmap bitmap;
+    for(const Track& track : tracks) {
+        bitmap.add(track.id());
+    }
+    return bitmap;
+}
+
+bool TrackIdBitmap::isEmpty() const
+{
+    return m_containers.empty();
+}
+
+size_t TrackIdBitmap::cardinality() const
+{
+    size_t total{0};
+    for(const auto& container : m_containers) {
+        total += container.count;
+    }
+    return total;
+}
+
+bool TrackIdBitmap::contains(int id) const
+{
+    if(id < 0) {
+        return false;
+    }
+
+    const auto* container = findContainer(highBits(id));
+    return container && container->contains(lowBits(id));
+}
+
+bool TrackIdBitmap::add(int id)
+{
+    if(id < 0) {
+        return false;
+    }
+
+    const uint16_t key = highBits(id);
+    auto it = std::ranges::lower_bound(m_containers, key, {}, &Container::key);
+    if(it == m_containers.end() || it->key != key) {
+        Container container;
+        container.key = key;
+        it            = m_containers.insert(it, std::move(container));
+    }
+
+    return it->add(lowBits(id));
+}
+
+bool TrackIdBitmap::remove(int id)
+{
+    if(id < 0) {
+        return false;
+    }
+
+    const uint16_t key = highBits(id);
+    const auto it      = std::ranges::lower_bound(m_containers, key, {}, &Container::key);
+    if(it == m_containers.end() || it->key != key) {
+        return false;
+    }
+
+    if(!it->remove(lowBits(id))) {
+        return false;
+    }
+    if(it->count == 0) {
+        m_containers.erase(it);
+    }
+    return true;
+}
+
+void TrackIdBitmap::clear()
+{
+    m_containers.clear();
+}
+
+TrackIdBitmap& TrackIdBitmap::operator&=(const TrackIdBitmap& other)
+{
+    std::vector<Container> result;
+    result.reserve(std::min(m_containers.size(), other.m_containers.size()));
+
+    auto lhs = m_containers.begin();
+    auto rhs = other.m_containers.cbegin();
+
+    while(lhs != m_containers.end() && rhs != other.m_containers.cend()) {
+        if(lhs->key < rhs->key) {
+            ++lhs;
+        }
+        else if(rhs->key < lhs->key) {
+            ++rhs;
+        }
+        else {
+            lhs->intersect(*rhs);
+            if(lhs->count > 0) {
+                result.push_back(std::move(*lhs));
+            }
+            ++lhs;
+            ++rhs;
+        }
+    }
+
+    m_containers = std::move(result);
+    return *this;
+}
+
+TrackList TrackIdBitmap::filter(const TrackList& tracks) const
+{
+    TrackList result;
+    std::ranges::copy_if(tracks, std::back_inserter(result),
+                         [this](const Track& track) { return contains(track.id()); });
+    return result;
+}
+
+const TrackIdBitmap::Container* TrackIdBitmap::findContainer(uint16_t key) const
+{
+    const auto it = std::ranges::lower_bound(m_containers, key, {}, &Container::key);
+    if(it == m_containers.cend() || it->key != key) {
+        return nullptr;
+    }
+    return &*it;
+}
+} // namespace Fooyin::Filters
@@ -0,0 +1,79 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <core/track.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace Fooyin::Filters {
+/*!
+ * A compressed set of track ids.
+ *
+ * Ids are split into chunks of 65536 by their high 16 bits. Sparse chunks store their low bits
+ * in a sorted array, dense chunks switch to a bitset, so membership tests, intersections and
+ * counts stay cheap for both small selections and the whole library.
+ */
+class TrackIdBitmap
+{
+public:
+    TrackIdBitmap() = default;
+
+    static TrackIdBitmap fromTracks(const TrackList& tracks);
+
+    [[nodiscard]] bool isEmpty() const;
+    [[nodiscard]] size_t cardinality() const;
+    [[nodiscard]] bool contains(int id) const;
+
+    /** Returns @c true if @p id wasn't already in the set. */
+    bool add(int id);
+    bool remove(int id);
+    void clear();
+
+    TrackIdBitmap& operator&=(const TrackIdBitmap& other);
+
+    /** Returns the tracks of @p tracks contained in the set, in their original order. */
+    [[nodiscard]] TrackList filter(const TrackList& tracks) const;
+
+private:
+    struct Container
+    {
+        uint16_t key{0};
+        uint32_t count{0};
+        // Sorted low bits, used while the chunk is sparse
+        std::vector<uint16_t> values;
+        // Bitset of low bits, used once the chunk is dense
+        std::vector<uint64_t> words;
+
+        [[nodiscard]] bool isBitset() const;
+        [[nodiscard]] bool contains(uint16_t low) const;
+        bool add(uint16_t low);
+        bool remove(uint16_t low);
+        void intersect(const Container& other);
+        void toBitset();
+        void toArray();
+    };
+
+    [[nodiscard]] const Container* findContainer(uint16_t key) const;
+
+    std::vector<Container> m_containers;
+};
+} // namespace Fooyin::Filters
@@ -0,0 +1,248 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "libarchiveindex.h"
+
+#include <utils/crypto.h>
+#include <utils/fypaths.h>
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <mutex>
+
+using namespace Qt::StringLiterals;
+
+namespace {
+constexpr quint32 IndexMagic   = 0x46594149; // FYAI
+constexpr quint32 IndexVersion = 2;
+
+QString indexDir()
+{
+    return Fooyin::Utils::cachePath(u"archives"_s);
+}
+
+std::pair<int64_t, int64_t> archiveStamp(const QString& archivePath)
+{
+    const QFileInfo info{archivePath};
+    if(!info.exists()) {
+        return {-1, -1};
+    }
+    return {info.size(), info.lastModified().toMSecsSinceEpoch()};
+}
+
+bool isStale(const QString& indexPath)
+{
+    QFile file{indexPath};
+    if(!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream stream{&file};
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic{0};
+    quint32 version{0};
+    QString archivePath;
+    qint64 archiveSize{0};
+    qint64 archiveModified{0};
+
+    stream >> magic >> version >> archivePath >> archiveSize >> archiveModified;
+
+    if(stream.status() != QDataStream::Ok || magic != IndexMagic || version != IndexVersion) {
+        return true;
+    }
+
+    const auto [size, modified] = archiveStamp(archivePath);
+    return size != archiveSize || modified != archiveModified;
+}
+
+void pruneOnce()
+{
+    // Checking every index reads the size and modification time of each archive, so only do it once per session
+    static std::once_flag pruned;
+    std::call_once(pruned, &Fooyin::LibArchive::ArchiveIndex::prune);
+}
+} // namespace
+
+namespace Fooyin::LibArchive {
+ArchiveIndex::ArchiveIndex(QString archivePath)
+    : m_archivePath{std::move(archivePath)}
+    , m_archiveSize{-1}
+    , m_archiveModified{-1}
+    , m_valid{false}
+{ }
+
+bool ArchiveIndex::isValid() const
+{
+    return m_valid;
+}
+
+std::optional<ArchiveIndexEntry> ArchiveIndex::entry(const QString& path) const
+{
+    if(m_entries.contains(path)) {
+        return m_entries.at(path);
+    }
+    return {};
+}
+
+QStringList ArchiveIndex::entries() const
+{
+    std::vector<std::pair<int, QString>> ordered;
+    ordered.reserve(m_entries.size());
+
+    for(const auto& [path, entry] : m_entries) {
+        ordered.emplace_back(entry.index, path);
+    }
+    std::ranges::sort(ordered);
+
+    QStringList paths;
+    paths.reserve(static_cast<qsizetype>(ordered.size()));
+    for(const auto& [index, path] : ordered) {
+        paths.emplace_back(path);
+    }
+
+    return paths;
+}
+
+bool ArchiveIndex::load()
+{
+    m_valid = false;
+    m_entries.clear();
+
+    pruneOnce();
+
+    const auto [size, modified] = archiveStamp(m_archivePath);
+    if(size < 0) {
+        QFile::remove(indexPath());
+        return false;
+    }
+
+    QFile file{indexPath()};
+    if(!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream stream{&file};
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic{0};
+    quint32 version{0};
+    QString archivePath;
+    qint64 archiveSize{0};
+    qint64 archiveModified{0};
+    quint32 count{0};
+
+    stream >> magic >> version >> archivePath >> archiveSize >> archiveModified >> count;
+
+    if(stream.status() != QDataStream::Ok || magic != IndexMagic || version != IndexVersion
+       || archivePath != m_archivePath || archiveSize != size || archiveModified != modified) {
+        // Out of date, so it will be rebuilt by the next scan
+        file.remove();
+        return false;
+    }
+
+    m_entries.reserve(count);
+
+    for(quint32 i{0}; i < count; ++i) {
+        QString path;
+        qint32 index{0};
+        ArchiveIndexEntry entry;
+        stream >> path >> index >> entry.headerOffset >> entry.size >> entry.modifiedTime;
+        entry.index = index;
+        m_entries.emplace(path, entry);
+    }
+
+    if(stream.status() != QDataStream::Ok) {
+        m_entries.clear();
+        return false;
+    }
+
+    m_archiveSize     = size;
+    m_archiveModified = modified;
+    m_valid           = true;
+
+    return true;
+}
+
+bool ArchiveIndex::save()
+{
+    const auto [size, modified] = archiveStamp(m_archivePath);
+    if(size < 0) {
+        return false;
+    }
+
+    QSaveFile file{indexPath()};
+    if(!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    QDataStream stream{&file};
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    stream << IndexMagic << IndexVersion << m_archivePath << static_cast<qint64>(size)
+           << static_cast<qint64>(modified) << static_cast<quint32>(m_entries.size());
+
+    for(const auto& [path, entry] : m_entries) {
+        stream << path << static_cast<qint32>(entry.index) << entry.headerOffset << entry.size << entry.modifiedTime;
+    }
+
+    if(stream.status() != QDataStream::Ok || !file.commit()) {
+        return false;
+    }
+
+    m_archiveSize     = size;
+    m_archiveModified = modified;
+    m_valid           = true;
+
+    pruneOnce();
+
+    return true;
+}
+
+void ArchiveIndex::clear()
+{
+    m_valid = false;
+    m_entries.clear();
+}
+
+void ArchiveIndex::addEntry(const QString& path, const ArchiveIndexEntry& entry)
+{
+    m_entries.insert_or_assign(path, entry);
+}
+
+void ArchiveIndex::prune()
+{
+    const QFileInfoList indexes = QDir{indexDir()}.entryInfoList({u"*.idx"_s}, QDir::Files);
+
+    for(const QFileInfo& index : indexes) {
+        if(isStale(index.absoluteFilePath())) {
+            QFile::remove(index.absoluteFilePath());
+        }
+    }
+}
+
+QString ArchiveIndex::indexPath() const
+{
+    return indexDir() + u'/' + Utils::generateHash(m_archivePath) + u".idx"_s;
+}
+} // namespace Fooyin::LibArchive
@@ -0,0 +1,71 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include <QString>
+#include <QStringList>
+
+#include <optional>
+#include <unordered_map>
+
+namespace Fooyin::LibArchive {
+struct ArchiveIndexEntry
+{
+    // Position of the entry in the archive
+    int index{-1};
+    // Offset of the entry header, as reported by libarchive
+    int64_t headerOffset{0};
+    int64_t size{0};
+    int64_t modifiedTime{0};
+};
+
+/*!
+ * A persistent index of the regular file entries in an archive.
+ *
+ * The index is stored in the cache directory and is only used while the size and
+ * modification time of the archive match those it was built from.
+ */
+class ArchiveIndex
+{
+public:
+    explicit ArchiveIndex(QString archivePath);
+
+    [[nodiscard]] bool isValid() const;
+    [[nodiscard]] std::optional<ArchiveIndexEntry> entry(const QString& path) const;
+    [[nodiscard]] QStringList entries() const;
+
+    bool load();
+    bool save();
+
+    void clear();
+    void addEntry(const QString& path, const ArchiveIndexEntry& entry);
+
+    /** Removes indexes whose archive has been removed or has changed since it was indexed. */
+    static void prune();
+
+private:
+    [[nodiscard]] QString indexPath() const;
+
+    QString m_archivePath;
+    int64_t m_archiveSize;
+    int64_t m_archiveModified;
+    bool m_valid;
+    std::unordered_map<QString, ArchiveIndexEntry> m_entries;
+};
+} // namespace Fooyin::LibArchive
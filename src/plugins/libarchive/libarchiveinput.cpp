@@ -24,6 +24,7 @@
 #include <QFileInfo>
 #include <QLoggingCategory>
 #include <QMimeDatabase>
+#include <QTemporaryFile>
 
 #ifdef Q_OS_WIN
 #define NOMINMAX
@@ -49,6 +50,10 @@ bool isImageFile(const QString& filePath)
     return mimeType.name().startsWith("image/"_L1);
 }
 
+// Decompressed entry data held in memory before spilling to disk
+constexpr qint64 MaxMemoryCache = 8 * 1024 * 1024;
+constexpr size_t ReadChunkSize  = 64 * 1024;
+
 bool setupForReading(archive* archive, const QString& filename)
 {
     archive_read_support_filter_all(archive);
@@ -68,7 +73,11 @@ namespace Fooyin::LibArchive {
 LibArchiveIODevice::LibArchiveIODevice(ArchivePtr archive, archive_entry* entry, QObject* parent)
     : QIODevice{parent}
     , m_archive{std::move(archive)}
-    , m_entry{entry}
+    , m_size{archive_entry_size(entry)}
+    , m_readPos{0}
+    , m_cached{0}
+    , m_readBuffer(ReadChunkSize)
+    , m_cache{&m_buffer}
 {
     open(QIODevice::ReadOnly);
     m_buffer.open(QBuffer::ReadWrite);
@@ -87,36 +96,24 @@ bool LibArchiveIODevice::seek(qint64 pos)
 
     QIODevice::seek(pos);
 
-    if(pos <= m_buffer.size()) {
-        return m_buffer.seek(pos);
-    }
-
-    qint64 bufferLen = pos - m_buffer.size();
-    std::vector<char> tmpBuffer(1024);
-
-    while(bufferLen > 0) {
-        qint64 lenToRead = std::min(static_cast<qint64>(tmpBuffer.size()), bufferLen);
-
-        lenToRead = archive_read_data(m_archive.get(), tmpBuffer.data(), static_cast<size_t>(lenToRead));
-        if(lenToRead > 0) {
-            m_buffer.buffer().append(tmpBuffer.data(), static_cast<qsizetype>(lenToRead));
-            bufferLen -= lenToRead;
-            continue;
-        }
-        if(lenToRead < 0) {
-            qCWarning(LIBARCH) << "Seeking failed:" << archive_error_string(m_archive.get());
-            setErrorString(QString::fromLocal8Bit(archive_error_string(m_archive.get())));
+    if(pos > m_cached) {
+        if(!fillTo(pos)) {
+            qCWarning(LIBARCH) << "Seeking failed:" << errorString();
             close();
+            return false;
+        }
+        if(pos > m_cached) {
+            return false;
         }
-        return false;
     }
 
-    return m_buffer.seek(pos);
+    m_readPos = pos;
+    return true;
 }
 
 qint64 LibArchiveIODevice::size() const
 {
-    return archive_entry_size(m_entry);
+    return m_size;
 }
 
 archive* LibArchiveIODevice::releaseArchive()
@@ -130,22 +127,71 @@ qint64 LibArchiveIODevice::readData(char* data, qint64 maxlen)
         return -1;
     }
 
-    if(m_buffer.pos() + maxlen > m_buffer.size()) {
-        const qint64 lenToRead = m_buffer.pos() + maxlen - m_buffer.size();
-        std::vector<char> tmpBuffer(lenToRead);
+    if(m_readPos + maxlen > m_cached && !fillTo(m_readPos + maxlen)) {
+        qCWarning(LIBARCH) << "Reading failed:" << errorString();
+        return -1;
+    }
+
+    const qint64 available = std::min(maxlen, m_cached - m_readPos);
+    if(available <= 0) {
+        return 0;
+    }
+
+    if(!m_cache->seek(m_readPos)) {
+        return -1;
+    }
+
+    const qint64 read = m_cache->read(data, available);
+    if(read > 0) {
+        m_readPos += read;
+    }
 
-        const auto read = archive_read_data(m_archive.get(), tmpBuffer.data(), lenToRead);
-        if(read > 0) {
-            m_buffer.buffer().append(tmpBuffer.data(), read);
+    return read;
+}
+
+bool LibArchiveIODevice::fillTo(qint64 pos)
+{
+    while(m_cached < pos) {
+        const auto read = archive_read_data(m_archive.get(), m_readBuffer.data(), m_readBuffer.size());
+        if(read == 0) {
+            // End of entry
+            return true;
         }
-        else if(read < 0) {
-            qCWarning(LIBARCH) << "Reading failed:" << archive_error_string(m_archive.get());
+        if(read < 0) {
             setErrorString(QString::fromLocal8Bit(archive_error_string(m_archive.get())));
-            return -1;
+            return false;
+        }
+        if(!appendToCache(m_readBuffer.data(), static_cast<qint64>(read))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool LibArchiveIODevice::appendToCache(const char* data, qint64 len)
+{
+    if(!m_spillFile && m_cached + len > MaxMemoryCache) {
+        auto spillFile = std::make_unique<QTemporaryFile>();
+        if(!spillFile->open() || spillFile->write(m_buffer.data()) != m_cached) {
+            setErrorString(spillFile->errorString());
+            return false;
         }
+
+        m_buffer.close();
+        m_buffer.setData({});
+
+        m_spillFile = std::move(spillFile);
+        m_cache     = m_spillFile.get();
     }
 
-    return m_buffer.read(data, maxlen);
+    if(!m_cache->seek(m_cached) || m_cache->write(data, len) != len) {
+        setErrorString(m_cache->errorString());
+        return false;
+    }
+
+    m_cached += len;
+    return true;
 }
 
 qint64 LibArchiveIODevice::writeData(const char* /*data*/, qint64 /*len*/)
@@ -165,12 +211,29 @@ QString LibArchiveReader::type() const
 
 bool LibArchiveReader::init(const QString& file)
 {
-    m_file = file;
-    m_type = QFileInfo{file}.suffix();
+    m_file  = file;
+    m_type  = QFileInfo{file}.suffix();
+    m_index = std::make_unique<ArchiveIndex>(file);
+    m_index->load();
     return true;
 }
 
 std::unique_ptr<QIODevice> LibArchiveReader::entry(const QString& file)
+{
+    if(m_index && m_index->isValid()) {
+        const auto indexEntry = m_index->entry(file);
+        if(!indexEntry) {
+            qCDebug(LIBARCH) << "Unable to find" << file << "in" << m_file;
+            return nullptr;
+        }
+        return findEntry(file, indexEntry);
+    }
+
+    return findEntry(file, {});
+}
+
+std::unique_ptr<QIODevice> LibArchiveReader::findEntry(const QString& file,
+                                                       const std::optional<ArchiveIndexEntry>& indexEntry)
 {
     ArchivePtr archive{archive_read_new()};
 
@@ -180,18 +243,38 @@ std::unique_ptr<QIODevice> LibArchiveReader::entry(const QString& file)
 
     archive_entry* entry{nullptr};
 
-    while(archive_read_next_header(archive.get(), &entry) == ARCHIVE_OK) {
+    for(int index{0}; archive_read_next_header(archive.get(), &entry) == ARCHIVE_OK; ++index) {
         if(archive_read_has_encrypted_entries(archive.get()) == 1) {
             qCInfo(LIBARCH) << "Unable to read encrypted file" << m_file;
             return nullptr;
         }
 
+        if(indexEntry) {
+            // Headers before the indexed entry are skipped without decoding their paths
+            if(index < indexEntry->index) {
+                continue;
+            }
+            if(archive_read_header_position(archive.get()) != indexEntry->headerOffset) {
+                break;
+            }
+        }
+
         if(archive_entry_filetype(entry) == AE_IFREG) {
             const QString entryPath = QDir::fromNativeSeparators(QFile::decodeName(archive_entry_pathname(entry)));
             if(entryPath == file) {
                 return std::make_unique<LibArchiveIODevice>(std::move(archive), entry, nullptr);
             }
         }
+
+        if(indexEntry) {
+            break;
+        }
+    }
+
+    if(indexEntry) {
+        qCDebug(LIBARCH) << "Archive index out of date for" << m_file;
+        m_index->clear();
+        return findEntry(file, {});
     }
 
     qCDebug(LIBARCH) << "Unable to find" << file << "in" << m_file;
@@ -207,8 +290,9 @@ bool LibArchiveReader::readTracks(ReadEntryCallback readEntry)
     }
 
     archive_entry* entry{nullptr};
+    ArchiveIndex index{m_file};
 
-    while(archive_read_next_header(archive.get(), &entry) == ARCHIVE_OK) {
+    for(int position{0}; archive_read_next_header(archive.get(), &entry) == ARCHIVE_OK; ++position) {
         if(archive_read_has_encrypted_entries(archive.get()) == 1) {
             qCInfo(LIBARCH) << "Unable to read encrypted file" << m_file;
             return false;
@@ -216,13 +300,24 @@ bool LibArchiveReader::readTracks(ReadEntryCallback readEntry)
 
         if(archive_entry_filetype(entry) == AE_IFREG) {
             const QString entryPath = QDir::fromNativeSeparators(QFile::decodeName(archive_entry_pathname(entry)));
-            auto entryDev           = std::make_unique<LibArchiveIODevice>(std::move(archive), entry, nullptr);
+
+            index.addEntry(entryPath, {.index        = position,
+                                       .headerOffset = archive_read_header_position(archive.get()),
+                                       .size         = archive_entry_size(entry),
+                                       .modifiedTime = archive_entry_mtime(entry)});
+
+            auto entryDev = std::make_unique<LibArchiveIODevice>(std::move(archive), entry, nullptr);
 
             readEntry(entryPath, entryDev.get());
             archive.reset(entryDev->releaseArchive());
         }
     }
 
+    if(!index.save()) {
+        qCDebug(LIBARCH) << "Unable to save archive index for" << m_file;
+    }
+    m_index = std::make_unique<ArchiveIndex>(std::move(index));
+
     return true;
 }
 
@@ -233,6 +328,20 @@ QByteArray LibArchiveReader::readCover(const Track& track, Track::Cover cover)
         return {};
     }
 
+    if(m_index && m_index->isValid()) {
+        const QStringList entries = m_index->entries();
+        for(const QString& entryPath : entries) {
+            if(isImageFile(entryPath) && QFileInfo{entryPath}.path() == track.relativeArchivePath()) {
+                // Use first valid image
+                if(auto entryDev = entry(entryPath)) {
+                    return entryDev->readAll();
+                }
+                break;
+            }
+        }
+        return {};
+    }
+
     ArchivePtr archive{archive_read_new()};
 
     if(!setupForReading(archive.get(), m_file)) {
@@ -19,11 +19,14 @@
 
 #pragma once
 
+#include "libarchiveindex.h"
+
 #include <core/engine/audioinput.h>
 #include <core/engine/audioloader.h>
 
 #include <QBuffer>
 #include <QFile>
+#include <QTemporaryFile>
 
 #include <archive.h>
 
@@ -61,9 +64,19 @@ protected:
     qint64 writeData(const char* data, qint64 len) override;
 
 private:
+    bool fillTo(qint64 pos);
+    bool appendToCache(const char* data, qint64 len);
+
     ArchivePtr m_archive;
-    archive_entry* m_entry;
+    qint64 m_size;
+    qint64 m_readPos;
+    qint64 m_cached;
+    std::vector<char> m_readBuffer;
+
+    // Decompressed data is kept in memory up to a limit, then moved to a temporary file
     QBuffer m_buffer;
+    std::unique_ptr<QTemporaryFile> m_spillFile;
+    QIODevice* m_cache;
 };
 
 class LibArchiveReader : public ArchiveReader
@@ -78,8 +91,11 @@ public:
     QByteArray readCover(const Track& track, Track::Cover cover) override;
 
 private:
+    std::unique_ptr<QIODevice> findEntry(const QString& file, const std::optional<ArchiveIndexEntry>& indexEntry);
+
     QString m_file;
     std::unique_ptr<LibArchiveIODevice> m_device;
+    std::unique_ptr<ArchiveIndex> m_index;
     QString m_type;
 };
 } // namespace Fooyin::LibArchive
@@ -21,6 +21,7 @@
 
 #include "settings/wavebarsettings.h"
 #include "wavebarconstants.h"
+#include "waveformstore.h"
 
 #include <utils/settings/settingsmanager.h>
 #include <utils/stringutils.h>
@@ -303,7 +304,8 @@ void WaveBarSettingsPageWidget::reset()
 void WaveBarSettingsPageWidget::updateCacheSize()
 {
     const QFile cacheFile{cachePath()};
-    const QString cacheSize = Utils::formatFileSize(cacheFile.size());
+    const WaveformStore waveStore;
+    const QString cacheSize = Utils::formatFileSize(static_cast<uint64_t>(cacheFile.size()) + waveStore.size());
 
     m_cacheSizeLabel->setText(tr("Disk cache usage") + u": %1"_s.arg(cacheSize));
 }
@@ -26,4 +26,9 @@ QString cachePath()
 {
     return Fooyin::Utils::cachePath() + u"/wavebar.db"_s;
 }
+
+QString waveformStorePath()
+{
+    return Fooyin::Utils::cachePath() + u"/waveforms"_s;
+}
 } // namespace Fooyin::WaveBar
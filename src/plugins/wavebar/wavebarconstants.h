@@ -23,6 +23,7 @@
 
 namespace Fooyin::WaveBar {
 QString cachePath();
+QString waveformStorePath();
 
 namespace Constants::Page {
 constexpr auto WaveBarGeneral = "Fooyin.Page.WaveBar.General";
@@ -24,9 +24,12 @@
 #include "settings/wavebarsettingspage.h"
 #include "wavebarconstants.h"
 #include "wavebarwidget.h"
+#include "waveformbatchgenerator.h"
 #include "waveformbuilder.h"
+#include "waveformstore.h"
 
 #include <core/engine/enginecontroller.h>
+#include <core/library/musiclibrary.h>
 #include <core/player/playercontroller.h>
 #include <gui/guiconstants.h>
 #include <gui/trackselectioncontroller.h>
@@ -69,6 +72,7 @@ void WaveBarPlugin::initialise(const CorePluginContext& context)
 {
     m_playerController = context.playerController;
     m_engine           = context.engine;
+    m_library          = context.library;
     m_audioLoader      = context.audioLoader;
     m_settings         = context.settingsManager;
 
@@ -117,6 +121,13 @@ void WaveBarPlugin::initialise(const GuiPluginContext& context)
     removeData->setStatusTip(tr("Remove any existing waveform data for the selected tracks"));
     QObject::connect(removeData, &QAction::triggered, this, &WaveBarPlugin::removeSelection);
     utilitiesMenu->addAction(removeData);
+
+    if(auto* libraryMenu = m_actionManager->actionContainer(::Fooyin::Constants::Menus::Library)) {
+        auto* generateLibrary = new QAction(tr("Generate waveform data"), window);
+        generateLibrary->setStatusTip(tr("Generate missing waveform data for all tracks in libraries"));
+        QObject::connect(generateLibrary, &QAction::triggered, this, &WaveBarPlugin::generateLibrary);
+        libraryMenu->addAction(generateLibrary);
+    }
 }
 
 FyWidget* WaveBarPlugin::createWavebar()
@@ -177,6 +188,41 @@ void WaveBarPlugin::regenerateSelection(bool onlyMissing) const
     }
 }
 
+void WaveBarPlugin::generateLibrary() const
+{
+    const TrackList tracks = m_library->tracks();
+    if(tracks.empty()) {
+        return;
+    }
+
+    const auto total = static_cast<int>(tracks.size());
+    auto* dialog
+        = new ElapsedProgressDialog(tr("Generating waveform data…"), tr("Abort"), 0, total, Utils::getMainWindow());
+    dialog->setAttribute(Qt::WA_DeleteOnClose);
+    dialog->setMinimumDuration(500ms);
+
+    // Deleted on close of dialog
+    auto* generator = new WaveformBatchGenerator(m_audioLoader, m_dbPool,
+                                                 m_settings->value<Settings::WaveBar::NumSamples>(), dialog);
+
+    QObject::connect(generator, &WaveformBatchGenerator::progressChanged, dialog,
+                     [dialog](const WaveformBatchGenerator::Progress& progress) {
+                         dialog->setValue(progress.finished());
+                         dialog->setText(tr("Generated %1 of %2 waveforms (%3 already cached, %4 failed)\n"
+                                            "%5 tracks/s, %6 MB/s")
+                                             .arg(progress.processed)
+                                             .arg(progress.total - progress.skipped)
+                                             .arg(progress.skipped)
+                                             .arg(progress.failed)
+                                             .arg(progress.tracksPerSecond(), 0, 'f', 1)
+                                             .arg(progress.megabytesPerSecond(), 0, 'f', 1));
+                     });
+    QObject::connect(generator, &WaveformBatchGenerator::finished, dialog, &QDialog::close);
+    QObject::connect(dialog, &ElapsedProgressDialog::cancelled, generator, &WaveformBatchGenerator::stop);
+
+    generator->start(tracks);
+}
+
 void WaveBarPlugin::removeTrack(const Track& track)
 {
     removeTracks({track});
@@ -199,7 +245,8 @@ void WaveBarPlugin::removeTracks(const TrackList& tracks)
         waveDb.initialise(DbConnectionProvider{m_dbPool});
         waveDb.initialiseDatabase();
 
-        if(!waveDb.removeFromCache(keys)) {
+        const WaveformStore waveStore;
+        if(!waveStore.remove(keys) || !waveDb.removeFromCache(keys)) {
             qCWarning(WAVEBAR) << "Unable to remove waveform data";
         }
     });
@@ -216,7 +263,8 @@ void WaveBarPlugin::clearCache() const
     WaveBarDatabase waveDb;
     waveDb.initialise(DbConnectionProvider{m_dbPool});
 
-    if(!waveDb.clearCache()) {
+    const WaveformStore waveStore;
+    if(!waveStore.clear() || !waveDb.clearCache()) {
         qCWarning(WAVEBAR) << "Unable to clear waveform cache";
     }
 }
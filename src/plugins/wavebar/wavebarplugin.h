@@ -53,6 +53,7 @@ public:
 private:
     FyWidget* createWavebar();
     void regenerateSelection(bool onlyMissing = false) const;
+    void generateLibrary() const;
     void removeTrack(const Track& track);
     void removeTracks(const TrackList& tracks);
     void removeSelection();
@@ -61,6 +62,7 @@ private:
     ActionManager* m_actionManager;
     PlayerController* m_playerController;
     EngineController* m_engine;
+    MusicLibrary* m_library;
     std::shared_ptr<AudioLoader> m_audioLoader;
     TrackSelectionController* m_trackSelection;
     WidgetProvider* m_widgetProvider;
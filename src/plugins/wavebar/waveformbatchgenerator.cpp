@@ -0,0 +1,229 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "waveformbatchgenerator.h"
+
+#include "wavebardatabase.h"
+#include "waveformstore.h"
+
+#include <utils/async.h>
+#include <utils/database/dbconnectionhandler.h>
+
+#include <QFuture>
+
+#include <algorithm>
+
+namespace {
+Fooyin::TrackList missingTracks(const Fooyin::DbConnectionPoolPtr& dbPool, const Fooyin::TrackList& tracks)
+{
+    const Fooyin::DbConnectionHandler dbHandler{dbPool};
+    Fooyin::WaveBar::WaveBarDatabase waveDb;
+    waveDb.initialise(Fooyin::DbConnectionProvider{dbPool});
+    waveDb.initialiseDatabase();
+
+    const Fooyin::WaveBar::WaveformStore waveStore;
+
+    Fooyin::TrackList missing;
+    for(const Fooyin::Track& track : tracks) {
+        const QString key = Fooyin::WaveBar::WaveBarDatabase::cacheKey(track);
+        if(!waveStore.exists(key) && !waveDb.existsInCache(key)) {
+            missing.push_back(track);
+        }
+    }
+
+    return missing;
+}
+} // namespace
+
+namespace Fooyin::WaveBar {
+int WaveformBatchGenerator::Progress::finished() const
+{
+    return processed + skipped + failed;
+}
+
+double WaveformBatchGenerator::Progress::tracksPerSecond() const
+{
+    if(elapsed.count() <= 0) {
+        return 0.0;
+    }
+    return static_cast<double>(processed) / std::chrono::duration<double>(elapsed).count();
+}
+
+double WaveformBatchGenerator::Progress::megabytesPerSecond() const
+{
+    if(elapsed.count() <= 0) {
+        return 0.0;
+    }
+    return static_cast<double>(bytes) / (1024.0 * 1024.0) / std::chrono::duration<double>(elapsed).count();
+}
+
+WaveformBatchGenerator::WaveformBatchGenerator(std::shared_ptr<AudioLoader> audioLoader, DbConnectionPoolPtr dbPool,
+                                               int samplesPerChannel, QObject* parent)
+    : QObject{parent}
+    , m_audioLoader{std::move(audioLoader)}
+    , m_dbPool{std::move(dbPool)}
+    , m_samplesPerChannel{samplesPerChannel}
+    , m_running{false}
+    , m_inFlight{0}
+{ }
+
+WaveformBatchGenerator::~WaveformBatchGenerator()
+{
+    shutdown();
+}
+
+void WaveformBatchGenerator::start(const TrackList& tracks)
+{
+    if(m_running) {
+        return;
+    }
+
+    m_running        = true;
+    m_progress       = {};
+    m_progress.total = static_cast<int>(tracks.size());
+    m_timer.reset();
+
+    Utils::asyncExec([dbPool = m_dbPool, tracks]() { return missingTracks(dbPool, tracks); })
+        .then(this, [this](const TrackList& missing) {
+            if(!m_running) {
+                return;
+            }
+
+            m_progress.skipped = m_progress.total - static_cast<int>(missing.size());
+            m_pending.assign(missing.cbegin(), missing.cend());
+
+            emit progressChanged(m_progress);
+
+            startGenerators();
+        });
+}
+
+void WaveformBatchGenerator::stop()
+{
+    if(!m_running) {
+        return;
+    }
+
+    // Anything not yet stored is picked up again on the next run
+    m_pending.clear();
+    shutdown();
+
+    emit finished();
+}
+
+bool WaveformBatchGenerator::isRunning() const
+{
+    return m_running;
+}
+
+WaveformBatchGenerator::Progress WaveformBatchGenerator::progress() const
+{
+    return m_progress;
+}
+
+void WaveformBatchGenerator::startGenerators()
+{
+    const auto count = std::min<size_t>(std::max(1, QThread::idealThreadCount()), m_pending.size());
+
+    for(size_t i{0}; i < count; ++i) {
+        auto& worker = m_generators.emplace_back(std::make_unique<GeneratorThread>(m_audioLoader, m_dbPool));
+        auto* generator = &worker->generator;
+
+        generator->moveToThread(&worker->thread);
+
+        QObject::connect(generator, &WaveformGenerator::waveformGenerated, this,
+                         [this, generator](const Track& track) { handleTrackFinished(generator, track, true); });
+        QObject::connect(generator, &WaveformGenerator::generationFailed, this,
+                         [this, generator](const Track& track) { handleTrackFinished(generator, track, false); });
+
+        worker->thread.start();
+        QMetaObject::invokeMethod(generator, &Worker::initialiseThread);
+    }
+
+    for(const auto& worker : m_generators) {
+        dispatch(&worker->generator);
+    }
+
+    if(m_inFlight == 0) {
+        shutdown();
+        emit finished();
+    }
+}
+
+void WaveformBatchGenerator::dispatch(WaveformGenerator* generator)
+{
+    if(!m_running || m_pending.empty()) {
+        return;
+    }
+
+    const Track track = m_pending.front();
+    m_pending.pop_front();
+    ++m_inFlight;
+
+    QMetaObject::invokeMethod(generator, [generator, track, samples = m_samplesPerChannel]() {
+        generator->generate(track, samples, false);
+    });
+}
+
+void WaveformBatchGenerator::handleTrackFinished(WaveformGenerator* generator, const Track& track, bool success)
+{
+    // Results can still be queued from generators of a batch which has since been stopped
+    if(!m_running || std::ranges::none_of(m_generators, [generator](const auto& worker) {
+           return &worker->generator == generator;
+       })) {
+        return;
+    }
+
+    --m_inFlight;
+
+    if(success) {
+        ++m_progress.processed;
+        m_progress.bytes += track.fileSize();
+    }
+    else {
+        ++m_progress.failed;
+    }
+    m_progress.elapsed = m_timer.elapsed();
+
+    emit trackFinished(track);
+    emit progressChanged(m_progress);
+
+    dispatch(generator);
+
+    if(m_inFlight == 0 && m_pending.empty()) {
+        shutdown();
+        emit finished();
+    }
+}
+
+void WaveformBatchGenerator::shutdown()
+{
+    m_running = false;
+
+    for(const auto& worker : m_generators) {
+        worker->generator.closeThread();
+        worker->thread.quit();
+    }
+    for(const auto& worker : m_generators) {
+        worker->thread.wait();
+    }
+
+    m_generators.clear();
+    m_inFlight = 0;
+}
+} // namespace Fooyin::WaveBar
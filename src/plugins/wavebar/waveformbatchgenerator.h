@@ -0,0 +1,105 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include "waveformgenerator.h"
+
+#include <core/track.h>
+#include <utils/database/dbconnectionpool.h>
+#include <utils/timer.h>
+
+#include <QObject>
+#include <QThread>
+
+#include <deque>
+
+namespace Fooyin {
+class AudioLoader;
+
+namespace WaveBar {
+/*!
+ * Generates waveforms for a list of tracks using a bounded pool of generator threads.
+ *
+ * Tracks which already have cached waveform data are skipped, so a batch which is stopped
+ * part way through can be resumed by starting it again with the same tracks.
+ */
+class WaveformBatchGenerator : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Progress
+    {
+        int total{0};
+        int processed{0};
+        int skipped{0};
+        int failed{0};
+        uint64_t bytes{0};
+        std::chrono::milliseconds elapsed{0};
+
+        [[nodiscard]] int finished() const;
+        [[nodiscard]] double tracksPerSecond() const;
+        [[nodiscard]] double megabytesPerSecond() const;
+    };
+
+    WaveformBatchGenerator(std::shared_ptr<AudioLoader> audioLoader, DbConnectionPoolPtr dbPool,
+                           int samplesPerChannel, QObject* parent = nullptr);
+    ~WaveformBatchGenerator() override;
+
+    void start(const TrackList& tracks);
+    void stop();
+
+    [[nodiscard]] bool isRunning() const;
+    [[nodiscard]] Progress progress() const;
+
+signals:
+    void progressChanged(const Fooyin::WaveBar::WaveformBatchGenerator::Progress& progress);
+    void trackFinished(const Fooyin::Track& track);
+    void finished();
+
+private:
+    struct GeneratorThread
+    {
+        GeneratorThread(std::shared_ptr<AudioLoader> audioLoader, DbConnectionPoolPtr dbPool)
+            : generator{std::move(audioLoader), std::move(dbPool)}
+        { }
+
+        QThread thread;
+        WaveformGenerator generator;
+    };
+
+    void startGenerators();
+    void dispatch(WaveformGenerator* generator);
+    void handleTrackFinished(WaveformGenerator* generator, const Track& track, bool success);
+    void shutdown();
+
+    std::shared_ptr<AudioLoader> m_audioLoader;
+    DbConnectionPoolPtr m_dbPool;
+    int m_samplesPerChannel;
+
+    bool m_running;
+    int m_inFlight;
+    std::deque<Track> m_pending;
+    std::vector<std::unique_ptr<GeneratorThread>> m_generators;
+
+    Progress m_progress;
+    Timer m_timer;
+};
+} // namespace WaveBar
+} // namespace Fooyin
@@ -21,6 +21,8 @@
 
 #include <core/engine/audioformat.h>
 
+#include <cstdint>
+#include <limits>
 #include <tuple>
 #include <vector>
 
@@ -85,4 +87,10 @@ struct WaveformData
         return static_cast<int>(channelData.front().max.size());
     }
 };
+
+/** Converts a sample from the 16-bit cache format back to a float. */
+inline float convertSampleToFloat(const int16_t inSample)
+{
+    return static_cast<float>(inSample) / static_cast<float>(std::numeric_limits<int16_t>::max());
+}
 } // namespace Fooyin::WaveBar
@@ -33,11 +33,6 @@
 Q_LOGGING_CATEGORY(WAVEBAR, "fy.wavebar")
 
 namespace {
-float convertSampleToFloat(const int16_t inSample)
-{
-    return static_cast<float>(inSample) / static_cast<float>(std::numeric_limits<int16_t>::max());
-}
-
 int16_t convertSampleToInt16(const float inSample)
 {
     const int prevRoundingMode = std::fegetround();
@@ -71,7 +66,7 @@ Fooyin::WaveBar::WaveformData<OutputType> convertCache(const Fooyin::WaveBar::Wa
 
         for(const auto& sample : inChannelData.max) {
             if constexpr(std::is_same_v<InputType, int16_t>) {
-                outChannelData.max.emplace_back(convertSampleToFloat(sample));
+                outChannelData.max.emplace_back(Fooyin::WaveBar::convertSampleToFloat(sample));
             }
             else {
                 outChannelData.max.emplace_back(convertSampleToInt16(sample));
@@ -79,7 +74,7 @@ Fooyin::WaveBar::WaveformData<OutputType> convertCache(const Fooyin::WaveBar::Wa
         }
         for(const auto& sample : inChannelData.min) {
             if constexpr(std::is_same_v<InputType, int16_t>) {
-                outChannelData.min.emplace_back(convertSampleToFloat(sample));
+                outChannelData.min.emplace_back(Fooyin::WaveBar::convertSampleToFloat(sample));
             }
             else {
                 outChannelData.min.emplace_back(convertSampleToInt16(sample));
@@ -87,7 +82,7 @@ Fooyin::WaveBar::WaveformData<OutputType> convertCache(const Fooyin::WaveBar::Wa
         }
         for(const auto& sample : inChannelData.rms) {
             if constexpr(std::is_same_v<InputType, int16_t>) {
-                outChannelData.rms.emplace_back(convertSampleToFloat(sample));
+                outChannelData.rms.emplace_back(Fooyin::WaveBar::convertSampleToFloat(sample));
             }
             else {
                 outChannelData.rms.emplace_back(convertSampleToInt16(sample));
@@ -127,18 +122,16 @@ void WaveformGenerator::generate(const Track& track, int samplesPerChannel, bool
 
     const QString trackKey = setup(track, samplesPerChannel);
     if(trackKey.isEmpty()) {
+        emit generationFailed(track);
         return;
     }
 
     setState(Running);
 
-    if(!update && m_waveDb.existsInCache(trackKey)) {
+    if(!update && (m_waveStore.exists(trackKey) || m_waveDb.existsInCache(trackKey))) {
         if(render) {
-            WaveformData<int16_t> data;
-            if(m_waveDb.loadCachedData(trackKey, data)) {
-                const auto floatData = convertCache<float>(data);
-                m_data.channelData   = floatData.channelData;
-                m_data.complete      = true;
+            if(loadCached(trackKey)) {
+                m_data.complete = true;
 
                 setState(Idle);
                 emit waveformGenerated(track, m_data);
@@ -204,7 +197,10 @@ void WaveformGenerator::generate(const Track& track, int samplesPerChannel, bool
 
     m_decoder->stop();
 
-    if(!m_waveDb.storeInCache(trackKey, convertCache<int16_t>(m_data))) {
+    if(m_waveStore.store(trackKey, convertCache<int16_t>(m_data))) {
+        m_waveDb.removeFromCache(trackKey);
+    }
+    else {
         qCWarning(WAVEBAR) << "Unable to store waveform for track:" << m_track.filepath();
     }
 
@@ -265,6 +261,30 @@ QString WaveformGenerator::setup(const Track& track, int samplesPerChannel)
     return WaveBarDatabase::cacheKey(m_track, m_data.channels);
 }
 
+bool WaveformGenerator::loadCached(const QString& key)
+{
+    if(m_waveStore.load(key, m_data)) {
+        return true;
+    }
+
+    // Waveforms cached by older versions live in the database; move them to the store on first use
+    WaveformData<int16_t> data;
+    if(!m_waveDb.loadCachedData(key, data)) {
+        return false;
+    }
+
+    data.duration          = m_data.duration;
+    data.samplesPerChannel = m_data.samplesPerChannel;
+
+    if(m_waveStore.store(key, data)) {
+        m_waveDb.removeFromCache(key);
+    }
+
+    m_data.channelData = convertCache<float>(data).channelData;
+
+    return true;
+}
+
 void WaveformGenerator::processBuffer(const AudioBuffer& buffer)
 {
     const int bps         = buffer.format().bytesPerSample();
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "wavebardatabase.h"
+#include "waveformstore.h"
 
 #include <core/engine/audioinput.h>
 #include <core/track.h>
@@ -47,6 +48,7 @@ public:
 signals:
     void generatingWaveform();
     void waveformGenerated(const Fooyin::Track& track, const Fooyin::WaveBar::WaveformData<float>& data);
+    void generationFailed(const Fooyin::Track& track);
 
 public slots:
     void initialiseThread() override;
@@ -54,6 +56,7 @@ public slots:
 
 private:
     QString setup(const Track& track, int samplesPerChannel);
+    bool loadCached(const QString& key);
     void processBuffer(const AudioBuffer& buffer);
 
     std::shared_ptr<AudioLoader> m_audioLoader;
@@ -62,6 +65,7 @@ private:
     DbConnectionPoolPtr m_dbPool;
     std::unique_ptr<DbConnectionHandler> m_dbHandler;
     WaveBarDatabase m_waveDb;
+    WaveformStore m_waveStore;
 
     Track m_track;
     AudioFormat m_format;
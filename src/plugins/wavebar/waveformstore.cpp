@@ -0,0 +1,226 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "waveformstore.h"
+
+#include "wavebarconstants.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QLoggingCategory>
+#include <QSaveFile>
+
+#include <array>
+#include <cstring>
+
+Q_LOGGING_CATEGORY(WAVE_STORE, "fy.wavestore")
+
+using namespace Qt::StringLiterals;
+
+namespace {
+constexpr std::array<char, 4> FileMagic = {'F', 'Y', 'W', 'F'};
+constexpr uint16_t FileVersion          = 1;
+constexpr uint16_t ByteOrderMark        = 0xFEFF;
+constexpr int SeriesPerChannel          = 3;
+
+// Samples are stored in host byte order, which the byte order mark is checked against on load
+struct FileHeader
+{
+    std::array<char, 4> magic{FileMagic};
+    uint16_t version{FileVersion};
+    uint16_t byteOrder{ByteOrderMark};
+    uint32_t channels{0};
+    uint32_t sampleCount{0};
+    uint32_t samplesPerChannel{0};
+    uint32_t reserved{0};
+    uint64_t duration{0};
+};
+static_assert(sizeof(FileHeader) == 32);
+static_assert(std::is_trivially_copyable_v<FileHeader>);
+
+qint64 dataSize(const FileHeader& header)
+{
+    return static_cast<qint64>(header.channels) * SeriesPerChannel * header.sampleCount
+         * static_cast<qint64>(sizeof(int16_t));
+}
+
+void readSeries(const uchar* data, uint32_t count, std::vector<float>& series)
+{
+    series.resize(count);
+
+    for(uint32_t i{0}; i < count; ++i) {
+        int16_t sample;
+        std::memcpy(&sample, data + (i * sizeof(int16_t)), sizeof(int16_t));
+        series[i] = Fooyin::WaveBar::convertSampleToFloat(sample);
+    }
+}
+
+bool writeSeries(QSaveFile& file, const std::vector<int16_t>& series)
+{
+    const auto size = static_cast<qint64>(series.size() * sizeof(int16_t));
+    return file.write(reinterpret_cast<const char*>(series.data()), size) == size;
+}
+} // namespace
+
+namespace Fooyin::WaveBar {
+WaveformStore::WaveformStore(QString path)
+    : m_path{path.isEmpty() ? waveformStorePath() : std::move(path)}
+{ }
+
+QString WaveformStore::path() const
+{
+    return m_path;
+}
+
+uint64_t WaveformStore::size() const
+{
+    uint64_t total{0};
+
+    QDirIterator it{m_path, {u"*.fywave"_s}, QDir::Files, QDirIterator::Subdirectories};
+    while(it.hasNext()) {
+        it.next();
+        total += static_cast<uint64_t>(it.fileInfo().size());
+    }
+
+    return total;
+}
+
+bool WaveformStore::exists(const QString& key) const
+{
+    return QFile::exists(filepath(key));
+}
+
+bool WaveformStore::load(const QString& key, WaveformData<float>& data) const
+{
+    QFile file{filepath(key)};
+    if(!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const qint64 fileSize = file.size();
+    if(fileSize < static_cast<qint64>(sizeof(FileHeader))) {
+        return false;
+    }
+
+    uchar* mapped = file.map(0, fileSize);
+    if(!mapped) {
+        qCDebug(WAVE_STORE) << "Unable to map waveform file" << file.fileName() << file.errorString();
+        return false;
+    }
+
+    FileHeader header;
+    std::memcpy(&header, mapped, sizeof(FileHeader));
+
+    if(header.magic != FileMagic || header.version != FileVersion || header.byteOrder != ByteOrderMark
+       || fileSize != static_cast<qint64>(sizeof(FileHeader)) + dataSize(header)) {
+        qCInfo(WAVE_STORE) << "Ignoring invalid waveform file" << file.fileName();
+        file.unmap(mapped);
+        return false;
+    }
+
+    const auto seriesBytes = static_cast<size_t>(header.sampleCount) * sizeof(int16_t);
+    const uchar* series    = mapped + sizeof(FileHeader);
+
+    data.channelData.resize(header.channels);
+    for(auto& channel : data.channelData) {
+        readSeries(series, header.sampleCount, channel.max);
+        series += seriesBytes;
+        readSeries(series, header.sampleCount, channel.min);
+        series += seriesBytes;
+        readSeries(series, header.sampleCount, channel.rms);
+        series += seriesBytes;
+    }
+
+    file.unmap(mapped);
+
+    return true;
+}
+
+bool WaveformStore::store(const QString& key, const WaveformData<int16_t>& data) const
+{
+    FileHeader header;
+    header.channels          = static_cast<uint32_t>(data.channelData.size());
+    header.sampleCount       = static_cast<uint32_t>(data.sampleCount());
+    header.samplesPerChannel = static_cast<uint32_t>(data.samplesPerChannel);
+    header.duration          = data.duration;
+
+    for(const auto& channel : data.channelData) {
+        if(channel.max.size() != header.sampleCount || channel.min.size() != header.sampleCount
+           || channel.rms.size() != header.sampleCount) {
+            qCWarning(WAVE_STORE) << "Unable to store waveform with mismatched channel sizes";
+            return false;
+        }
+    }
+
+    const QString path = filepath(key);
+    if(!QDir{}.mkpath(QFileInfo{path}.absolutePath())) {
+        return false;
+    }
+
+    // Written to a temporary file and renamed, so readers never see a partial waveform
+    QSaveFile file{path};
+    if(!file.open(QIODevice::WriteOnly)) {
+        qCWarning(WAVE_STORE) << "Unable to open waveform file" << path << file.errorString();
+        return false;
+    }
+
+    constexpr auto headerSize = static_cast<qint64>(sizeof(FileHeader));
+    if(file.write(reinterpret_cast<const char*>(&header), headerSize) != headerSize) {
+        file.cancelWriting();
+        return false;
+    }
+
+    for(const auto& channel : data.channelData) {
+        if(!writeSeries(file, channel.max) || !writeSeries(file, channel.min) || !writeSeries(file, channel.rms)) {
+            file.cancelWriting();
+            return false;
+        }
+    }
+
+    return file.commit();
+}
+
+bool WaveformStore::remove(const QString& key) const
+{
+    const QString path = filepath(key);
+    return !QFile::exists(path) || QFile::remove(path);
+}
+
+bool WaveformStore::remove(const QStringList& keys) const
+{
+    bool success{true};
+    for(const QString& key : keys) {
+        success &= remove(key);
+    }
+    return success;
+}
+
+bool WaveformStore::clear() const
+{
+    QDir dir{m_path};
+    return !dir.exists() || dir.removeRecursively();
+}
+
+QString WaveformStore::filepath(const QString& key) const
+{
+    // Shard by the first characters of the key to keep directories small
+    return m_path + u'/' + key.left(2) + u'/' + key + u".fywave"_s;
+}
+} // namespace Fooyin::WaveBar
@@ -0,0 +1,54 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include "waveformdata.h"
+
+#include <QString>
+#include <QStringList>
+
+namespace Fooyin::WaveBar {
+/*!
+ * File-backed waveform cache.
+ *
+ * Each waveform is stored as a fixed-layout binary file: a small header followed by the
+ * max, min and rms series of each channel as raw int16 samples. Files are memory-mapped
+ * on load and read straight into the output without any intermediate deserialisation.
+ */
+class WaveformStore
+{
+public:
+    explicit WaveformStore(QString path = {});
+
+    [[nodiscard]] QString path() const;
+    [[nodiscard]] uint64_t size() const;
+
+    [[nodiscard]] bool exists(const QString& key) const;
+    [[nodiscard]] bool load(const QString& key, WaveformData<float>& data) const;
+    [[nodiscard]] bool store(const QString& key, const WaveformData<int16_t>& data) const;
+    bool remove(const QString& key) const;
+    bool remove(const QStringList& keys) const;
+    bool clear() const;
+
+private:
+    [[nodiscard]] QString filepath(const QString& key) const;
+
+    QString m_path;
+};
+} // namespace Fooyin::WaveBar
@@ -23,7 +23,121 @@
 #include <QRandomGenerator>
 #include <QUuid>
 
+#include <algorithm>
+#include <cstring>
+
+namespace {
+// Constants from wyhash (public domain)
+constexpr uint64_t Secret0 = 0xa0761d6478bd642fULL;
+constexpr uint64_t Secret1 = 0xe7037ed1a0b428dbULL;
+constexpr uint64_t Secret2 = 0x8ebc6af09c88c6e3ULL;
+constexpr uint64_t Secret3 = 0x589965cc75374cc3ULL;
+
+// Folded 64x64->128 bit multiply
+uint64_t mix(uint64_t a, uint64_t b)
+{
+#if defined(__SIZEOF_INT128__)
+    const auto product = static_cast<unsigned __int128>(a) * b;
+    return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#else
+    const uint64_t aLow  = a & 0xFFFFFFFF;
+    const uint64_t aHigh = a >> 32;
+    const uint64_t bLow  = b & 0xFFFFFFFF;
+    const uint64_t bHigh = b >> 32;
+
+    const uint64_t lowLow   = aLow * bLow;
+    const uint64_t lowHigh  = aLow * bHigh;
+    const uint64_t highLow  = aHigh * bLow;
+    const uint64_t highHigh = aHigh * bHigh;
+
+    const uint64_t cross = (lowLow >> 32) + (lowHigh & 0xFFFFFFFF) + highLow;
+    const uint64_t low   = (cross << 32) | (lowLow & 0xFFFFFFFF);
+    const uint64_t high  = highHigh + (lowHigh >> 32) + (cross >> 32);
+    return low ^ high;
+#endif
+}
+
+uint64_t read64(const char* data)
+{
+    uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+uint64_t readTail(const char* data, size_t size)
+{
+    uint64_t value{0};
+    if(size > 0) {
+        std::memcpy(&value, data, size);
+    }
+    return value;
+}
+} // namespace
+
 namespace Fooyin::Utils {
+KeyHasher::KeyHasher()
+    : m_low{Secret0}
+    , m_high{Secret2}
+{ }
+
+void KeyHasher::addData(QStringView data)
+{
+    addBytes(reinterpret_cast<const char*>(data.utf16()), static_cast<size_t>(data.size()) * sizeof(char16_t));
+}
+
+void KeyHasher::addData(QByteArrayView data)
+{
+    addBytes(data.data(), static_cast<size_t>(data.size()));
+}
+
+void KeyHasher::addData(const QUuid& id)
+{
+    const uint64_t first = (static_cast<uint64_t>(id.data1) << 32) | (static_cast<uint64_t>(id.data2) << 16) | id.data3;
+    uint64_t second{0};
+    std::memcpy(&second, id.data4, sizeof(second));
+
+    m_low  = mix(m_low ^ first ^ Secret1, second ^ Secret3);
+    m_high = mix(m_high ^ second ^ Secret3, first ^ Secret0);
+}
+
+void KeyHasher::addData(uint64_t value)
+{
+    m_low  = mix(m_low ^ value ^ Secret1, Secret2);
+    m_high = mix(m_high ^ value ^ Secret3, Secret0);
+}
+
+Md5Hash KeyHasher::result() const
+{
+    const uint64_t low  = mix(m_low ^ Secret0, m_high ^ Secret1);
+    const uint64_t high = mix(m_high ^ Secret2, m_low ^ Secret3);
+
+    Md5Hash key(16, Qt::Uninitialized);
+    std::memcpy(key.data(), &low, sizeof(low));
+    std::memcpy(key.data() + sizeof(low), &high, sizeof(high));
+    return key;
+}
+
+void KeyHasher::addBytes(const char* data, size_t size)
+{
+    size_t remaining = size;
+
+    while(remaining >= 16) {
+        const uint64_t a = read64(data);
+        const uint64_t b = read64(data + 8);
+        m_low            = mix(m_low ^ a ^ Secret1, b ^ Secret2);
+        m_high           = mix(m_high ^ b ^ Secret3, a ^ Secret0);
+        data += 16;
+        remaining -= 16;
+    }
+
+    const uint64_t a = readTail(data, std::min<size_t>(remaining, 8));
+    const uint64_t b = remaining > 8 ? readTail(data + 8, remaining - 8) : 0;
+
+    // Mixing in the length delimits consecutive values
+    m_low  = mix(m_low ^ a ^ Secret1, b ^ Secret2 ^ size);
+    m_high = mix(m_high ^ b ^ Secret3, a ^ Secret0 ^ size);
+}
+
 QString generateUniqueHash()
 {
     return QUuid::createUuid().toString(QUuid::Id128);
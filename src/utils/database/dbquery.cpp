@@ -104,6 +104,11 @@ void DbQuery::bindValue(const QString& placeholder, const QVariant& value)
     m_query.bindValue(placeholder, value);
 }
 
+void DbQuery::bindValue(int pos, const QVariant& value)
+{
+    m_query.bindValue(pos, value);
+}
+
 QString DbQuery::executedQuery() const
 {
     return m_query.executedQuery();
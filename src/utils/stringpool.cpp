@@ -0,0 +1,146 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <utils/stringpool.h>
+
+#include <QSet>
+
+#include <array>
+#include <mutex>
+
+constexpr size_t ShardCount = 16;
+
+namespace Fooyin {
+struct StringPoolShard
+{
+    mutable std::mutex mutex;
+    QSet<QString> strings;
+    QSet<QStringList> lists;
+};
+
+class StringPoolPrivate
+{
+public:
+    StringPoolShard& shard(size_t hash)
+    {
+        return m_shards.at(hash % ShardCount);
+    }
+
+    std::array<StringPoolShard, ShardCount> m_shards;
+};
+
+StringPool::StringPool()
+    : p{std::make_unique<StringPoolPrivate>()}
+{ }
+
+StringPool::~StringPool() = default;
+
+StringPool& StringPool::global()
+{
+    static StringPool pool;
+    return pool;
+}
+
+QString StringPool::intern(const QString& str)
+{
+    if(str.isEmpty()) {
+        return {};
+    }
+
+    auto& shard = p->shard(qHash(str));
+    const std::scoped_lock lock{shard.mutex};
+
+    const auto it = shard.strings.constFind(str);
+    if(it != shard.strings.cend()) {
+        return *it;
+    }
+
+    // Don't keep a copy of a larger buffer (e.g. a substring from a parsed tag) alive
+    QString value{str};
+    value.squeeze();
+
+    return *shard.strings.insert(value);
+}
+
+QStringList StringPool::intern(const QStringList& list)
+{
+    if(list.isEmpty()) {
+        return {};
+    }
+
+    auto& shard = p->shard(qHash(list));
+
+    {
+        const std::scoped_lock lock{shard.mutex};
+
+        const auto it = shard.lists.constFind(list);
+        if(it != shard.lists.cend()) {
+            return *it;
+        }
+    }
+
+    QStringList value;
+    value.reserve(list.size());
+    for(const QString& str : list) {
+        value.append(intern(str));
+    }
+
+    const std::scoped_lock lock{shard.mutex};
+    return *shard.lists.insert(value);
+}
+
+size_t StringPool::size() const
+{
+    size_t total{0};
+
+    for(const auto& shard : p->m_shards) {
+        const std::scoped_lock lock{shard.mutex};
+        total += shard.strings.size() + shard.lists.size();
+    }
+
+    return total;
+}
+
+size_t StringPool::purge()
+{
+    size_t removed{0};
+
+    // Lists hold references to their strings, so release them first
+    for(auto& shard : p->m_shards) {
+        const std::scoped_lock lock{shard.mutex};
+        removed += shard.lists.removeIf([](const QStringList& list) { return list.isDetached(); });
+    }
+
+    for(auto& shard : p->m_shards) {
+        const std::scoped_lock lock{shard.mutex};
+        removed += shard.strings.removeIf([](const QString& str) { return str.isDetached(); });
+    }
+
+    return removed;
+}
+
+void StringPool::clear()
+{
+    for(auto& shard : p->m_shards) {
+        const std::scoped_lock lock{shard.mutex};
+        shard.lists.clear();
+        shard.strings.clear();
+    }
+}
+} // namespace Fooyin
@@ -0,0 +1,148 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "benchutils.h"
+#include "core/engine/audiokernels.h"
+
+#include <utils/fymath.h>
+
+#include <algorithm>
+#include <cfenv>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <random>
+#include <vector>
+
+// Compares the sample kernels for each supported instruction set against the previous per-sample implementations
+
+using namespace Fooyin::Audio::Kernels;
+
+namespace {
+constexpr size_t SampleCount = 1 << 20;
+constexpr int Iterations     = 200;
+
+// Per-sample implementations the kernels replaced
+
+template <typename T>
+void legacyScale(std::byte* data, size_t bytes, double volume)
+{
+    constexpr auto bps = sizeof(T);
+
+    for(size_t i{0}; i < bytes; i += bps) {
+        T sample;
+        std::memcpy(&sample, data + i, bps);
+        sample *= volume;
+        std::memcpy(data + i, &sample, bps);
+    }
+}
+
+void legacyConvertF32ToS16(const float* input, int16_t* output, size_t count)
+{
+    for(size_t i{0}; i < count; ++i) {
+        const int32_t prevRoundingMode = std::fegetround();
+        std::fesetround(FE_TONEAREST);
+
+        int32_t intSample = Fooyin::Math::fltToInt(input[i] * static_cast<float>(0x8000));
+        intSample         = std::clamp(intSample, static_cast<int32_t>(std::numeric_limits<int16_t>::min()),
+                                       static_cast<int32_t>(std::numeric_limits<int16_t>::max()));
+
+        std::fesetround(prevRoundingMode);
+
+        output[i] = static_cast<int16_t>(intSample);
+    }
+}
+
+void legacyConvertS16ToF32(const int16_t* input, float* output, size_t count)
+{
+    for(size_t i{0}; i < count; ++i) {
+        int16_t sample;
+        std::memcpy(&sample, input + i, sizeof(int16_t));
+        const float outSample = static_cast<float>(sample) * (1.0F / static_cast<float>(0x8000));
+        std::memcpy(output + i, &outSample, sizeof(float));
+    }
+}
+
+const char* isaName(Isa isa)
+{
+    switch(isa) {
+        case(Isa::Scalar):
+            return "scalar";
+        case(Isa::SSE2):
+            return "sse2";
+        case(Isa::AVX2):
+            return "avx2";
+    }
+    return "unknown";
+}
+
+void report(const char* name, const char* variant, const std::function<void()>& func)
+{
+    const double seconds = Fooyin::Testing::timeIterations(Iterations, func);
+
+    std::printf("%-18s %-8s %8.3f ns/sample\n", name, variant, seconds * 1e9 / static_cast<double>(SampleCount));
+}
+} // namespace
+
+int main()
+{
+    std::mt19937 rng{42};
+    std::uniform_real_distribution<float> floatDist{-1.0F, 1.0F};
+    std::uniform_int_distribution<int> s16Dist{std::numeric_limits<int16_t>::min(),
+                                               std::numeric_limits<int16_t>::max()};
+
+    std::vector<float> floats(SampleCount);
+    std::ranges::generate(floats, [&]() { return floatDist(rng); });
+    std::vector<int16_t> s16(SampleCount);
+    std::ranges::generate(s16, [&]() { return static_cast<int16_t>(s16Dist(rng)); });
+
+    std::vector<float> floatOut(SampleCount);
+    std::vector<int16_t> s16Out(SampleCount);
+
+    // Alternate between gains above and below 1 so repeated scaling doesn't saturate or decay to zero
+    bool flip{false};
+    auto nextGain = [&flip]() {
+        flip = !flip;
+        return flip ? 0.5 : 2.0;
+    };
+
+    report("scale f32", "legacy", [&]() {
+        legacyScale<float>(reinterpret_cast<std::byte*>(floats.data()), floats.size() * sizeof(float), nextGain());
+    });
+    report("scale s16", "legacy", [&]() {
+        legacyScale<int16_t>(reinterpret_cast<std::byte*>(s16.data()), s16.size() * sizeof(int16_t), nextGain());
+    });
+    report("convert f32->s16", "legacy", [&]() { legacyConvertF32ToS16(floats.data(), s16Out.data(), SampleCount); });
+    report("convert s16->f32", "legacy", [&]() { legacyConvertS16ToF32(s16.data(), floatOut.data(), SampleCount); });
+
+    const auto maxIsa = static_cast<int>(detectedIsa());
+
+    for(int isaIndex{0}; isaIndex <= maxIsa; ++isaIndex) {
+        const auto isa   = static_cast<Isa>(isaIndex);
+        const char* name = isaName(isa);
+
+        report("scale f32", name,
+               [&]() { scaleF32(floats.data(), floats.size(), static_cast<float>(nextGain()), isa); });
+        report("scale s16", name, [&]() { scaleS16(s16.data(), s16.size(), static_cast<float>(nextGain()), isa); });
+        report("convert f32->s16", name, [&]() { convertF32ToS16(floats.data(), s16Out.data(), SampleCount, isa); });
+        report("convert s16->f32", name, [&]() { convertS16ToF32(s16.data(), floatOut.data(), SampleCount, isa); });
+    }
+
+    return 0;
+}
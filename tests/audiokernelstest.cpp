@@ -0,0 +1,164 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "core/engine/audiokernels.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+using namespace Fooyin::Audio::Kernels;
+
+namespace {
+// Covers empty input, lengths shorter than a vector and tails after full SSE2/AVX2 blocks
+constexpr std::array<size_t, 13> Counts{0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 1027};
+
+std::vector<Isa> vectorIsas()
+{
+    std::vector<Isa> isas;
+    for(auto isa = static_cast<uint8_t>(Isa::SSE2); isa <= static_cast<uint8_t>(detectedIsa()); ++isa) {
+        isas.push_back(static_cast<Isa>(isa));
+    }
+    return isas;
+}
+
+template <typename T>
+std::vector<T> randomSamples(size_t count, T min, T max)
+{
+    std::mt19937 gen{static_cast<uint32_t>(count)};
+    std::vector<T> samples(count);
+
+    if constexpr(std::is_floating_point_v<T>) {
+        std::uniform_real_distribution<T> dist{min, max};
+        std::ranges::generate(samples, [&]() { return dist(gen); });
+    }
+    else {
+        std::uniform_int_distribution<int64_t> dist{min, max};
+        std::ranges::generate(samples, [&]() { return static_cast<T>(dist(gen)); });
+    }
+
+    // Make sure the extremes are hit
+    if(count > 0) {
+        samples.front() = min;
+        samples.back()  = max;
+    }
+
+    return samples;
+}
+
+template <typename T, typename Gain, typename Kernel>
+void checkScale(T min, T max, Gain gain, Kernel kernel)
+{
+    for(const Isa isa : vectorIsas()) {
+        for(const size_t count : Counts) {
+            SCOPED_TRACE(testing::Message() << "isa " << static_cast<int>(isa) << ", count " << count);
+
+            std::vector<T> expected = randomSamples<T>(count, min, max);
+            std::vector<T> actual   = expected;
+
+            kernel(expected.data(), count, gain, Isa::Scalar);
+            kernel(actual.data(), count, gain, isa);
+
+            EXPECT_EQ(expected, actual);
+        }
+    }
+}
+
+template <typename In, typename Out, typename Kernel>
+void checkConvert(In min, In max, Kernel kernel)
+{
+    for(const Isa isa : vectorIsas()) {
+        for(const size_t count : Counts) {
+            SCOPED_TRACE(testing::Message() << "isa " << static_cast<int>(isa) << ", count " << count);
+
+            const std::vector<In> input = randomSamples<In>(count, min, max);
+            std::vector<Out> expected(count);
+            std::vector<Out> actual(count);
+
+            kernel(input.data(), expected.data(), count, Isa::Scalar);
+            kernel(input.data(), actual.data(), count, isa);
+
+            EXPECT_EQ(expected, actual);
+        }
+    }
+}
+} // namespace
+
+namespace Fooyin::Testing {
+TEST(AudioKernelsTest, ScaleS16)
+{
+    checkScale<int16_t>(INT16_MIN, INT16_MAX, 0.5F, scaleS16);
+    // Clips on both ends
+    checkScale<int16_t>(INT16_MIN, INT16_MAX, 1.7F, scaleS16);
+}
+
+TEST(AudioKernelsTest, ScaleS32)
+{
+    checkScale<int32_t>(INT32_MIN, INT32_MAX, 0.3, scaleS32);
+    checkScale<int32_t>(INT32_MIN, INT32_MAX, 2.5, scaleS32);
+}
+
+TEST(AudioKernelsTest, ScaleF32)
+{
+    checkScale<float>(-1.0F, 1.0F, 0.7F, scaleF32);
+}
+
+TEST(AudioKernelsTest, ScaleF64)
+{
+    checkScale<double>(-1.0, 1.0, 0.7, scaleF64);
+}
+
+TEST(AudioKernelsTest, ConvertS16ToF32)
+{
+    checkConvert<int16_t, float>(INT16_MIN, INT16_MAX, convertS16ToF32);
+}
+
+TEST(AudioKernelsTest, ConvertS32ToF32)
+{
+    checkConvert<int32_t, float>(INT32_MIN, INT32_MAX, convertS32ToF32);
+}
+
+TEST(AudioKernelsTest, ConvertF32ToS16)
+{
+    // Includes out of range samples to exercise clipping
+    checkConvert<float, int16_t>(-1.5F, 1.5F, convertF32ToS16);
+}
+
+TEST(AudioKernelsTest, ConvertF32ToS32)
+{
+    checkConvert<float, int32_t>(-1.5F, 1.5F, convertF32ToS32);
+}
+
+TEST(AudioKernelsTest, ScalarRoundsAndClips)
+{
+    std::vector<int16_t> samples{INT16_MIN, -3, 3, 1000, INT16_MAX};
+    scaleS16(samples.data(), samples.size(), 2.0F, Isa::Scalar);
+    EXPECT_EQ((std::vector<int16_t>{INT16_MIN, -6, 6, 2000, INT16_MAX}), samples);
+
+    const std::vector<float> input{-2.0F, -1.0F, 0.0F, 0.5F, 1.0F};
+    std::vector<int16_t> output(input.size());
+    convertF32ToS16(input.data(), output.data(), input.size(), Isa::Scalar);
+    EXPECT_EQ((std::vector<int16_t>{INT16_MIN, INT16_MIN, 0, 16384, INT16_MAX}), output);
+}
+} // namespace Fooyin::Testing
@@ -0,0 +1,42 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+
+namespace Fooyin::Testing {
+/*!
+ * Runs @p func once to warm up, then @p iterations more times.
+ * @returns the average time taken by a single run, in seconds.
+ */
+inline double timeIterations(int iterations, const std::function<void()>& func)
+{
+    func();
+
+    const auto start = std::chrono::steady_clock::now();
+    for(int i{0}; i < iterations; ++i) {
+        func();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    return elapsed.count() / static_cast<double>(iterations);
+}
+} // namespace Fooyin::Testing
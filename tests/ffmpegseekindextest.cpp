@@ -0,0 +1,164 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "core/engine/ffmpeg/ffmpegseekindex.h"
+
+#include <core/track.h>
+#include <utils/fypaths.h>
+
+#include <gtest/gtest.h>
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QStandardPaths>
+
+using namespace Qt::StringLiterals;
+
+namespace {
+// 250 frames between entries
+constexpr int SampleRate = 1000;
+} // namespace
+
+namespace Fooyin::Testing {
+class FFmpegSeekIndexTest : public ::testing::Test
+{
+public:
+    static void SetUpTestSuite()
+    {
+        static int argc{1};
+        static char name[] = "test_ffmpegseekindex";
+        static char* argv[] = {name, nullptr};
+        static QCoreApplication app{argc, argv};
+
+        // Keeps indexes out of the user's cache directory
+        QStandardPaths::setTestModeEnabled(true);
+    }
+
+    void TearDown() override
+    {
+        QDir{Utils::cachePath(u"seekindex"_s)}.removeRecursively();
+    }
+
+protected:
+    static Track makeTrack(uint64_t modifiedTime = 2000)
+    {
+        Track track{u"/music/test.mp3"_s};
+        track.setTitle(u"Title"_s);
+        track.setFileSize(100000);
+        track.setModifiedTime(modifiedTime);
+        track.generateHash();
+        return track;
+    }
+
+    static FFmpegSeekIndex makeIndex()
+    {
+        FFmpegSeekIndex index{makeTrack(), SampleRate};
+        index.addPacket(0, 100);
+        index.addPacket(250, 300);
+        index.addPacket(500, 600);
+        index.finish();
+        return index;
+    }
+};
+
+TEST_F(FFmpegSeekIndexTest, AddPacketSpacesEntries)
+{
+    FFmpegSeekIndex index{makeTrack(), SampleRate};
+    ASSERT_TRUE(index.isValid());
+    EXPECT_TRUE(index.isEmpty());
+
+    index.addPacket(0, 100);
+    // Too close to the previous entry
+    index.addPacket(100, 200);
+    index.addPacket(250, 300);
+    // Positions must increase
+    index.addPacket(500, 300);
+    index.addPacket(600, -1);
+
+    EXPECT_EQ(300, index.find(499)->pos);
+    EXPECT_EQ(300, index.find(250)->pos);
+    EXPECT_EQ(100, index.find(249)->pos);
+}
+
+TEST_F(FFmpegSeekIndexTest, FindCoversDecodedRange)
+{
+    FFmpegSeekIndex index{makeTrack(), SampleRate};
+    index.addPacket(100, 100);
+    index.addPacket(350, 300);
+
+    EXPECT_FALSE(index.find(50).has_value());
+    EXPECT_EQ(100, index.find(100)->pos);
+    EXPECT_EQ(300, index.find(600)->pos);
+    // Beyond what has been decoded so far
+    EXPECT_FALSE(index.find(601).has_value());
+
+    index.finish();
+    EXPECT_TRUE(index.isComplete());
+    EXPECT_EQ(300, index.find(100000)->pos);
+}
+
+TEST_F(FFmpegSeekIndexTest, SaveAndLoad)
+{
+    FFmpegSeekIndex incomplete{makeTrack(), SampleRate};
+    incomplete.addPacket(0, 100);
+    EXPECT_FALSE(incomplete.save());
+
+    FFmpegSeekIndex index = makeIndex();
+    ASSERT_TRUE(index.save());
+
+    FFmpegSeekIndex loaded{makeTrack(), SampleRate};
+    ASSERT_TRUE(loaded.load());
+    EXPECT_TRUE(loaded.isComplete());
+    EXPECT_EQ(100, loaded.find(0)->pos);
+    EXPECT_EQ(300, loaded.find(499)->pos);
+    EXPECT_EQ(600, loaded.find(100000)->pos);
+}
+
+TEST_F(FFmpegSeekIndexTest, ChangedFileIsNotLoaded)
+{
+    FFmpegSeekIndex index = makeIndex();
+    ASSERT_TRUE(index.save());
+
+    FFmpegSeekIndex modified{makeTrack(3000), SampleRate};
+    EXPECT_FALSE(modified.load());
+    EXPECT_TRUE(modified.isEmpty());
+
+    FFmpegSeekIndex resampled{makeTrack(), SampleRate * 2};
+    EXPECT_FALSE(resampled.load());
+}
+
+TEST_F(FFmpegSeekIndexTest, TruncatedIndexIsRejected)
+{
+    FFmpegSeekIndex index = makeIndex();
+    ASSERT_TRUE(index.save());
+
+    const QFileInfoList files = QDir{Utils::cachePath(u"seekindex"_s)}.entryInfoList({u"*.idx"_s}, QDir::Files);
+    ASSERT_EQ(1, files.size());
+
+    // Drop the last entry, leaving a count which claims more entries than the file holds
+    QFile file{files.front().absoluteFilePath()};
+    ASSERT_TRUE(file.resize(file.size() - 16));
+
+    FFmpegSeekIndex loaded{makeTrack(), SampleRate};
+    EXPECT_FALSE(loaded.load());
+    EXPECT_TRUE(loaded.isEmpty());
+    EXPECT_FALSE(QFile::exists(files.front().absoluteFilePath()));
+}
+} // namespace Fooyin::Testing
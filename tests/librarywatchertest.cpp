@@ -0,0 +1,159 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "core/library/librarywatcher.h"
+
+#include <gtest/gtest.h>
+
+using namespace Qt::StringLiterals;
+
+namespace {
+using Moves = std::vector<std::pair<QString, QString>>;
+} // namespace
+
+namespace Fooyin::Testing {
+TEST(LibraryChangeCollectorTest, Empty)
+{
+    LibraryChangeCollector collector;
+    EXPECT_TRUE(collector.takeChanges().isEmpty());
+}
+
+TEST(LibraryChangeCollectorTest, TakeResets)
+{
+    LibraryChangeCollector collector;
+    collector.addModified(u"/music/a.flac"_s);
+    collector.addRemoved(u"/music/b.flac"_s);
+    collector.addMoved(u"/music/c.flac"_s, u"/music/d.flac"_s);
+    collector.addDir(u"/music/album"_s);
+
+    EXPECT_FALSE(collector.takeChanges().isEmpty());
+    EXPECT_TRUE(collector.takeChanges().isEmpty());
+}
+
+TEST(LibraryChangeCollectorTest, DuplicatesAreMerged)
+{
+    LibraryChangeCollector collector;
+    collector.addModified(u"/music/a.flac"_s);
+    collector.addModified(u"/music/a.flac"_s);
+    collector.addDir(u"/music/album"_s);
+    collector.addDir(u"/music/album"_s);
+
+    const LibraryChanges changes = collector.takeChanges();
+    EXPECT_EQ(QStringList{u"/music/a.flac"_s}, changes.modified);
+    EXPECT_EQ(QStringList{u"/music/album"_s}, changes.dirs);
+}
+
+TEST(LibraryChangeCollectorTest, WriteThenDelete)
+{
+    LibraryChangeCollector collector;
+    collector.addModified(u"/music/a.flac"_s);
+    collector.addRemoved(u"/music/a.flac"_s);
+
+    const LibraryChanges changes = collector.takeChanges();
+    EXPECT_TRUE(changes.modified.empty());
+    EXPECT_EQ(QStringList{u"/music/a.flac"_s}, changes.removed);
+}
+
+TEST(LibraryChangeCollectorTest, DeleteThenRecreate)
+{
+    LibraryChangeCollector collector;
+    collector.addRemoved(u"/music/a.flac"_s);
+    collector.addModified(u"/music/a.flac"_s);
+
+    const LibraryChanges changes = collector.takeChanges();
+    EXPECT_EQ(QStringList{u"/music/a.flac"_s}, changes.modified);
+    EXPECT_TRUE(changes.removed.empty());
+}
+
+TEST(LibraryChangeCollectorTest, WriteThenRename)
+{
+    LibraryChangeCollector collector;
+    collector.addModified(u"/music/a.flac.part"_s);
+    collector.addMoved(u"/music/a.flac.part"_s, u"/music/a.flac"_s);
+
+    const LibraryChanges changes = collector.takeChanges();
+    EXPECT_EQ(QStringList{u"/music/a.flac"_s}, changes.modified);
+    EXPECT_TRUE(changes.moved.empty());
+    EXPECT_TRUE(changes.removed.empty());
+}
+
+TEST(LibraryChangeCollectorTest, MovesKeepOrder)
+{
+    LibraryChangeCollector collector;
+    collector.addMoved(u"/music/b.flac"_s, u"/music/c.flac"_s);
+    collector.addMoved(u"/music/a.flac"_s, u"/music/b.flac"_s);
+
+    const LibraryChanges changes = collector.takeChanges();
+    EXPECT_EQ((Moves{{u"/music/b.flac"_s, u"/music/c.flac"_s}, {u"/music/a.flac"_s, u"/music/b.flac"_s}}),
+              changes.moved);
+    EXPECT_TRUE(changes.modified.empty());
+    EXPECT_TRUE(changes.removed.empty());
+}
+
+TEST(LibraryChangeCollectorTest, MoveOverPendingChanges)
+{
+    LibraryChangeCollector collector;
+    collector.addModified(u"/music/b.flac"_s);
+    collector.addRemoved(u"/music/c.flac"_s);
+    collector.addMoved(u"/music/a.flac"_s, u"/music/b.flac"_s);
+    collector.addMoved(u"/music/d.flac"_s, u"/music/c.flac"_s);
+
+    const LibraryChanges changes = collector.takeChanges();
+    EXPECT_EQ((Moves{{u"/music/a.flac"_s, u"/music/b.flac"_s}, {u"/music/d.flac"_s, u"/music/c.flac"_s}}),
+              changes.moved);
+    EXPECT_TRUE(changes.modified.empty());
+    EXPECT_TRUE(changes.removed.empty());
+}
+
+TEST(LibraryChangeCollectorTest, MoveThenDelete)
+{
+    LibraryChangeCollector collector;
+    collector.addMoved(u"/music/a.flac"_s, u"/music/b.flac"_s);
+    collector.addRemoved(u"/music/b.flac"_s);
+
+    const LibraryChanges changes = collector.takeChanges();
+    EXPECT_TRUE(changes.moved.empty());
+    EXPECT_EQ((QStringList{u"/music/a.flac"_s, u"/music/b.flac"_s}), changes.removed);
+}
+
+TEST(LibraryChangeCollectorTest, RenameChainThenDelete)
+{
+    LibraryChangeCollector collector;
+    collector.addMoved(u"/music/x.flac"_s, u"/music/y.flac"_s);
+    collector.addMoved(u"/music/a.flac"_s, u"/music/b.flac"_s);
+    collector.addMoved(u"/music/b.flac"_s, u"/music/c.flac"_s);
+    collector.addRemoved(u"/music/c.flac"_s);
+
+    const LibraryChanges changes = collector.takeChanges();
+    EXPECT_EQ((Moves{{u"/music/x.flac"_s, u"/music/y.flac"_s}}), changes.moved);
+    EXPECT_EQ((QStringList{u"/music/a.flac"_s, u"/music/b.flac"_s, u"/music/c.flac"_s}), changes.removed);
+}
+
+TEST(LibraryChangeCollectorTest, MoveIntoDirThenDeleteDir)
+{
+    LibraryChangeCollector collector;
+    collector.addMoved(u"/music/a.flac"_s, u"/music/album/a.flac"_s);
+    collector.addMoved(u"/music/b.flac"_s, u"/music/album2/b.flac"_s);
+    collector.addRemoved(u"/music/album"_s);
+
+    const LibraryChanges changes = collector.takeChanges();
+    EXPECT_EQ((Moves{{u"/music/b.flac"_s, u"/music/album2/b.flac"_s}}), changes.moved);
+    EXPECT_EQ((QStringList{u"/music/a.flac"_s, u"/music/album"_s}), changes.removed);
+}
+} // namespace Fooyin::Testing
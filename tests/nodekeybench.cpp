@@ -0,0 +1,99 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "benchutils.h"
+
+#include <utils/crypto.h>
+
+#include <QStringList>
+
+#include <cstdio>
+#include <functional>
+#include <unordered_set>
+
+// Compares generating the keys of a three level grouping tree (artist/album/title) with MD5 and the node key hash
+
+using namespace Qt::StringLiterals;
+
+namespace {
+constexpr int TrackCount = 300000;
+constexpr int Iterations = 5;
+
+struct Grouping
+{
+    QStringList artists;
+    QStringList albums;
+    QStringList titles;
+};
+
+Grouping generateGrouping()
+{
+    Grouping grouping;
+
+    for(int i{0}; i < TrackCount; ++i) {
+        grouping.artists.emplace_back(u"Artist %1"_s.arg(i % 2000));
+        grouping.albums.emplace_back(u"Album %1 (Deluxe Edition)"_s.arg(i % 25000));
+        grouping.titles.emplace_back(u"%1. Title of track number %2"_s.arg((i % 12) + 1).arg(i));
+    }
+
+    return grouping;
+}
+
+template <typename Func>
+size_t generateKeys(const Grouping& grouping, Func&& keyFunc)
+{
+    std::unordered_set<Fooyin::Md5Hash> keys;
+
+    for(int i{0}; i < TrackCount; ++i) {
+        const auto artistKey = keyFunc(Fooyin::Md5Hash{}, grouping.artists.at(i));
+        const auto albumKey  = keyFunc(artistKey, grouping.albums.at(i));
+        const auto titleKey  = keyFunc(albumKey, grouping.titles.at(i));
+        keys.insert(titleKey);
+    }
+
+    return keys.size();
+}
+
+void report(const char* variant, const std::function<size_t()>& func)
+{
+    size_t uniqueKeys{0};
+    const double seconds = Fooyin::Testing::timeIterations(Iterations, [&]() { uniqueKeys = func(); });
+
+    std::printf("%-10s %12.0f tracks/s (%zu unique keys)\n", variant, static_cast<double>(TrackCount) / seconds,
+                uniqueKeys);
+}
+} // namespace
+
+int main()
+{
+    const Grouping grouping = generateGrouping();
+
+    report("md5", [&grouping]() {
+        return generateKeys(grouping, [](const Fooyin::Md5Hash& parent, const QString& title) {
+            return Fooyin::Utils::generateMd5Hash(parent, title);
+        });
+    });
+
+    report("node key", [&grouping]() {
+        return generateKeys(grouping, [](const Fooyin::Md5Hash& parent, const QString& title) {
+            return Fooyin::Utils::generateNodeKey(parent, title);
+        });
+    });
+
+    return 0;
+}
@@ -0,0 +1,73 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <utils/crypto.h>
+
+#include <gtest/gtest.h>
+
+#include <QStringList>
+
+using namespace Qt::StringLiterals;
+
+namespace Fooyin::Testing {
+namespace {
+Md5Hash hashValues(const QStringList& values)
+{
+    Utils::KeyHasher hasher;
+    for(const QString& value : values) {
+        hasher.addData(value);
+    }
+    return hasher.result();
+}
+} // namespace
+
+TEST(NodeKeyTest, IsDeterministic)
+{
+    EXPECT_EQ(hashValues({u"Artist"_s, u"Album"_s}), hashValues({u"Artist"_s, u"Album"_s}));
+    EXPECT_EQ(Utils::generateNodeKey(u"Artist"_s, 5), Utils::generateNodeKey(u"Artist"_s, 5));
+    EXPECT_EQ(16, hashValues({u"Artist"_s}).size());
+}
+
+TEST(NodeKeyTest, ValueBoundariesAreDistinct)
+{
+    EXPECT_NE(hashValues({u"ab"_s, u"c"_s}), hashValues({u"a"_s, u"bc"_s}));
+    EXPECT_NE(hashValues({u""_s, u"abc"_s}), hashValues({u"abc"_s, u""_s}));
+    EXPECT_NE(hashValues({u"abc"_s}), hashValues({u"abc"_s, u""_s}));
+
+    // Values spanning the 16 byte block size
+    EXPECT_NE(hashValues({u"abcdefgh"_s, u"i"_s}), hashValues({u"abcdefghi"_s}));
+    EXPECT_NE(hashValues({u"abcdefg"_s, u"hi"_s}), hashValues({u"abcdefgh"_s, u"i"_s}));
+
+    EXPECT_NE(Utils::generateNodeKey(u"ab"_s, u"c"_s), Utils::generateNodeKey(u"a"_s, u"bc"_s));
+}
+
+TEST(NodeKeyTest, OrderMatters)
+{
+    EXPECT_NE(hashValues({u"Artist"_s, u"Album"_s}), hashValues({u"Album"_s, u"Artist"_s}));
+}
+
+TEST(NodeKeyTest, ParentKeysChain)
+{
+    const Md5Hash artist = Utils::generateNodeKey(Md5Hash{}, u"Artist"_s);
+    const Md5Hash album  = Utils::generateNodeKey(artist, u"Album"_s);
+
+    EXPECT_NE(artist, album);
+    EXPECT_NE(album, Utils::generateNodeKey(Utils::generateNodeKey(Md5Hash{}, u"Other"_s), u"Album"_s));
+}
+} // namespace Fooyin::Testing
@@ -0,0 +1,177 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "core/database/playlistdatabase.h"
+
+#include <core/track.h>
+#include <utils/database/dbconnectionhandler.h>
+#include <utils/database/dbconnectionprovider.h>
+#include <utils/database/dbquery.h>
+
+#include <gtest/gtest.h>
+
+#include <QCoreApplication>
+#include <QTemporaryDir>
+
+using namespace Qt::StringLiterals;
+
+namespace Fooyin::Testing {
+class PlaylistDatabaseTest : public ::testing::Test
+{
+public:
+    PlaylistDatabaseTest()
+        : m_dbPool{DbConnectionPool::create(
+              {.type = u"QSQLITE"_s, .connectOptions = {}, .hostName = {}, .filePath = m_dir.filePath(u"test.db"_s)},
+              u"playlistdatabasetest"_s)}
+        , m_connectionHandler{m_dbPool}
+    {
+        m_playlistDb.initialise(DbConnectionProvider{m_dbPool});
+
+        DbQuery createPlaylists{m_playlistDb.db(), u"CREATE TABLE Playlists (PlaylistID INTEGER PRIMARY KEY, "
+                                                   "Name TEXT, PlaylistIndex INTEGER, IsAutoPlaylist INTEGER, "
+                                                   "Query TEXT);"_s};
+        createPlaylists.exec();
+
+        DbQuery createTracks{m_playlistDb.db(), u"CREATE TABLE PlaylistTracks (PlaylistID INTEGER NOT NULL, "
+                                                "TrackID INTEGER NOT NULL, TrackIndex INTEGER NOT NULL);"_s};
+        createTracks.exec();
+
+        m_playlistId = m_playlistDb.insertPlaylist(u"Test"_s, 0, false, {});
+    }
+
+    static void SetUpTestSuite()
+    {
+        // Database drivers are loaded as plugins, which requires an application instance
+        static int argc{1};
+        static char name[] = "test_playlistdatabase";
+        static char* argv[] = {name, nullptr};
+        static QCoreApplication app{argc, argv};
+    }
+
+protected:
+    static TrackList makeTracks(const std::vector<int>& ids)
+    {
+        TrackList tracks;
+        for(const int id : ids) {
+            Track track{u"/music/%1.flac"_s.arg(id)};
+            track.setId(id);
+            tracks.push_back(track);
+        }
+        return tracks;
+    }
+
+    bool save(const std::vector<int>& ids, const std::vector<PlaylistTrackEdit>& edits)
+    {
+        return m_playlistDb.savePlaylistTracks(m_playlistId, makeTracks(ids), edits);
+    }
+
+    // Returns the stored track ids in order, or an empty list if the stored indexes aren't contiguous
+    std::vector<int> storedTracks()
+    {
+        DbQuery query{m_playlistDb.db(), u"SELECT TrackID, TrackIndex FROM PlaylistTracks "
+                                         "WHERE PlaylistID = :id ORDER BY TrackIndex;"_s};
+        query.bindValue(u":id"_s, m_playlistId);
+
+        std::vector<int> ids;
+        if(!query.exec()) {
+            return ids;
+        }
+
+        while(query.next()) {
+            if(!std::cmp_equal(query.value(1).toInt(), ids.size())) {
+                return {};
+            }
+            ids.push_back(query.value(0).toInt());
+        }
+
+        return ids;
+    }
+
+    QTemporaryDir m_dir;
+    DbConnectionPoolPtr m_dbPool;
+    DbConnectionHandler m_connectionHandler;
+    PlaylistDatabase m_playlistDb;
+    int m_playlistId{-1};
+};
+
+TEST_F(PlaylistDatabaseTest, ResetRewritesTracks)
+{
+    ASSERT_TRUE(m_dir.isValid());
+    ASSERT_GE(m_playlistId, 0);
+
+    EXPECT_TRUE(save({1, 2, 3}, {{.type = PlaylistTrackEdit::Type::Reset}}));
+    EXPECT_EQ(storedTracks(), (std::vector<int>{1, 2, 3}));
+
+    EXPECT_TRUE(save({3, 1}, {{.type = PlaylistTrackEdit::Type::Reset}}));
+    EXPECT_EQ(storedTracks(), (std::vector<int>{3, 1}));
+}
+
+TEST_F(PlaylistDatabaseTest, ReplaysInsert)
+{
+    ASSERT_TRUE(save({1, 2, 3}, {{.type = PlaylistTrackEdit::Type::Reset}}));
+
+    EXPECT_TRUE(save({1, 4, 5, 2, 3},
+                     {{.type = PlaylistTrackEdit::Type::Insert, .index = 1, .count = 2, .tracks = makeTracks({4, 5})}}));
+    EXPECT_EQ(storedTracks(), (std::vector<int>{1, 4, 5, 2, 3}));
+
+    EXPECT_TRUE(save({1, 4, 5, 2, 3, 6},
+                     {{.type = PlaylistTrackEdit::Type::Insert, .index = 5, .count = 1, .tracks = makeTracks({6})}}));
+    EXPECT_EQ(storedTracks(), (std::vector<int>{1, 4, 5, 2, 3, 6}));
+}
+
+TEST_F(PlaylistDatabaseTest, ReplaysRemove)
+{
+    ASSERT_TRUE(save({1, 2, 3, 4, 5}, {{.type = PlaylistTrackEdit::Type::Reset}}));
+
+    EXPECT_TRUE(save({1, 4, 5}, {{.type = PlaylistTrackEdit::Type::Remove, .index = 1, .count = 2}}));
+    EXPECT_EQ(storedTracks(), (std::vector<int>{1, 4, 5}));
+
+    EXPECT_TRUE(save({4, 5}, {{.type = PlaylistTrackEdit::Type::Remove, .index = 0, .count = 1}}));
+    EXPECT_EQ(storedTracks(), (std::vector<int>{4, 5}));
+}
+
+TEST_F(PlaylistDatabaseTest, ReplaysMove)
+{
+    ASSERT_TRUE(save({1, 2, 3, 4, 5}, {{.type = PlaylistTrackEdit::Type::Reset}}));
+
+    // Forwards
+    EXPECT_TRUE(
+        save({3, 4, 5, 1, 2}, {{.type = PlaylistTrackEdit::Type::Move, .index = 0, .count = 2, .destination = 3}}));
+    EXPECT_EQ(storedTracks(), (std::vector<int>{3, 4, 5, 1, 2}));
+
+    // Backwards
+    EXPECT_TRUE(
+        save({1, 3, 4, 5, 2}, {{.type = PlaylistTrackEdit::Type::Move, .index = 3, .count = 1, .destination = 0}}));
+    EXPECT_EQ(storedTracks(), (std::vector<int>{1, 3, 4, 5, 2}));
+}
+
+TEST_F(PlaylistDatabaseTest, ReplaysEditsInOrder)
+{
+    ASSERT_TRUE(save({1, 2, 3, 4}, {{.type = PlaylistTrackEdit::Type::Reset}}));
+
+    const std::vector<PlaylistTrackEdit> edits{
+        {.type = PlaylistTrackEdit::Type::Insert, .index = 4, .count = 2, .tracks = makeTracks({5, 6})},
+        {.type = PlaylistTrackEdit::Type::Remove, .index = 0, .count = 1},
+        {.type = PlaylistTrackEdit::Type::Move, .index = 3, .count = 2, .destination = 0},
+    };
+
+    EXPECT_TRUE(save({5, 6, 2, 3, 4}, edits));
+    EXPECT_EQ(storedTracks(), (std::vector<int>{5, 6, 2, 3, 4}));
+}
+} // namespace Fooyin::Testing
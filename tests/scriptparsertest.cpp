@@ -17,6 +17,8 @@
  *
  */
 
+#include <core/library/tracksearchindex.h>
+#include <core/scripting/incrementalfilter.h>
 #include <core/scripting/scriptparser.h>
 #include <core/track.h>
 
@@ -250,4 +252,81 @@ TEST_F(ScriptParserTest, QueryTest)
     query = QStringLiteral("((playcount>=1 AND bitrate>500) OR title:Celest) AND (duration_ms>180000)");
     EXPECT_EQ(2, m_parser.filter(query, tracks).size());
 }
+
+TEST_F(ScriptParserTest, SearchIndexTest)
+{
+    TrackList tracks;
+
+    Track track1;
+    track1.setId(0);
+    track1.setTitle(QStringLiteral("Déjà Vu"));
+    track1.setArtists({QStringLiteral("Beyoncé"), QStringLiteral("Jay-Z")});
+    tracks.push_back(track1);
+
+    Track track2;
+    track2.setId(1);
+    track2.setTitle(QStringLiteral("Crazy in Love"));
+    track2.setArtists({QStringLiteral("Beyonce")});
+    track2.setGenres({QStringLiteral("Pop")});
+    tracks.push_back(track2);
+
+    auto index = std::make_shared<TrackSearchIndex>();
+    index->reset(tracks);
+    EXPECT_EQ(2, index->size());
+
+    m_parser.setSearchIndex(index);
+
+    EXPECT_EQ(2, m_parser.filter(QStringLiteral("beyonce"), tracks).size());
+    EXPECT_EQ(2, m_parser.filter(QStringLiteral("BEYONCÉ"), tracks).size());
+    EXPECT_EQ(1, m_parser.filter(QStringLiteral("deja jay"), tracks).size());
+    EXPECT_EQ(0, m_parser.filter(QStringLiteral("\"deja jay\""), tracks).size());
+    EXPECT_EQ(1, m_parser.filter(QStringLiteral("pop"), tracks).size());
+
+    Track updatedTrack{track2};
+    updatedTrack.setTitle(QStringLiteral("Halo"));
+    index->insertTracks({updatedTrack});
+    EXPECT_EQ(0, m_parser.filter(QStringLiteral("crazy"), tracks).size());
+
+    index->removeTracks({updatedTrack});
+    EXPECT_EQ(1, index->size());
+    // Tracks not in the index are matched on demand
+    EXPECT_EQ(1, m_parser.filter(QStringLiteral("crazy"), tracks).size());
+}
+
+TEST_F(ScriptParserTest, IncrementalFilterTest)
+{
+    TrackList tracks;
+
+    Track track1;
+    track1.setId(0);
+    track1.setTitle(QStringLiteral("Wandering Horizon"));
+    tracks.push_back(track1);
+
+    Track track2;
+    track2.setId(1);
+    track2.setTitle(QStringLiteral("Celestial Waves"));
+    tracks.push_back(track2);
+
+    IncrementalFilter<TrackList> filter;
+    uint64_t generation = filter.generation();
+
+    EXPECT_EQ(2, filter.filter(QStringLiteral("wa"), tracks, generation).size());
+    EXPECT_EQ(1, filter.filter(QStringLiteral("wan"), tracks, generation).size());
+    EXPECT_EQ(1, filter.filter(QStringLiteral("wan hor"), tracks, generation).size());
+    EXPECT_EQ(0, filter.filter(QStringLiteral("wan hors"), tracks, generation).size());
+    EXPECT_EQ(2, filter.filter(QStringLiteral("wa"), tracks, generation).size());
+    EXPECT_EQ(1, filter.filter(QStringLiteral("waves"), tracks, generation).size());
+    EXPECT_EQ(1, filter.filter(QStringLiteral("title:wan"), tracks, generation).size());
+
+    // Narrowed results are only reused for the same source tracks
+    Track track3;
+    track3.setId(2);
+    track3.setTitle(QStringLiteral("Wavelength"));
+    tracks.push_back(track3);
+
+    filter.invalidate();
+    generation = filter.generation();
+
+    EXPECT_EQ(2, filter.filter(QStringLiteral("wave"), tracks, generation).size());
+}
 } // namespace Fooyin::Testing
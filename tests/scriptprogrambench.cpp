@@ -0,0 +1,93 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "benchutils.h"
+
+#include <core/scripting/scriptparser.h>
+#include <core/track.h>
+
+#include <cstdio>
+#include <functional>
+
+// Compares evaluating a typical playlist format script with the tree-walking interpreter and the compiled program
+
+using namespace Qt::StringLiterals;
+
+namespace {
+constexpr int TrackCount = 20000;
+constexpr int Iterations = 10;
+
+Fooyin::TrackList generateTracks()
+{
+    Fooyin::TrackList tracks;
+    tracks.reserve(TrackCount);
+
+    for(int i{0}; i < TrackCount; ++i) {
+        Fooyin::Track track;
+        track.setFilePath(u"/music/Artist %1/Album %2/%3.flac"_s.arg(i % 50).arg(i % 400).arg(i));
+        track.setTitle(u"Title %1"_s.arg(i));
+        track.setArtists({u"Artist %1"_s.arg(i % 50), u"Guest %1"_s.arg(i % 7)});
+        track.setAlbumArtists({u"Artist %1"_s.arg(i % 50)});
+        track.setAlbum(u"Album %1"_s.arg(i % 400));
+        track.setTrackNumber(QString::number((i % 12) + 1));
+        track.setDiscNumber(QString::number((i % 2) + 1));
+        track.setGenres({u"Rock"_s, u"Pop"_s});
+        track.setDate(QString::number(1970 + (i % 50)));
+        track.setDuration(static_cast<uint64_t>(180000 + (i % 120) * 1000));
+        track.setBitrate(900 + (i % 100));
+        tracks.push_back(track);
+    }
+
+    return tracks;
+}
+
+void report(const char* variant, const std::function<void()>& func)
+{
+    const double seconds = Fooyin::Testing::timeIterations(Iterations, func);
+
+    std::printf("%-12s %12.0f tracks/s\n", variant, static_cast<double>(TrackCount) / seconds);
+}
+} // namespace
+
+int main()
+{
+    const Fooyin::TrackList tracks = generateTracks();
+
+    const QString script = u"[%albumartist% - ]%album%[ CD%disc%] $num(%track%,2). "
+                           "$if2(%title%,$filename(%path%))[ // %artist%] $crlf()%genre% | %year% | "
+                           "$upper(flac) %bitrate%kbps $timems(%duration%)"_s;
+
+    Fooyin::ScriptParser parser;
+    const Fooyin::ParsedScript parsed = parser.parse(script);
+
+    parser.setCompileScripts(false);
+    report("interpreted", [&]() {
+        for(const auto& track : tracks) {
+            parser.evaluate(parsed, track);
+        }
+    });
+
+    parser.setCompileScripts(true);
+    report("compiled", [&]() {
+        for(const auto& track : tracks) {
+            parser.evaluate(parsed, track);
+        }
+    });
+
+    return 0;
+}
@@ -0,0 +1,210 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "core/database/sortcachedatabase.h"
+
+#include <core/library/tracksort.h>
+#include <core/track.h>
+#include <utils/database/dbconnectionhandler.h>
+#include <utils/database/dbconnectionprovider.h>
+#include <utils/database/dbquery.h>
+
+#include <gtest/gtest.h>
+
+#include <QCoreApplication>
+#include <QTemporaryDir>
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+
+using namespace Qt::StringLiterals;
+
+namespace {
+const QString SortScript = u"%albumartist% - %title%"_s;
+} // namespace
+
+namespace Fooyin::Testing {
+class SortCacheDatabaseTest : public ::testing::Test
+{
+public:
+    SortCacheDatabaseTest()
+        : m_dbPool{DbConnectionPool::create(
+              {.type = u"QSQLITE"_s, .connectOptions = {}, .hostName = {}, .filePath = m_dir.filePath(u"test.db"_s)},
+              u"sortcachedatabasetest"_s)}
+        , m_connectionHandler{m_dbPool}
+    {
+        m_sortDb.initialise(DbConnectionProvider{m_dbPool});
+
+        DbQuery createSorts{m_sortDb.db(), u"CREATE TABLE TrackSorts (TrackID INTEGER PRIMARY KEY, "
+                                           "ScriptHash TEXT NOT NULL, Stamp TEXT NOT NULL, SortKey TEXT, "
+                                           "SortIndex INTEGER);"_s};
+        createSorts.exec();
+    }
+
+    static void SetUpTestSuite()
+    {
+        // Database drivers are loaded as plugins, which requires an application instance
+        static int argc{1};
+        static char name[] = "test_sortcachedatabase";
+        static char* argv[] = {name, nullptr};
+        static QCoreApplication app{argc, argv};
+    }
+
+protected:
+    static Track makeTrack(int id, const QString& albumArtist)
+    {
+        Track track{u"/music/%1.flac"_s.arg(id)};
+        track.setId(id);
+        track.setTitle(u"Title"_s);
+        track.setAlbumArtists({albumArtist});
+        track.setModifiedTime(1000);
+        return track;
+    }
+
+    // Loads the library as on startup, returning the track ids in sorted order
+    std::vector<int> load(const TrackList& tracks, const QString& script = SortScript)
+    {
+        const auto cachedSorts = m_sortDb.cachedSorts(SortCacheDatabase::scriptHash(script));
+
+        const bool includePlayStats = SortCacheDatabase::usesPlayStats(script);
+
+        TrackList changedTracks;
+        TrackList sortedTracks = SortCacheDatabase::restoreSorts(cachedSorts, tracks, includePlayStats, changedTracks);
+        m_changedCount = changedTracks.size();
+
+        sortedTracks = TrackSorter::mergeTracks(sortedTracks, m_sorter.calcSortTracks(script, changedTracks));
+        EXPECT_TRUE(m_sortDb.storeSorts(script, sortedTracks));
+
+        std::vector<int> ids;
+        std::ranges::transform(sortedTracks, std::back_inserter(ids), &Track::id);
+        return ids;
+    }
+
+    std::map<int, int64_t> storedIndexes()
+    {
+        DbQuery query{m_sortDb.db(), u"SELECT TrackID, SortIndex FROM TrackSorts;"_s};
+
+        std::map<int, int64_t> indexes;
+        if(query.exec()) {
+            while(query.next()) {
+                indexes.emplace(query.value(0).toInt(), query.value(1).toLongLong());
+            }
+        }
+        return indexes;
+    }
+
+    QTemporaryDir m_dir;
+    DbConnectionPoolPtr m_dbPool;
+    DbConnectionHandler m_connectionHandler;
+    SortCacheDatabase m_sortDb;
+    TrackSorter m_sorter;
+    size_t m_changedCount{0};
+};
+
+TEST_F(SortCacheDatabaseTest, RestoresCachedOrder)
+{
+    ASSERT_TRUE(m_dir.isValid());
+
+    const TrackList tracks{makeTrack(1, u"D"_s), makeTrack(2, u"B"_s), makeTrack(3, u"A"_s), makeTrack(4, u"C"_s)};
+
+    EXPECT_EQ(load(tracks), (std::vector<int>{3, 2, 4, 1}));
+    EXPECT_EQ(4U, m_changedCount);
+
+    EXPECT_EQ(load(tracks), (std::vector<int>{3, 2, 4, 1}));
+    EXPECT_EQ(0U, m_changedCount);
+}
+
+TEST_F(SortCacheDatabaseTest, AlbumArtistEditResorts)
+{
+    TrackList tracks{makeTrack(1, u"A"_s), makeTrack(2, u"B"_s), makeTrack(3, u"C"_s), makeTrack(4, u"D"_s)};
+    ASSERT_EQ(load(tracks), (std::vector<int>{1, 2, 3, 4}));
+
+    // Edited in the database only, so the file's modification time is unchanged
+    tracks[0].setAlbumArtists({u"E"_s});
+
+    EXPECT_EQ(load(tracks), (std::vector<int>{2, 3, 4, 1}));
+    EXPECT_EQ(1U, m_changedCount);
+
+    EXPECT_EQ(load(tracks), (std::vector<int>{2, 3, 4, 1}));
+    EXPECT_EQ(0U, m_changedCount);
+}
+
+TEST_F(SortCacheDatabaseTest, OnlyChangedRowsAreWritten)
+{
+    TrackList tracks{makeTrack(1, u"A"_s), makeTrack(2, u"B"_s), makeTrack(3, u"C"_s), makeTrack(4, u"D"_s)};
+    ASSERT_EQ(load(tracks), (std::vector<int>{1, 2, 3, 4}));
+
+    const auto initialIndexes = storedIndexes();
+
+    // Moved between two unchanged tracks, which keep their rows
+    tracks[3].setAlbumArtists({u"BB"_s});
+    tracks.push_back(makeTrack(5, u"CC"_s));
+
+    EXPECT_EQ(load(tracks), (std::vector<int>{1, 2, 4, 3, 5}));
+
+    const auto indexes = storedIndexes();
+    ASSERT_EQ(5U, indexes.size());
+    EXPECT_EQ(initialIndexes.at(1), indexes.at(1));
+    EXPECT_EQ(initialIndexes.at(2), indexes.at(2));
+    EXPECT_EQ(initialIndexes.at(3), indexes.at(3));
+
+    // Removed tracks only have their rows deleted
+    tracks.erase(tracks.begin() + 1);
+    EXPECT_EQ(load(tracks), (std::vector<int>{1, 4, 3, 5}));
+    EXPECT_EQ(0U, m_changedCount);
+
+    const auto remainingIndexes = storedIndexes();
+    ASSERT_EQ(4U, remainingIndexes.size());
+    EXPECT_EQ(indexes.at(4), remainingIndexes.at(4));
+    EXPECT_EQ(indexes.at(5), remainingIndexes.at(5));
+}
+
+TEST_F(SortCacheDatabaseTest, PlayStatsOnlyStampedWhenUsed)
+{
+    EXPECT_FALSE(SortCacheDatabase::usesPlayStats(SortScript));
+    EXPECT_TRUE(SortCacheDatabase::usesPlayStats(u"%playcount%"_s));
+    EXPECT_TRUE(SortCacheDatabase::usesPlayStats(u"$num(%rating_stars%,2)"_s));
+
+    const Track track = makeTrack(1, u"A"_s);
+    Track played{track};
+    played.setPlayCount(10);
+
+    EXPECT_EQ(SortCacheDatabase::trackStamp(track, false), SortCacheDatabase::trackStamp(played, false));
+    EXPECT_NE(SortCacheDatabase::trackStamp(track, true), SortCacheDatabase::trackStamp(played, true));
+
+    // Playback doesn't invalidate the cache of a script which doesn't use play stats
+    TrackList tracks{track, makeTrack(2, u"B"_s)};
+    ASSERT_EQ(load(tracks), (std::vector<int>{1, 2}));
+
+    tracks[0] = played;
+    EXPECT_EQ(load(tracks), (std::vector<int>{1, 2}));
+    EXPECT_EQ(0U, m_changedCount);
+}
+
+TEST_F(SortCacheDatabaseTest, ScriptChangeReplacesRows)
+{
+    const TrackList tracks{makeTrack(1, u"A"_s), makeTrack(2, u"B"_s)};
+    ASSERT_EQ(load(tracks), (std::vector<int>{1, 2}));
+
+    EXPECT_EQ(load(tracks, u"%title%"_s), (std::vector<int>{1, 2}));
+    EXPECT_EQ(2U, m_changedCount);
+    EXPECT_EQ(2U, storedIndexes().size());
+}
+} // namespace Fooyin::Testing
@@ -0,0 +1,134 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <utils/spscqueue.h>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+
+namespace Fooyin::Testing {
+TEST(SpscQueueTest, CapacityRoundsUp)
+{
+    EXPECT_EQ(2, SpscQueue<int>{0}.capacity());
+    EXPECT_EQ(4, SpscQueue<int>{3}.capacity());
+    EXPECT_EQ(8, SpscQueue<int>{8}.capacity());
+}
+
+TEST(SpscQueueTest, EmptyAndFull)
+{
+    SpscQueue<int> queue{4};
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(nullptr, queue.front());
+    queue.pop();
+    EXPECT_TRUE(queue.empty());
+
+    for(int i{0}; i < 4; ++i) {
+        EXPECT_TRUE(queue.push(i));
+    }
+
+    EXPECT_EQ(4, queue.size());
+    EXPECT_EQ(0, queue.freeSpace());
+    EXPECT_FALSE(queue.push(4));
+
+    ASSERT_NE(nullptr, queue.front());
+    EXPECT_EQ(0, *queue.front());
+    queue.pop();
+    EXPECT_EQ(1, queue.freeSpace());
+    EXPECT_TRUE(queue.push(4));
+
+    queue.clear();
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(4, queue.freeSpace());
+}
+
+TEST(SpscQueueTest, WrapsAround)
+{
+    SpscQueue<int> queue{4};
+
+    // Advances the indexes well past the capacity so every slot is reused
+    for(int i{0}; i < 50; ++i) {
+        ASSERT_TRUE(queue.push(i));
+        ASSERT_TRUE(queue.push(i + 1000));
+        ASSERT_TRUE(queue.push(i + 2000));
+
+        ASSERT_NE(nullptr, queue.front());
+        EXPECT_EQ(i, *queue.front());
+        queue.pop();
+        EXPECT_EQ(i + 1000, *queue.front());
+        queue.pop();
+        EXPECT_EQ(i + 2000, *queue.front());
+        queue.pop();
+
+        EXPECT_TRUE(queue.empty());
+    }
+}
+
+TEST(SpscQueueTest, PopReleasesItem)
+{
+    SpscQueue<std::shared_ptr<int>> queue{2};
+
+    auto item = std::make_shared<int>(1);
+    ASSERT_TRUE(queue.push(item));
+    EXPECT_EQ(2, item.use_count());
+
+    queue.pop();
+    EXPECT_EQ(1, item.use_count());
+}
+
+TEST(SpscQueueTest, TwoThreads)
+{
+    constexpr int ItemCount = 200000;
+
+    // A small queue keeps both threads hitting the full and empty cases
+    SpscQueue<int> queue{8};
+
+    std::thread producer{[&queue]() {
+        for(int i{0}; i < ItemCount;) {
+            if(queue.push(i)) {
+                ++i;
+            }
+            else {
+                std::this_thread::yield();
+            }
+        }
+    }};
+
+    int expected{0};
+    bool inOrder{true};
+
+    while(expected < ItemCount) {
+        if(const int* item = queue.front()) {
+            inOrder &= *item == expected;
+            queue.pop();
+            ++expected;
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+
+    EXPECT_TRUE(inOrder);
+    EXPECT_TRUE(queue.empty());
+}
+} // namespace Fooyin::Testing
@@ -0,0 +1,155 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <utils/stringpool.h>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+using namespace Qt::StringLiterals;
+
+namespace {
+// Literals use static data which is never detached, so build heap allocated strings as parsed tags would be
+QString heapString(const char* str)
+{
+    return QString::fromUtf8(str);
+}
+} // namespace
+
+namespace Fooyin::Testing {
+TEST(StringPoolTest, InternSharesData)
+{
+    StringPool pool;
+
+    const QString first  = pool.intern(heapString("Artist"));
+    const QString second = pool.intern(heapString("Artist"));
+    const QString other  = pool.intern(heapString("Album"));
+
+    EXPECT_EQ(u"Artist"_s, first);
+    EXPECT_EQ(first.constData(), second.constData());
+    EXPECT_NE(first.constData(), other.constData());
+    EXPECT_EQ(2U, pool.size());
+}
+
+TEST(StringPoolTest, InternEmpty)
+{
+    StringPool pool;
+
+    EXPECT_TRUE(pool.intern(QString{}).isEmpty());
+    EXPECT_TRUE(pool.intern(QStringList{}).isEmpty());
+    EXPECT_EQ(0U, pool.size());
+}
+
+TEST(StringPoolTest, InternDoesNotKeepLargerBuffer)
+{
+    StringPool pool;
+
+    QString str = heapString("Artist");
+    str.reserve(1000);
+
+    const QString interned = pool.intern(str);
+    EXPECT_EQ(str, interned);
+    EXPECT_NE(str.constData(), interned.constData());
+    EXPECT_LT(interned.capacity(), 1000);
+}
+
+TEST(StringPoolTest, InternListSharesStrings)
+{
+    StringPool pool;
+
+    const QString artist   = pool.intern(heapString("Artist"));
+    const QStringList list = pool.intern(QStringList{heapString("Artist"), heapString("Other")});
+    const QStringList same = pool.intern(QStringList{heapString("Artist"), heapString("Other")});
+
+    ASSERT_EQ(2, list.size());
+    EXPECT_EQ(artist.constData(), list.front().constData());
+    EXPECT_EQ(list.constData(), same.constData());
+    // Two strings and one list
+    EXPECT_EQ(3U, pool.size());
+}
+
+TEST(StringPoolTest, PurgeRemovesUnreferenced)
+{
+    StringPool pool;
+
+    const QString kept = pool.intern(heapString("Kept"));
+    {
+        const QString released = pool.intern(heapString("Released"));
+        EXPECT_EQ(2U, pool.size());
+        EXPECT_EQ(0U, pool.purge());
+    }
+
+    EXPECT_EQ(1U, pool.purge());
+    EXPECT_EQ(1U, pool.size());
+    EXPECT_EQ(kept.constData(), pool.intern(heapString("Kept")).constData());
+}
+
+TEST(StringPoolTest, PurgeReleasesListsBeforeStrings)
+{
+    StringPool pool;
+
+    {
+        const QStringList list = pool.intern(QStringList{heapString("First"), heapString("Second")});
+        EXPECT_EQ(0U, pool.purge());
+    }
+
+    // The list held the only other references to its strings, so everything goes in one pass
+    EXPECT_EQ(3U, pool.purge());
+    EXPECT_EQ(0U, pool.size());
+}
+
+TEST(StringPoolTest, Clear)
+{
+    StringPool pool;
+
+    const QString str = pool.intern(heapString("Artist"));
+    pool.clear();
+
+    EXPECT_EQ(0U, pool.size());
+    EXPECT_EQ(u"Artist"_s, str);
+}
+
+TEST(StringPoolTest, ConcurrentIntern)
+{
+    StringPool pool;
+
+    constexpr size_t ThreadCount = 4;
+    std::vector<QString> results(ThreadCount);
+    std::vector<std::thread> threads;
+
+    for(size_t i{0}; i < ThreadCount; ++i) {
+        threads.emplace_back([&pool, &results, i]() {
+            for(int j{0}; j < 1000; ++j) {
+                results[i] = pool.intern(heapString("Artist"));
+            }
+        });
+    }
+
+    for(auto& thread : threads) {
+        thread.join();
+    }
+
+    for(const QString& result : results) {
+        EXPECT_EQ(results.front().constData(), result.constData());
+    }
+    EXPECT_EQ(1U, pool.size());
+}
+} // namespace Fooyin::Testing
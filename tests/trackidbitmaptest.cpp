@@ -0,0 +1,216 @@
+/*
+ * Fooyin
+ * Copyright © 2025, Luke Taylor <LukeT1@proton.me>
+ *
+ * Fooyin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Fooyin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Fooyin.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "plugins/filters/trackidbitmap.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+
+using namespace Qt::StringLiterals;
+
+namespace Fooyin::Filters::Testing {
+namespace {
+// More values than a chunk holds as a sorted array
+constexpr int DenseCount = 5000;
+
+TrackIdBitmap makeRange(int first, int count, int step = 1)
+{
+    TrackIdBitmap bitmap;
+    for(int i{0}; i < count; ++i) {
+        bitmap.add(first + (i * step));
+    }
+    return bitmap;
+}
+} // namespace
+
+TEST(TrackIdBitmapTest, Empty)
+{
+    const TrackIdBitmap bitmap;
+    EXPECT_TRUE(bitmap.isEmpty());
+    EXPECT_EQ(0, bitmap.cardinality());
+    EXPECT_FALSE(bitmap.contains(0));
+}
+
+TEST(TrackIdBitmapTest, AddRemove)
+{
+    TrackIdBitmap bitmap;
+    EXPECT_TRUE(bitmap.add(5));
+    EXPECT_FALSE(bitmap.add(5));
+    EXPECT_TRUE(bitmap.contains(5));
+    EXPECT_EQ(1, bitmap.cardinality());
+
+    EXPECT_FALSE(bitmap.remove(6));
+    EXPECT_TRUE(bitmap.remove(5));
+    EXPECT_FALSE(bitmap.remove(5));
+    EXPECT_TRUE(bitmap.isEmpty());
+}
+
+TEST(TrackIdBitmapTest, BoundaryIds)
+{
+    constexpr int MaxId = std::numeric_limits<int>::max();
+
+    TrackIdBitmap bitmap;
+    EXPECT_FALSE(bitmap.add(-1));
+    EXPECT_FALSE(bitmap.contains(-1));
+    EXPECT_FALSE(bitmap.remove(-1));
+
+    for(const int id : {0, 65535, 65536, 131071, MaxId}) {
+        EXPECT_TRUE(bitmap.add(id));
+    }
+
+    EXPECT_EQ(5, bitmap.cardinality());
+    EXPECT_TRUE(bitmap.contains(0));
+    EXPECT_TRUE(bitmap.contains(65535));
+    EXPECT_TRUE(bitmap.contains(65536));
+    EXPECT_TRUE(bitmap.contains(131071));
+    EXPECT_TRUE(bitmap.contains(MaxId));
+    EXPECT_FALSE(bitmap.contains(1));
+    EXPECT_FALSE(bitmap.contains(65537));
+    EXPECT_FALSE(bitmap.contains(MaxId - 1));
+
+    // Removing the last id of a chunk mustn't affect its neighbours
+    EXPECT_TRUE(bitmap.remove(65535));
+    EXPECT_TRUE(bitmap.contains(0));
+    EXPECT_TRUE(bitmap.contains(65536));
+    EXPECT_EQ(4, bitmap.cardinality());
+}
+
+TEST(TrackIdBitmapTest, ArrayToBitsetAndBack)
+{
+    TrackIdBitmap bitmap = makeRange(0, DenseCount, 2);
+    EXPECT_EQ(DenseCount, bitmap.cardinality());
+
+    for(int i{0}; i < DenseCount; ++i) {
+        ASSERT_TRUE(bitmap.contains(i * 2));
+        ASSERT_FALSE(bitmap.contains((i * 2) + 1));
+    }
+
+    // Drop back below the array limit
+    for(int i{0}; i < DenseCount - 100; ++i) {
+        ASSERT_TRUE(bitmap.remove(i * 2));
+    }
+
+    EXPECT_EQ(100, bitmap.cardinality());
+    EXPECT_FALSE(bitmap.contains(0));
+    EXPECT_TRUE(bitmap.contains((DenseCount - 1) * 2));
+    EXPECT_TRUE(bitmap.add(1));
+    EXPECT_EQ(101, bitmap.cardinality());
+}
+
+TEST(TrackIdBitmapTest, IntersectArrays)
+{
+    TrackIdBitmap lhs = makeRange(0, 10);
+    lhs &= makeRange(5, 10);
+
+    EXPECT_EQ(5, lhs.cardinality());
+    EXPECT_FALSE(lhs.contains(4));
+    EXPECT_TRUE(lhs.contains(5));
+    EXPECT_TRUE(lhs.contains(9));
+    EXPECT_FALSE(lhs.contains(10));
+}
+
+TEST(TrackIdBitmapTest, IntersectBitsetWithArray)
+{
+    TrackIdBitmap bitset = makeRange(0, DenseCount);
+    bitset &= makeRange(10, 20, 500);
+
+    // 10, 510, ..., 4510 fall within the bitset
+    EXPECT_EQ(10, bitset.cardinality());
+    EXPECT_TRUE(bitset.contains(10));
+    EXPECT_TRUE(bitset.contains(4510));
+    EXPECT_FALSE(bitset.contains(5010));
+    EXPECT_TRUE(bitset.add(11));
+}
+
+TEST(TrackIdBitmapTest, IntersectArrayWithBitset)
+{
+    TrackIdBitmap array = makeRange(10, 20, 500);
+    array &= makeRange(0, DenseCount);
+
+    EXPECT_EQ(10, array.cardinality());
+    EXPECT_TRUE(array.contains(10));
+    EXPECT_TRUE(array.contains(4510));
+    EXPECT_FALSE(array.contains(5010));
+}
+
+TEST(TrackIdBitmapTest, IntersectBitsets)
+{
+    TrackIdBitmap lhs = makeRange(0, DenseCount * 2);
+    lhs &= makeRange(DenseCount, DenseCount * 2);
+
+    EXPECT_EQ(DenseCount, lhs.cardinality());
+    EXPECT_FALSE(lhs.contains(DenseCount - 1));
+    EXPECT_TRUE(lhs.contains(DenseCount));
+    EXPECT_TRUE(lhs.contains((DenseCount * 2) - 1));
+
+    // A small overlap converts the result back to an array
+    TrackIdBitmap small = makeRange(0, DenseCount);
+    small &= makeRange(DenseCount - 3, DenseCount);
+
+    EXPECT_EQ(3, small.cardinality());
+    EXPECT_TRUE(small.contains(DenseCount - 1));
+    EXPECT_TRUE(small.remove(DenseCount - 1));
+    EXPECT_EQ(2, small.cardinality());
+}
+
+TEST(TrackIdBitmapTest, IntersectAcrossChunks)
+{
+    TrackIdBitmap lhs;
+    lhs.add(1);
+    lhs.add(65536 + 1);
+    lhs.add(3 * 65536);
+
+    TrackIdBitmap rhs;
+    rhs.add(65536 + 1);
+    rhs.add(2 * 65536);
+    rhs.add(3 * 65536 + 1);
+
+    lhs &= rhs;
+
+    EXPECT_EQ(1, lhs.cardinality());
+    EXPECT_TRUE(lhs.contains(65536 + 1));
+
+    lhs &= TrackIdBitmap{};
+    EXPECT_TRUE(lhs.isEmpty());
+}
+
+TEST(TrackIdBitmapTest, FilterKeepsOrder)
+{
+    TrackList tracks;
+    for(const int id : {7, 70000, 3, 12}) {
+        Track track{u"/music/%1.flac"_s.arg(id)};
+        track.setId(id);
+        tracks.push_back(track);
+    }
+
+    TrackIdBitmap bitmap;
+    bitmap.add(12);
+    bitmap.add(70000);
+    bitmap.add(7);
+
+    const TrackList filtered = bitmap.filter(tracks);
+    ASSERT_EQ(3, filtered.size());
+    EXPECT_EQ(7, filtered.at(0).id());
+    EXPECT_EQ(70000, filtered.at(1).id());
+    EXPECT_EQ(12, filtered.at(2).id());
+
+    EXPECT_EQ(4, TrackIdBitmap::fromTracks(tracks).cardinality());
+}
+} // namespace Fooyin::Filters::Testing